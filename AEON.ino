@@ -33,8 +33,18 @@ On an Jupiter:    20(SDA), 21(SCL)
 #include <SPI.h>
 #include <Wire.h>
 #include "AEON_Enums.h"
+#include "AEON_Bus.h"
+#include "AEON_Boot.h"
+#include "AEON_Heap.h"
+#include "AEON_Log.h"
+#include "AEON_Profiler.h"
+#include "AEON_Latency.h"
+#include "AEON_Bench.h"
+#include "AEON_Trace.h"
+#include "AEON_Memory.h"
 #include "AEON_Strings.h"
 #include "AEON_ROM.h"
+#include "AEON_LifeTable.h"
 #include "AEON_Time.h"
 #include "AEON_Display.h"
 #include "AEON_FSM.h"
@@ -44,7 +54,17 @@ On an Jupiter:    20(SDA), 21(SCL)
   Defines
 */
 FSM fsm;
+AEON_Bus bus;
+AEON_Boot boot;
+AEON_Heap heap;
+AEON_Log logger;
+AEON_Profiler profiler;
+AEON_Latency latency;
+AEON_Bench bench;
+AEON_Trace trace;
+AEON_Memory memory;
 AEON_ROM rom;
+AEON_LifeTable lifeTable;
 AEON_Display aeon;
 AEON_Time timer;
 AEON_Strings strings;
@@ -59,21 +79,39 @@ typedef struct
 
 SGLOBAL_ERROR_STATES globalErrorStates = {EReturn_ROM::ROM_RETURN_NULL, EReturn_TIME::TIME_RETURN_NULL, EReturn_DISPLAY::DISPLAY_RETURN_NULL};
 
+// Names of EState and EEvent for the FSM (logs, benchmarks, extras/host aeon_fsm)
+const char *const fsmStateNames[] = {
+    "Base", "Setup_Time", "Setup_Time_Hour", "Setup_Time_Minute", "Setup_Time_Second", "Setup_Date",
+    "Setup_Date_Year", "Setup_Date_Month", "Setup_Date_Day", "Setup_Birthday", "Setup_Birthday_Year",
+    "Setup_Birthday_Month", "Setup_Birthday_Day", "Setup_Sex", "Setup_Sex_Set", "Setup_Country",
+    "Setup_Country_Set", "Setup_Lifespan", "Setup_Lifespan_Set", "Setup_Language", "Setup_Language_Set",
+    "Setup_Reset", "Setup_Reset_Yes", "Setup_Reset_No", "Setup_Reset_Count", "Setup_Back", "ERROR"};
+
+const char *const fsmEventNames[] = {"SET", "P", "N", "OK"};
+
+static_assert(sizeof(fsmStateNames) / sizeof(fsmStateNames[0]) == EState::STATE_ERROR + 1, "fsmStateNames must name every EState");
+static_assert(sizeof(fsmEventNames) / sizeof(fsmEventNames[0]) == EEvent::EVENT_OK + 1, "fsmEventNames must name every EEvent");
+
 /*
   Main prototypes
 */
 void setup()
 {
+  memory.paintStack(); // before the stack grows
+
   Serial.begin(9600);
 
   //while (!Serial) {
   //; // wait for serial port to connect. Needed for native USB
   //}
 
-  // Setup ROM, Time and Display
-  globalErrorStates.return_ROM = rom.setupEEPROM();       // load the init and saved values
-  globalErrorStates.return_TIME = timer.setupTime();      // load the time and date
-  globalErrorStates.return_DISPLAY = aeon.setupDisplay(); // start and set the display
+  // Setup the I2C bus for RTC and Display, core 1 waits for it with the RTC
+  bus.begin();
+  boot.mark(BOOT_PHASE_BUS);
+  boot.setBusReady();
+
+  // Setup Display, ROM and Time are set up on core 1 (setup1)
+  globalErrorStates.return_DISPLAY = aeon.setupDisplay(); // start the display and show the last frame
 
   // Setup Buttons
   for (int i = 0; i < 4; i++)
@@ -81,7 +119,10 @@ void setup()
     buttons[i].setupButton();
   }
 
-  // Finite State Machine
+  // Finite State Machine, the ids are the index of the tables
+  static_assert(EState::STATE_ERROR < AEON_FSM_STATES && EEvent::EVENT_OK < AEON_FSM_EVENTS, "Increase AEON_FSM_STATES / AEON_FSM_EVENTS in AEON_Config.h");
+  fsm.setNames(fsmStateNames, EState::STATE_ERROR + 1, fsmEventNames, EEvent::EVENT_OK + 1);
+
   // Base -> Setup (Current STATE?, NULL, NULL, NULL)
   fsm.addState((StateId)(STATE_Base), NULL, NULL, NULL)
       // SET
@@ -536,9 +577,9 @@ void setup()
                       NULL,                                     // Guard
                       []()
                       {
-                        aeon.pageSetupLifespan();
+                        aeon.pageSetupCountry();
                       },                                        // Transition
-                      (StateId)(STATE_Setup_Lifespan))          // Next State
+                      (StateId)(STATE_Setup_Country))           // Next State
 
       // N
       ->addTransition((EventId)(EVENT_N),                       // Event
@@ -597,6 +638,77 @@ void setup()
                       (StateId)(STATE_Setup_Sex))               // Next State
       ->end();
 
+  // Setup_Country -> Setup_Country_Set
+  fsm.addState((StateId)(STATE_Setup_Country), NULL, NULL, NULL)
+      // SET
+      ->addTransition((EventId)(EVENT_SET),                     // Event
+                      NULL,                                     // Guard
+                      NULL,                                     // Transition
+                      (StateId)(STATE_Setup_Country_Set))       // Next State
+
+      // P
+      ->addTransition((EventId)(EVENT_P),                       // Event
+                      NULL,                                     // Guard
+                      []()
+                      {
+                        aeon.pageSetupLifespan();
+                      },                                        // Transition
+                      (StateId)(STATE_Setup_Lifespan))          // Next State
+
+      // N
+      ->addTransition((EventId)(EVENT_N),                       // Event
+                      NULL,                                     // Guard
+                      []()
+                      {
+                        aeon.pageSetupSex();
+                      },                                        // Transition
+                      (StateId)(STATE_Setup_Sex))               // Next State
+
+      // OK
+      ->addTransition((EventId)(EVENT_OK),                      // Event
+                      NULL,                                     // Guard
+                      NULL,                                     // Transition
+                      (StateId)(STATE_Setup_Country_Set))       // Next State
+      ->end();
+
+  // Setup_Country_Set -> Setup_Country
+  fsm.addState((StateId)(STATE_Setup_Country_Set), NULL, NULL, NULL)
+      // SET
+      ->addTransition((EventId)(EVENT_SET),                     // Event
+                      NULL,                                     // Guard
+                      NULL,                                     // Transition
+                      (StateId)(STATE_Setup_Country))           // Next State
+
+      // P
+      ->addTransition((EventId)(EVENT_P),                       // Event
+                      NULL,                                     // Guard
+                      []()
+                      {
+                        rom.setCountry(+1);
+                        rom.saveToEEPROM();
+                      },                                        // Transition
+                      (StateId)(STATE_Setup_Country_Set))       // Next State
+
+      // N
+      ->addTransition((EventId)(EVENT_N),                       // Event
+                      NULL,                                     // Guard
+                      []()
+                      {
+                        rom.setCountry(-1);
+                        rom.saveToEEPROM();
+                      },                                        // Transition
+                      (StateId)(STATE_Setup_Country_Set))       // Next State
+
+      // OK
+      ->addTransition((EventId)(EVENT_OK),                      // Event
+                      NULL,                                     // Guard
+                      []()
+                      {
+                        aeon.pageSetupCountry();
+                      },                                        // Transition
+                      (StateId)(STATE_Setup_Country))           // Next State
+      ->end();
+
   // Setup_Lifespan -> Setup_Lifespan_Set
   fsm.addState((StateId)(STATE_Setup_Lifespan), NULL, NULL, NULL)
       // SET
@@ -619,9 +731,9 @@ void setup()
                       NULL,                                     // Guard
                       []()
                       {
-                        aeon.pageSetupSex();
+                        aeon.pageSetupCountry();
                       },                                        // Transition
-                      (StateId)(STATE_Setup_Sex))               // Next State
+                      (StateId)(STATE_Setup_Country))           // Next State
 
       // OK
       ->addTransition((EventId)(EVENT_OK),                      // Event
@@ -936,6 +1048,167 @@ void setup()
                       (StateId)(STATE_Base)) // Next State
       ->end();
 
+  boot.mark(BOOT_PHASE_FSM);
+}
+
+/*
+Core 1 sets up the EEPROM and the RTC while core 0 starts the display and builds the state machine.
+The EEPROM does not use the bus, the RTC waits until core 0 started it.
+*/
+void setup1()
+{
+  memory.paintStack();
+
+  strings.mountPacks(); // before the ROM selects the language
+  globalErrorStates.return_ROM = rom.setupEEPROM(); // load the init and saved values
+  boot.mark(BOOT_PHASE_ROM);
+
+  boot.waitBusReady();
+  globalErrorStates.return_TIME = timer.setupTime(); // load the time and date
+  timer.updateTime();
+  boot.mark(BOOT_PHASE_RTC);
+
+  boot.setCoreReady();
+}
+
+/*
+Core 1 prints the log in the background, core 0 only writes records
+*/
+void loop1()
+{
+  loopSerial();
+
+  // The text log waits while a trace is written
+  trace.drain();
+  if (!trace.isActive())
+  {
+    logger.drain();
+  }
+}
+
+/*
+Commands over Serial, one command per line. Runs on core 1 like the log, so a command never stops the
+loop of core 0.
+*/
+#define SERIAL_LINE 32
+
+typedef struct
+{
+  const char *name;
+  void (*run)(void);
+  const char *help;
+} SSERIAL_COMMAND;
+
+char serialLine[SERIAL_LINE];
+uint8_t serialLength = 0;
+
+void commandHelp();
+
+void commandProfile()
+{
+  profiler.print(Serial);
+}
+
+void commandProfileReset()
+{
+  profiler.reset();
+  Serial.println("Profile reset");
+}
+
+void commandBench()
+{
+  bench.request();
+}
+
+void commandMemory()
+{
+  memory.print(Serial);
+}
+
+void commandTraceStart()
+{
+  Serial.println("Trace started");
+  trace.start();
+}
+
+void commandTraceStop()
+{
+  trace.stop();
+}
+
+const SSERIAL_COMMAND serialCommands[] = {
+    {"help", commandHelp, "List the commands"},
+    {"profile", commandProfile, "Time of the loop phases and pages (count min p50 p99 max)"},
+    {"profile reset", commandProfileReset, "Clear the profile"},
+    {"trace start", commandTraceStart, "Record button edges and RTC readings as a binary stream (AEON_Trace.h)"},
+    {"trace stop", commandTraceStop, "End the recording"},
+    {"memory", commandMemory, "RAM, heap and the deepest use of both stacks (AEON_Memory.h)"},
+    {"bench", commandBench, "Benchmarks of the hot paths as JSON, the loop stops for about a second"},
+};
+
+void commandHelp()
+{
+  for (const SSERIAL_COMMAND &command : serialCommands)
+  {
+    Serial.print(command.name);
+    Serial.print(" - ");
+    Serial.println(command.help);
+  }
+}
+
+void loopSerial()
+{
+  while (Serial.available() > 0)
+  {
+    char c = Serial.read();
+    if (c != '\n' && c != '\r')
+    {
+      // Longer lines are cut, they do not match a command
+      if (serialLength < SERIAL_LINE - 1)
+      {
+        serialLine[serialLength++] = c;
+      }
+      continue;
+    }
+
+    if (serialLength == 0)
+    {
+      continue;
+    }
+    serialLine[serialLength] = '\0';
+    serialLength = 0;
+
+    bool found = false;
+    for (const SSERIAL_COMMAND &command : serialCommands)
+    {
+      if (strcmp(serialLine, command.name) == 0)
+      {
+        command.run();
+        found = true;
+        break;
+      }
+    }
+
+    if (!found)
+    {
+      Serial.println("Unknown command, try help");
+    }
+  }
+}
+
+/*
+Finish the boot when core 1 is done, until then the display keeps the boot frame.
+*/
+bool booted = false;
+
+void loopBoot()
+{
+  if (!boot.isCoreReady())
+  {
+    aeon.loopDisplay();
+    return;
+  }
+
   // Check error and jump to the error state, if no error exist the state jump to the normal base state
   if (globalErrorStates.return_ROM == EReturn_ROM::ROM_RETURN_NULL || globalErrorStates.return_TIME == EReturn_TIME::TIME_RETURN_NULL || globalErrorStates.return_DISPLAY == EReturn_DISPLAY::DISPLAY_RETURN_NULL)
   {
@@ -956,6 +1229,17 @@ void setup()
       rom.resetEEPROM();
     }
   }
+
+  // First page with the time of the RTC
+  loopPages();
+  bus.flush();
+  boot.mark(BOOT_PHASE_FIRST_PAGE);
+  boot.report();
+
+  // Everything is allocated, the loop runs without heap
+  heap.lock();
+
+  booted = true;
 }
 
 /*
@@ -965,9 +1249,21 @@ change to the error state.
 */
 void loop()
 {
+  if (!booted)
+  {
+    loopBoot();
+    return;
+  }
+
+  bench.service();
+  trace.service();
+  profiler.service();
+  PROFILE_SCOPE(PROFILE_LOOP);
+
   loopTime();
   loopButton();
   loopPages();
+  aeon.loopDisplay();
   loopError();
 }
 
@@ -976,6 +1272,8 @@ Check for errors and change to the error state
 */
 void loopError()
 {
+  PROFILE_SCOPE(PROFILE_LOOP_ERROR);
+
   // Check error and change the error state
   if (rom.getErrorState() != EReturn_ROM::ROM_RETURN_NULL || timer.getErrorState() != EReturn_TIME::TIME_RETURN_NULL || aeon.getErrorState() != EReturn_DISPLAY::DISPLAY_RETURN_NULL)
   {
@@ -996,13 +1294,16 @@ unsigned long previousMillis_time = 0;
 
 void loopTime()
 {
+  PROFILE_SCOPE(PROFILE_LOOP_TIME);
+
   currentMillis_time = millis();
   if (currentMillis_time - previousMillis_time >= interval_time)
   {
     previousMillis_time = currentMillis_time;
 
     timer.updateTime();
-    Serial.println(timer.getTimeAsString());
+    logger.write(LOG_TIME, timer.getUnixTime());
+    heap.check();
   }
 }
 
@@ -1013,13 +1314,17 @@ over 1500ms. Buttons SET = 0; P = 1; N = 2; OK = 3
 */
 void loopButton()
 {
+  PROFILE_SCOPE(PROFILE_LOOP_BUTTON);
+
   for (int i = 0; i < 4; i++)
   {
     switch (buttons[i].loopButton())
     {
     // Pressed short
     case (EPressed::SHORT):
+      LATENCY(press(i, buttons[i].getEdgeTime()));
       fsm.dispatch(static_cast<EEvent>(i));
+      LATENCY(dispatched());
       break;
 
     // Pressed long
@@ -1039,13 +1344,26 @@ direct from the RTC.
 */
 void loopPages()
 {
+  PROFILE_SCOPE(PROFILE_LOOP_PAGES);
+
   DateTime now = timer.getTimeAsDateTime();
 
   switch (fsm.getCurrentStateId())
   {
   case (EState::STATE_Base):
-    aeon.pageBase(now.year(), now.month() - 1, now.day(), now.dayOfTheWeek(), now.hour(), now.minute(), now.second(), calcLifetime());
+  {
+#if AEON_COUNTDOWN
+    long days;
+    long seconds;
+    int elapsed;
+    calcCountdown(now, &days, &seconds, &elapsed);
+    aeon.pageBaseCountdown(now.year(), now.month() - 1, now.day(), now.dayOfTheWeek(), now.hour(), now.minute(), now.second(), days, seconds, elapsed);
+#else
+    aeon.pageBase(now.year(), now.month() - 1, now.day(), now.dayOfTheWeek(), now.hour(), now.minute(), now.second(),
+                  calcLifetime(now.year(), now.month(), now.day()));
+#endif
     break;
+  }
 
   case (EState::STATE_Setup_Time_Hour):
     aeon.pageSetupTime_set_time(EState::STATE_Setup_Time_Hour, now.hour(), now.minute(), now.second());
@@ -1087,6 +1405,10 @@ void loopPages()
     aeon.pageSetupSex_set(rom.getSex());
     break;
 
+  case (EState::STATE_Setup_Country_Set):
+    aeon.pageSetupCountry_set(rom.getCountry());
+    break;
+
   case (EState::STATE_Setup_Lifespan_Set):
     aeon.pageSetupLifespan_set(rom.getLifespan());
     break;
@@ -1126,27 +1448,26 @@ unsigned long previousMillis_error = 0;
 
 void pageStateError()
 {
-  char localText[24];                    // Display can only 20 chars at one line
-  String noError = "No Error detected";  // 17 chars - No Error detected
-  String notValid = "No data in EEPROM"; // 17 chars - EEPROM has no data sign is valid
-  String commitFaild = "Error EEPROM";   // EEPROM error while save data commit error
-  String noRTC = "RTC or I2C";           // Can't find RTC-Clock
-  String rtcLostPower = "Fault Battery"; // RTC-Clock lost Power
-  String noDisplay = "Display or I2C";   // Display not found
+  // Display can only 20 chars at one line
+  const char *noError = "No Error detected";  // 17 chars - No Error detected
+  const char *notValid = "No data in EEPROM"; // 17 chars - EEPROM has no data sign is valid
+  const char *commitFaild = "Error EEPROM";   // EEPROM error while save data commit error
+  const char *noRTC = "RTC or I2C";           // Can't find RTC-Clock
+  const char *rtcLostPower = "Fault Battery"; // RTC-Clock lost Power
+  const char *noDisplay = "Display or I2C";   // Display not found
 
   // This must change if error exist
-  int charLengh = 22;
-  noError.toCharArray(localText, charLengh);
+  const char *localText = noError;
 
   // Check global rom
   switch (globalErrorStates.return_ROM)
   {
   case EReturn_ROM::ERROR_EEPROM_NOT_VALID_DATA:
-    notValid.toCharArray(localText, charLengh);
+    localText = notValid;
     break;
 
   case EReturn_ROM::ERROR_EEPROM_COMMIT_FAILD:
-    commitFaild.toCharArray(localText, charLengh);
+    localText = commitFaild;
     break;
 
   default:
@@ -1157,11 +1478,11 @@ void pageStateError()
   switch (globalErrorStates.return_TIME)
   {
   case EReturn_TIME::ERROR_TIME_NO_RTC:
-    noRTC.toCharArray(localText, charLengh);
+    localText = noRTC;
     break;
 
   case EReturn_TIME::ERROR_TIME_LOST_POWER:
-    rtcLostPower.toCharArray(localText, charLengh);
+    localText = rtcLostPower;
     break;
 
   default:
@@ -1172,7 +1493,7 @@ void pageStateError()
   switch (globalErrorStates.return_DISPLAY)
   {
   case EReturn_DISPLAY::ERROR_DISPLAY_ALLOCATION_FAILD:
-    noDisplay.toCharArray(localText, charLengh);
+    localText = noDisplay;
     break;
 
   default:
@@ -1183,7 +1504,7 @@ void pageStateError()
   if (currentMillis_error - previousMillis_error >= interval_error)
   {
     previousMillis_error = currentMillis_error;
-    Serial.println(localText);
+    logger.write(LOG_ERROR, globalErrorStates.return_ROM, globalErrorStates.return_TIME, globalErrorStates.return_DISPLAY);
   }
 
   // return local text to error page;
@@ -1228,23 +1549,26 @@ void resetFinal(boolean reset)
 
 /*
 Calculate the lifepan to the death. The brain of the whole thing.
+Remaining life expectancy at the age of the date (AEON_LifeTable.h), calculated once a day. The hours,
+minutes and seconds of the countdown (AEON_COUNTDOWN) come from the same baseline.
 */
-int calcLifetime()
+int calcLifetime(int year, int month, int day)
 {
-  int lifespan = rom.getLifespan();
-
-  // Calculate the lifespan to Unix-Time
-  int zero = 1970;
-  int deathYear = zero + lifespan;
+  int days = lifeTable.getRemainingDays(year, month, day, rom.getBirthdayYear(), rom.getBirthdayMonth(), rom.getBirthdayDay(), rom.getCountry(),
+                                        rom.getSex(), rom.getLifespan());
 
-  double unix_distance = timer.distanceUnixTime(rom.getBirthdayYear(), rom.getBirthdayMonth(), rom.getBirthdayDay(), deathYear);
+  return days;
+}
 
-  // Calculate the remaining time components
-  int days = unix_distance / (60 * 60 * 24); // unix in seconds
-  // int days     = floor(unix_distance / (1000 * 60 * 60 * 24));     // unix in microseconds
-  // int hours    = (unix_distance / (60 * 60)) % 24;
-  // int minutes  = (unix_distance / 60) % 60;
-  // int seconds  = unix_distance % 60;
+/*
+Countdown and elapsed per mille at now. The baseline is the day of now as well, the date of timer is
+updated once a second (loopTime()) and is still the day before right after midnight.
+*/
+void calcCountdown(const DateTime &now, long *days, long *seconds, int *elapsed)
+{
+  long secondOfDay = now.hour() * 3600L + now.minute() * 60 + now.second();
 
-  return days;
-}
\ No newline at end of file
+  calcLifetime(now.year(), now.month(), now.day());
+  lifeTable.getCountdown(secondOfDay, days, seconds);
+  *elapsed = lifeTable.getElapsed(secondOfDay);
+}
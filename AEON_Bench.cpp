@@ -0,0 +1,327 @@
+/*
+AEON_Bench.cpp
+*/
+
+#include <Arduino.h>
+#include "AEON_Config.h"
+#include "AEON_Enums.h"
+#include "AEON_Global.h"
+#include "AEON_Panel.h"
+#include "AEON_Format.h"
+#include "AEON_Profiler.h"
+#include "AEON_Heap.h"
+#include "AEON_Strings.h"
+#include "AEON_ROM.h"
+#include "AEON_Time.h"
+#include "AEON_LifeTable.h"
+#include "AEON_Display.h"
+#include "AEON_Raster.h"
+#include "AEON_FSM.h"
+#include "AEON_Bench.h"
+
+#define BENCH_STATES (STATE_ERROR + 1)
+#define BENCH_EVENTS (EVENT_OK + 1)
+#define BENCH_MAX_ITERATIONS (1UL << 24)
+
+extern FSM fsm;
+extern AEON_Heap heap;
+extern AEON_ROM rom;
+extern AEON_Time timer;
+extern AEON_Display aeon;
+extern AEON_LifeTable lifeTable;
+extern AEON_Strings strings;
+extern AEON_PanelDisplay display;
+extern AEON_Raster<AEON_PanelGeometry> raster;
+
+int calcLifetime(int year, int month, int day);
+
+/*
+Operations
+*/
+static volatile int benchSink; // Keeps the compiler from dropping results
+
+static void benchLifetime() { benchSink = calcLifetime(timer.getYear(), timer.getMonth(), timer.getDay()); }
+static void benchExpectancy() { benchSink = (int)AEON_LifeTable::getExpectancy(AEON_LifeTable::get(0).deaths[Female], 12345); }
+static void benchCountdown()
+{
+  long days;
+  long seconds;
+  lifeTable.getCountdown(86398, &days, &seconds);
+  benchSink = (int)seconds + lifeTable.getElapsed(86398);
+}
+static void benchDistance() { benchSink = (int)timer.distanceUnixTime(rom.getBirthdayYear(), rom.getBirthdayMonth(), rom.getBirthdayDay(), 1970 + rom.getLifespan()); }
+
+static void benchPageBase() { aeon.pageBase(2024, 1, 29, 4, 23, 59, 58, 12345); }
+static void benchPageBaseCountdown() { aeon.pageBaseCountdown(2024, 1, 29, 4, 23, 59, 58, 12345, 45296, 427); }
+static void benchPageTime() { aeon.pageSetupTime(); }
+static void benchPageTimeSet() { aeon.pageSetupTime_set_time(STATE_Setup_Time_Minute, 23, 59, 58); }
+static void benchPageDate() { aeon.pageSetupDate(); }
+static void benchPageDateSet() { aeon.pageSetupDate_set_date(STATE_Setup_Date_Month, 2024, 1, 29); }
+static void benchPageBirthday() { aeon.pageSetupBirthday(); }
+static void benchPageBirthdaySet() { aeon.pageSetupBirthday_set_date(STATE_Setup_Birthday_Day, 1990, 4, 17); }
+static void benchPageSex() { aeon.pageSetupSex(); }
+static void benchPageSexSet() { aeon.pageSetupSex_set(Female); }
+static void benchPageLifespan() { aeon.pageSetupLifespan(); }
+static void benchPageLifespanSet() { aeon.pageSetupLifespan_set(83); }
+static void benchPageLanguage() { aeon.pageSetupLanguage(); }
+static void benchPageLanguageSet() { aeon.pageSetupLanguage_set(German); }
+static void benchPageReset() { aeon.pageSetupReset(); }
+static void benchPageResetSet() { aeon.pageSetupReset_set(STATE_Setup_Reset_Yes); }
+static void benchPageResetCount() { aeon.pageSetupReset_count_final(3); }
+static void benchPageBack() { aeon.pageSetupBack(); }
+static void benchPageError() { aeon.pageERROR("ROM: 1 TIME: 11 DISPLAY: 20"); }
+
+/*
+Same steps as the pages that center a text
+*/
+static void benchTextCenter()
+{
+  int16_t x1;
+  int16_t y1;
+  uint16_t width;
+  uint16_t height;
+
+  display.setTextSize(LARGE);
+  display.getTextBounds("12.345", 0, 0, &x1, &y1, &width, &height);
+  benchSink = AEON_PanelGeometry::centerX(width);
+}
+
+/*
+AEON_Format next to the same text with snprintf
+*/
+static char benchText[32];
+
+static void benchFormatTime() { AEON_Format(benchText, sizeof(benchText)).number(23, 2).character(':').number(59, 2).character(':').number(58, 2); }
+static void benchSnprintfTime() { snprintf(benchText, sizeof(benchText), "%02d:%02d:%02d", 23, 59, 58); }
+static void benchFormatSigned() { AEON_Format(benchText, sizeof(benchText)).number(-12345L, 4, ' ').number(7, 3, '0', true); }
+static void benchSnprintfSigned() { snprintf(benchText, sizeof(benchText), "%4ld%+03d", -12345L, 7); }
+static void benchFormatGrouped() { AEON_Format(benchText, sizeof(benchText)).grouped(12345, ','); }
+static void benchSnprintfGrouped() { snprintf(benchText, sizeof(benchText), "%d,%03d", 12345 / 1000, 12345 % 1000); }
+
+/*
+Raster primitives next to the same drawing through Adafruit GFX
+*/
+static void benchRasterHLine() { raster.drawHLine(0, 20, AEON_PanelGeometry::WIDTH, RASTER_WHITE); }
+static void benchGfxHLine() { display.drawFastHLine(0, 20, AEON_PanelGeometry::WIDTH, SSD1306_WHITE); }
+static void benchRasterVLine() { raster.drawVLine(64, 3, 58, RASTER_WHITE); }
+static void benchGfxVLine() { display.drawFastVLine(64, 3, 58, SSD1306_WHITE); }
+static void benchRasterFillRect() { raster.fillRect(5, 3, 118, 58, RASTER_WHITE); }
+static void benchGfxFillRect() { display.fillRect(5, 3, 118, 58, SSD1306_WHITE); }
+static void benchRasterInvertRect() { raster.invertRect(0, 22, AEON_PanelGeometry::WIDTH, 17); }
+static void benchGfxInvertRect() { display.fillRect(0, 22, AEON_PanelGeometry::WIDTH, 17, SSD1306_INVERSE); }
+static void benchRasterClearRegion() { raster.clearRegion(0, 21, AEON_PanelGeometry::WIDTH, AEON_PanelGeometry::HEIGHT - 21); }
+static void benchGfxClearRegion() { display.fillRect(0, 21, AEON_PanelGeometry::WIDTH, AEON_PanelGeometry::HEIGHT - 21, SSD1306_BLACK); }
+
+static void benchStrings()
+{
+  benchSink = strings.getString(AEON_Strings::EStrings::RemainingDays)[0] + strings.getWeekday(3)[0] + strings.getMonth(11)[0] + strings.getThousandsSeparator();
+}
+
+static void benchRomSave() { rom.saveToEEPROM(); }
+static void benchRomLoad() { rom.getEEPROM(); }
+
+static StateId benchState;
+static EventId benchEvent;
+
+static void benchDispatch()
+{
+  fsm.setCurrentStateId(benchState);
+  benchSink = fsm.dispatch(benchEvent);
+}
+
+typedef struct
+{
+  const char *name;
+  void (*operation)(void);
+} SBENCH;
+
+static const SBENCH benchmarks[] = {
+    {"calcLifetime", benchLifetime},
+    {"lifeTable.expectancy", benchExpectancy},
+    {"lifeTable.countdown", benchCountdown},
+    {"distanceUnixTime", benchDistance},
+    {"page.base", benchPageBase},
+    {"page.base.countdown", benchPageBaseCountdown},
+    {"page.time", benchPageTime},
+    {"page.time.set", benchPageTimeSet},
+    {"page.date", benchPageDate},
+    {"page.date.set", benchPageDateSet},
+    {"page.birthday", benchPageBirthday},
+    {"page.birthday.set", benchPageBirthdaySet},
+    {"page.sex", benchPageSex},
+    {"page.sex.set", benchPageSexSet},
+    {"page.lifespan", benchPageLifespan},
+    {"page.lifespan.set", benchPageLifespanSet},
+    {"page.language", benchPageLanguage},
+    {"page.language.set", benchPageLanguageSet},
+    {"page.reset", benchPageReset},
+    {"page.reset.set", benchPageResetSet},
+    {"page.reset.count", benchPageResetCount},
+    {"page.back", benchPageBack},
+    {"page.error", benchPageError},
+    {"text.center", benchTextCenter},
+    {"format.time", benchFormatTime},
+    {"snprintf.time", benchSnprintfTime},
+    {"format.signed", benchFormatSigned},
+    {"snprintf.signed", benchSnprintfSigned},
+    {"format.grouped", benchFormatGrouped},
+    {"snprintf.grouped", benchSnprintfGrouped},
+    {"raster.hline", benchRasterHLine},
+    {"gfx.hline", benchGfxHLine},
+    {"raster.vline", benchRasterVLine},
+    {"gfx.vline", benchGfxVLine},
+    {"raster.fillRect", benchRasterFillRect},
+    {"gfx.fillRect", benchGfxFillRect},
+    {"raster.invertRect", benchRasterInvertRect},
+    {"gfx.invertRect", benchGfxInvertRect},
+    {"raster.clearRegion", benchRasterClearRegion},
+    {"gfx.clearRegion", benchGfxClearRegion},
+    {"strings", benchStrings},
+};
+
+// Change the settings or the state, see AEON_Bench.h
+static const SBENCH statefulBenchmarks[] = {
+    {"rom.save", benchRomSave},
+    {"rom.load", benchRomLoad},
+};
+
+AEON_Bench::AEON_Bench()
+{
+  this->requested = false;
+}
+
+/*
+Run the operation in doubling batches and print one JSON object
+*/
+void AEON_Bench::measure(Print &out, const char *name, void (*operation)(void), bool &first)
+{
+  uint32_t cyclesPerMicro = rp2040.f_cpu() / 1000000;
+  uint32_t iterations = 1;
+  uint32_t cycles;
+  uint32_t allocations;
+  size_t used;
+
+  for (;;)
+  {
+    allocations = heap.getAllocations();
+    used = heap.getUsed();
+
+    uint32_t start = AEON_Profiler::now();
+    for (uint32_t i = 0; i < iterations; i++)
+    {
+      operation();
+    }
+    cycles = AEON_Profiler::now() - start;
+
+    allocations = heap.getAllocations() - allocations;
+    if (cycles / cyclesPerMicro >= AEON_BENCH_TIME || iterations >= BENCH_MAX_ITERATIONS)
+    {
+      break;
+    }
+    iterations *= 2;
+  }
+
+  size_t growth = heap.getUsed();
+  growth = growth > used ? growth - used : 0;
+
+  // Tenths of a nanosecond per operation
+  uint64_t tenths = (uint64_t)cycles * 10000 / cyclesPerMicro / iterations;
+
+  char line[128];
+  AEON_Format json(line, sizeof(line));
+  json.text(first ? "  " : ",\n  ")
+      .text("{\"name\":\"")
+      .text(name)
+      .text("\",\"iterations\":")
+      .number((long)iterations)
+      .text(",\"ns_per_op\":")
+      .number((long)(tenths / 10))
+      .character('.')
+      .number((long)(tenths % 10))
+      .text(",\"allocs_per_op\":");
+  if (heap.countsAllocations())
+  {
+    // Hundredths
+    uint32_t hundredths = (uint32_t)((uint64_t)allocations * 100 / iterations);
+    json.number((long)(hundredths / 100)).character('.').number((long)(hundredths % 100), 2);
+  }
+  else
+  {
+    json.text("null");
+  }
+  json.text(",\"heap_growth\":").number((long)growth).character('}');
+
+  out.print(line);
+  first = false;
+}
+
+/*
+Called by core 1 (serial command)
+*/
+void AEON_Bench::request()
+{
+  this->requested = true;
+}
+
+/*
+Called by core 0 at the start of the loop
+*/
+void AEON_Bench::service()
+{
+  if (!this->requested)
+  {
+    return;
+  }
+  this->requested = false;
+  run(Serial, false);
+}
+
+/*
+Measure every operation and print the results as one JSON object, the stateful ones only when asked
+*/
+void AEON_Bench::run(Print &out, bool stateful)
+{
+  bool first = true;
+
+  out.print("{\"target\":\"");
+#ifdef ARDUINO_ARCH_RP2040
+  out.print("rp2040");
+#else
+  out.print("host");
+#endif
+  out.print("\",\"f_cpu\":");
+  out.print((unsigned long)rp2040.f_cpu());
+  out.print(",\"bench_time_us\":");
+  out.print((unsigned long)AEON_BENCH_TIME);
+  out.println(",\"benchmarks\":[");
+
+  for (const SBENCH &benchmark : benchmarks)
+  {
+    measure(out, benchmark.name, benchmark.operation, first);
+  }
+
+  if (stateful)
+  {
+    for (const SBENCH &benchmark : statefulBenchmarks)
+    {
+      measure(out, benchmark.name, benchmark.operation, first);
+    }
+
+    StateId state = fsm.getCurrentStateId();
+    for (int s = 0; s < BENCH_STATES; s++)
+    {
+      for (int e = 0; e < BENCH_EVENTS; e++)
+      {
+        char name[48];
+        AEON_Format(name, sizeof(name)).text("fsm.").text(fsm.getStateName(s)).character('.').text(fsm.getEventName(e));
+        benchState = s;
+        benchEvent = e;
+        measure(out, name, benchDispatch, first);
+      }
+    }
+    fsm.setCurrentStateId(state);
+  }
+
+  out.println();
+  out.println("]}");
+}
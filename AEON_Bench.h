@@ -0,0 +1,43 @@
+/*
+AEON_Bench.h - Microbenchmarks of the hot paths of the firmware.
+Every benchmark runs its operation in batches that double until a batch takes AEON_BENCH_TIME microseconds,
+the last batch is reported: nanoseconds per operation (CPU cycles, rp2040.getCycleCount()), allocations per
+operation (where AEON_Heap counts them, else null) and the growth of the heap in bytes. The result is JSON,
+one benchmark per line, so two revisions can be compared with diff or a script.
+
+The benchmarks cover calcLifetime() (the result of the day), the life expectancy of one life table (the
+calculation once a day), distanceUnixTime(), every page of AEON_Display (rendered into the frame
+buffer, the frame is queued but not sent), the centring of text with getTextBounds(), AEON_Format and the
+primitives of AEON_Raster next to the same text with snprintf and drawing with Adafruit GFX (format.* and
+snprintf.*, raster.* and gfx.*), AEON_Strings and FSM::dispatch() for every state and event. The last two
+groups change the state: the EEPROM save and load and the state machine (its transitions save settings, set
+the RTC and clear errors). They only run with run(out, true), the host build does that (extras/host,
+aeon_bench).
+
+On the device "bench" on Serial runs the other benchmarks. Core 1 only requests them, core 0 runs them at the
+start of the next loop (service()), because they draw into the frame buffer of core 0. The loop stands still
+while they run, about one second.
+*/
+
+#ifndef AEON_BENCH_h
+#define AEON_BENCH_h
+
+#include <Arduino.h>
+#include "AEON_Config.h"
+
+class AEON_Bench
+{
+private:
+  volatile bool requested;
+
+  void measure(Print &out, const char *name, void (*operation)(void), bool &first);
+
+public:
+  AEON_Bench();
+
+  void request();
+  void service();
+  void run(Print &out, bool stateful);
+};
+
+#endif
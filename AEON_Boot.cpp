@@ -0,0 +1,150 @@
+/*
+AEON_Boot.cpp
+*/
+
+#include <Arduino.h>
+#include <pico/platform.h>
+#include <string.h>
+#include "AEON_Config.h"
+#include "AEON_Enums.h"
+#include "AEON_Boot.h"
+
+#define BOOT_FRAME_SIZE (AEON_DISPLAY_WIDTH * AEON_DISPLAY_HEIGHT / 8)
+#define BOOT_FRAME_MAGIC 0xAE0DF00DUL
+
+typedef struct
+{
+  uint32_t magic;
+  uint32_t checksum;
+  uint8_t frame[BOOT_FRAME_SIZE];
+} SBOOT_FRAME;
+
+// Not cleared by the startup code, survives a reset but not a power loss
+static SBOOT_FRAME __uninitialized_ram(bootFrame);
+
+static const char *const phaseNames[BOOT_PHASE_Count] = {"Bus", "Display", "Splash", "ROM", "RTC", "FSM", "First page"};
+
+/*
+Checksum of the stored frame, an erased or torn frame is not shown
+*/
+static uint32_t frameChecksum(const uint8_t *buffer, size_t size)
+{
+  uint32_t checksum = BOOT_FRAME_MAGIC;
+  for (size_t i = 0; i < size; i++)
+  {
+    checksum = checksum * 31 + buffer[i];
+  }
+  return checksum;
+}
+
+AEON_Boot::AEON_Boot()
+{
+  for (int i = 0; i < BOOT_PHASE_Count; i++)
+  {
+    this->phases[i] = 0;
+  }
+  this->busReady = false;
+  this->coreReady = false;
+}
+
+/*
+Save the time of a boot phase
+*/
+void AEON_Boot::mark(EBootPhase phase)
+{
+  this->phases[phase] = micros();
+}
+
+/*
+micros() when the boot reached the phase, 0 before
+*/
+unsigned long AEON_Boot::getTime(EBootPhase phase)
+{
+  return this->phases[phase];
+}
+
+/*
+Print the boot phases in microseconds since reset
+*/
+void AEON_Boot::report()
+{
+  Serial.println("Boot phases [us]:");
+  for (int i = 0; i < BOOT_PHASE_Count; i++)
+  {
+    Serial.print(phaseNames[i]);
+    Serial.print(": ");
+    Serial.println(this->phases[i]);
+  }
+}
+
+/*
+The bus is started, core 1 can read the RTC
+*/
+void AEON_Boot::setBusReady()
+{
+  __sync_synchronize();
+  this->busReady = true;
+}
+
+/*
+Core 1 waits until core 0 has set up the bus
+*/
+void AEON_Boot::waitBusReady()
+{
+  while (!this->busReady)
+  {
+    tight_loop_contents();
+  }
+  __sync_synchronize();
+}
+
+/*
+ROM and RTC are set up, the results of core 1 are visible before the flag
+*/
+void AEON_Boot::setCoreReady()
+{
+  __sync_synchronize();
+  this->coreReady = true;
+}
+
+/*
+Core 1 is done with its setup, its writes are visible after the barrier
+*/
+bool AEON_Boot::isCoreReady()
+{
+  if (!this->coreReady)
+  {
+    return false;
+  }
+  __sync_synchronize();
+  return true;
+}
+
+/*
+Copy the frame of the last run into the buffer, false if there is none
+*/
+bool AEON_Boot::restoreFrame(uint8_t *buffer, size_t size)
+{
+  if (size != BOOT_FRAME_SIZE || bootFrame.magic != BOOT_FRAME_MAGIC || bootFrame.checksum != frameChecksum(bootFrame.frame, BOOT_FRAME_SIZE))
+  {
+    return false;
+  }
+
+  memcpy(buffer, bootFrame.frame, BOOT_FRAME_SIZE);
+  return true;
+}
+
+/*
+Keep the frame for the next boot
+*/
+void AEON_Boot::storeFrame(const uint8_t *buffer, size_t size)
+{
+  if (size != BOOT_FRAME_SIZE)
+  {
+    return;
+  }
+
+  memcpy(bootFrame.frame, buffer, BOOT_FRAME_SIZE);
+  bootFrame.checksum = frameChecksum(bootFrame.frame, BOOT_FRAME_SIZE);
+  bootFrame.magic = BOOT_FRAME_MAGIC;
+}
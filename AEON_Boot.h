@@ -0,0 +1,45 @@
+/*
+AEON_Boot.h - The class coordinates the boot of both cores and measures it.
+Core 0 starts the bus and the display and builds the state machine, core 1 loads the EEPROM and reads the
+RTC at the same time. Core 1 waits with the RTC until the bus is started and reports when it is done, core 0
+shows the first page as soon as both are finished. Every boot phase gets a timestamp (micros since reset),
+report() prints them over Serial.
+
+The last base page is kept in RAM that is not cleared at reset. After a reset (reset button, watchdog,
+upload) the display shows this frame at once instead of the splash. A magic number and a checksum tell
+if the frame survived, after a power loss the content is random and the splash is shown.
+*/
+
+#ifndef AEON_BOOT_h
+#define AEON_BOOT_h
+
+#include <Arduino.h>
+#include "AEON_Enums.h"
+
+class AEON_Boot
+{
+private:
+  unsigned long phases[BOOT_PHASE_Count];
+  volatile bool busReady;
+  volatile bool coreReady;
+
+public:
+  AEON_Boot();
+
+  void mark(EBootPhase phase);
+  unsigned long getTime(EBootPhase phase);
+  void report();
+
+  // Core 0 -> Core 1
+  void setBusReady();
+  void waitBusReady();
+
+  // Core 1 -> Core 0
+  void setCoreReady();
+  bool isCoreReady();
+
+  bool restoreFrame(uint8_t *buffer, size_t size);
+  void storeFrame(const uint8_t *buffer, size_t size);
+};
+
+#endif
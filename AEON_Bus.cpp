@@ -0,0 +1,514 @@
+/*
+AEON_Bus.cpp - The class owns the I2C bus (Wire) shared by the display and the RTC.
+High priority transactions (RTC) run at once when the bus is free. A display frame is copied into the
+frame of the bus and sent by service() in chunks, each call uses the bus for at most
+AEON_BUS_SERVICE_BUDGET microseconds and gives it up early when a high priority transaction waits.
+A frame that is equal to the frame on the display is not sent again.
+
+Wire returns 0 for a successful transaction and 2 if the device did not answer to its address. Any other
+result (data NACK, timeout, lost arbitration) can be a device that holds SDA low, the bus is cleared before
+the transaction is repeated. A failed frame is dropped and sent again after AEON_BUS_BACKOFF.
+
+SSD1306 / SSD1309 transfer:
+0x00 = Control byte, the following bytes are commands
+0x40 = Control byte, the following bytes are display data
+*/
+
+#include <Arduino.h>
+#include <Wire.h>
+#include <string.h>
+#include "AEON_Config.h"
+#include "AEON_Enums.h"
+#include "AEON_Bus.h"
+#include "AEON_Latency.h"
+
+// Wire.setTimeout() with the reset of the controller, older cores and the Mbed core do not have it
+#if defined(ARDUINO_ARCH_RP2040) && (!defined(ARDUINO_PICO_MAJOR) || ARDUINO_PICO_MAJOR < 3)
+#error "AEON needs the arduino-pico core 3.0.0 or newer (Wire.setTimeout(ms, true), see AEON_BUS_TIMEOUT)"
+#endif
+
+#define CONTROL_COMMAND 0x00
+#define CONTROL_DATA 0x40
+
+#define COMMAND_PAGEADDR 0x22
+#define COMMAND_COLUMNADDR 0x21
+
+#define WIRE_OK 0
+#define WIRE_ADDRESS_NACK 2
+#define WIRE_TIMEOUT 5
+
+#define BUS_CLEAR_CLOCKS 9
+#define BUS_CLEAR_HALF_PERIOD 5 // Microseconds, 100 kHz
+
+static_assert(AEON_BUS_CHUNK_SIZE > 0 && AEON_BUS_CHUNK_SIZE < WIRE_BUFFER_SIZE, "A chunk and its control byte must fit into the Wire buffer");
+
+AEON_Bus::AEON_Bus()
+{
+  mutex_init(&this->lock);
+
+  for (int i = 0; i < BUS_DEVICE_Count; i++)
+  {
+    this->addresses[i] = 0;
+    this->priorities[i] = BUS_PRIORITY_LOW;
+    this->waiting[i] = false;
+    this->faults[i] = false;
+  }
+
+  this->frameSource = NULL;
+  this->frameColumns = 0;
+  this->framePending = false;
+  this->frameValid = false;
+  this->frameShown = NULL;
+  this->flushShown = NULL;
+  this->flushing = false;
+  this->flushPosition = 0;
+  this->flushRetryTime = 0;
+
+  resetStats();
+}
+
+/*
+Start the bus, the bus is the only user of Wire
+*/
+void AEON_Bus::begin()
+{
+  Wire.setSDA(AEON_BUS_SDA);
+  Wire.setSCL(AEON_BUS_SCL);
+  Wire.begin();
+  Wire.setClock(AEON_BUS_CLOCK);
+  Wire.setTimeout(AEON_BUS_TIMEOUT, true);
+}
+
+/*
+Set the address and the priority of a device
+*/
+void AEON_Bus::attach(EBusDevice device, uint8_t address, EBusPriority priority)
+{
+  this->addresses[device] = address;
+  this->priorities[device] = priority;
+}
+
+/*
+Take the bus. If the bus is in use the time until it is free is recorded for the device,
+after AEON_BUS_LOCK_TIMEOUT the device gives up and the transaction fails.
+*/
+bool AEON_Bus::acquire(EBusDevice device)
+{
+  if (mutex_try_enter(&this->lock, NULL))
+  {
+    return true;
+  }
+
+  unsigned long start = micros();
+
+  // A flush in progress sees the waiting device and gives up the bus after the current chunk
+  this->waiting[device] = true;
+  bool acquired = mutex_enter_timeout_ms(&this->lock, AEON_BUS_LOCK_TIMEOUT);
+  this->waiting[device] = false;
+
+  uint32_t waited = micros() - start;
+  this->stats[device].waits++;
+  this->stats[device].waitTotal += waited;
+  if (waited > this->stats[device].waitMax)
+  {
+    this->stats[device].waitMax = waited;
+  }
+
+  if (!acquired)
+  {
+    this->stats[device].timeouts++;
+    this->stats[device].failures++;
+    this->faults[device] = true;
+  }
+  return acquired;
+}
+
+/*
+Give the bus back
+*/
+void AEON_Bus::release(EBusDevice device)
+{
+  (void)device;
+  mutex_exit(&this->lock);
+}
+
+/*
+True if a device with high priority waits for the bus
+*/
+bool AEON_Bus::isHighWaiting()
+{
+  for (int i = 0; i < BUS_DEVICE_Count; i++)
+  {
+    if (this->waiting[i] && this->priorities[i] == BUS_PRIORITY_HIGH)
+    {
+      return true;
+    }
+  }
+  return false;
+}
+
+/*
+Release SDA if a device holds it low: up to 9 clocks on SCL until SDA is high, then a stop condition.
+The pins are driven open drain (output low or input with pull-up). Returns true if the bus is free.
+*/
+bool AEON_Bus::clearBus()
+{
+  Wire.end();
+
+  pinMode(AEON_BUS_SDA, INPUT_PULLUP);
+  pinMode(AEON_BUS_SCL, INPUT_PULLUP);
+  delayMicroseconds(BUS_CLEAR_HALF_PERIOD);
+
+  for (int i = 0; i < BUS_CLEAR_CLOCKS && digitalRead(AEON_BUS_SDA) == LOW; i++)
+  {
+    pinMode(AEON_BUS_SCL, OUTPUT);
+    digitalWrite(AEON_BUS_SCL, LOW);
+    delayMicroseconds(BUS_CLEAR_HALF_PERIOD);
+    pinMode(AEON_BUS_SCL, INPUT_PULLUP);
+    delayMicroseconds(BUS_CLEAR_HALF_PERIOD);
+  }
+
+  // Stop condition: SDA goes high while SCL is high
+  pinMode(AEON_BUS_SDA, OUTPUT);
+  digitalWrite(AEON_BUS_SDA, LOW);
+  delayMicroseconds(BUS_CLEAR_HALF_PERIOD);
+  pinMode(AEON_BUS_SDA, INPUT_PULLUP);
+  delayMicroseconds(BUS_CLEAR_HALF_PERIOD);
+
+  bool released = (digitalRead(AEON_BUS_SDA) == HIGH);
+
+  begin();
+  return released;
+}
+
+/*
+Run a transaction with retries. The bus must be taken.
+head and data are written in one write transaction, if rxLength is set the bytes are read afterwards.
+*/
+bool AEON_Bus::execute(EBusDevice device, const uint8_t *head, size_t headLength, const uint8_t *data, size_t length, uint8_t *rx, size_t rxLength)
+{
+  SBUS_STATS &stat = this->stats[device];
+
+  for (int attempt = 0; attempt <= AEON_BUS_RETRIES; attempt++)
+  {
+    if (attempt > 0)
+    {
+      stat.retries++;
+    }
+
+    Wire.beginTransmission(this->addresses[device]);
+    if (headLength > 0)
+    {
+      Wire.write(head, headLength);
+    }
+    if (length > 0)
+    {
+      Wire.write(data, length);
+    }
+    uint8_t result = Wire.endTransmission();
+
+    stat.transactions++;
+    stat.bytesWritten += headLength + length;
+
+    if (result == WIRE_OK && rxLength > 0)
+    {
+      size_t received = Wire.requestFrom(this->addresses[device], rxLength);
+      stat.transactions++;
+      stat.bytesRead += received;
+
+      for (size_t i = 0; i < received; i++)
+      {
+        rx[i] = Wire.read();
+      }
+      result = (received == rxLength) ? WIRE_OK : WIRE_TIMEOUT;
+    }
+
+    if (result == WIRE_OK)
+    {
+      this->faults[device] = false;
+      return true;
+    }
+
+    if (result == WIRE_TIMEOUT)
+    {
+      stat.timeouts++;
+    }
+
+    // A device that does not answer to its address does not hold the bus
+    if (result != WIRE_ADDRESS_NACK)
+    {
+      stat.busClears++;
+      clearBus();
+    }
+  }
+
+  stat.failures++;
+  this->faults[device] = true;
+  return false;
+}
+
+/*
+One write transaction: the first byte (register or control byte) followed by the data.
+The bus must be taken.
+*/
+bool AEON_Bus::transmit(EBusDevice device, uint8_t first, const uint8_t *data, size_t length)
+{
+  return execute(device, &first, 1, data, length, NULL, 0);
+}
+
+/*
+Check if the device answers to its address
+*/
+bool AEON_Bus::probe(EBusDevice device)
+{
+  if (!acquire(device))
+  {
+    return false;
+  }
+  bool found = execute(device, NULL, 0, NULL, 0, NULL, 0);
+  release(device);
+
+  return found;
+}
+
+/*
+Write length bytes starting at register reg
+*/
+bool AEON_Bus::writeRegister(EBusDevice device, uint8_t reg, const uint8_t *data, size_t length)
+{
+  if (!acquire(device))
+  {
+    return false;
+  }
+  bool ok = transmit(device, reg, data, length);
+  release(device);
+
+  return ok;
+}
+
+/*
+Read length bytes starting at register reg
+*/
+bool AEON_Bus::readRegister(EBusDevice device, uint8_t reg, uint8_t *data, size_t length)
+{
+  if (!acquire(device))
+  {
+    return false;
+  }
+  bool ok = execute(device, &reg, 1, NULL, 0, data, length);
+  release(device);
+
+  return ok;
+}
+
+/*
+Take the bus for a library that uses Wire directly
+*/
+bool AEON_Bus::beginExclusive(EBusDevice device)
+{
+  return acquire(device);
+}
+
+/*
+Give the bus back after beginExclusive()
+*/
+void AEON_Bus::endExclusive(EBusDevice device)
+{
+  release(device);
+}
+
+/*
+True if the last transaction of the device failed after all retries
+*/
+bool AEON_Bus::hasFault(EBusDevice device)
+{
+  return this->faults[device];
+}
+
+/*
+Queue a frame for the display. Only the latest frame is kept, it is copied when its flush starts,
+so the source can be drawn again while the previous frame is still being sent. shown gets the frame
+when it is on the display, not when it was already there.
+*/
+void AEON_Bus::submitFrame(const uint8_t *source, uint8_t columns, frameCallback shown)
+{
+  this->frameSource = source;
+  this->frameColumns = columns;
+  this->frameShown = shown;
+  this->framePending = true;
+  LATENCY(frameSubmitted());
+}
+
+/*
+Take the pending frame. Returns false if there is nothing new to send.
+*/
+bool AEON_Bus::startFlush()
+{
+  if (!this->framePending)
+  {
+    return false;
+  }
+  this->framePending = false;
+
+  if (this->frameValid && memcmp(this->frame, this->frameSource, BUS_FRAME_SIZE) == 0)
+  {
+    this->framesSkipped++;
+    LATENCY(flushStarted());
+    LATENCY(frameShown()); // The display already shows this frame
+    return false;
+  }
+
+  memcpy(this->frame, this->frameSource, BUS_FRAME_SIZE);
+  this->flushShown = this->frameShown;
+  this->frameValid = false;
+  this->flushing = true;
+  this->flushPosition = 0;
+  LATENCY(flushStarted());
+  return true;
+}
+
+/*
+Send the next chunks of the frame. Call it from the loop.
+*/
+void AEON_Bus::service()
+{
+  // After a failed frame the display gets a break
+  if (this->flushRetryTime != 0)
+  {
+    if ((long)(millis() - this->flushRetryTime) < 0)
+    {
+      return;
+    }
+    this->flushRetryTime = 0;
+  }
+
+  if (!this->flushing && !startFlush())
+  {
+    return;
+  }
+
+  unsigned long start = micros();
+  if (!acquire(BUS_DEVICE_DISPLAY))
+  {
+    return;
+  }
+
+  // Set the address window to the whole display, the data of the chunks fills it page by page
+  bool ok = true;
+  if (this->flushPosition == 0)
+  {
+    const uint8_t window[] = {COMMAND_PAGEADDR, 0, 0xFF, COMMAND_COLUMNADDR, 0, (uint8_t)(this->frameColumns - 1)};
+    ok = transmit(BUS_DEVICE_DISPLAY, CONTROL_COMMAND, window, sizeof(window));
+  }
+
+  while (ok)
+  {
+    size_t length = BUS_FRAME_SIZE - this->flushPosition;
+    if (length > AEON_BUS_CHUNK_SIZE)
+    {
+      length = AEON_BUS_CHUNK_SIZE;
+    }
+
+    ok = transmit(BUS_DEVICE_DISPLAY, CONTROL_DATA, &this->frame[this->flushPosition], length);
+    if (!ok)
+    {
+      break;
+    }
+    this->flushPosition += length;
+
+    if (this->flushPosition >= BUS_FRAME_SIZE)
+    {
+      this->flushing = false;
+      this->frameValid = true;
+      this->framesSent++;
+      LATENCY(frameShown());
+      if (this->flushShown != NULL)
+      {
+        this->flushShown(this->frame, BUS_FRAME_SIZE);
+      }
+      break;
+    }
+
+    if (isHighWaiting() || (micros() - start) >= AEON_BUS_SERVICE_BUDGET)
+    {
+      break;
+    }
+  }
+
+  // Drop the frame, the latest frame is sent again after the backoff
+  if (!ok)
+  {
+    this->flushing = false;
+    this->framePending = (this->frameSource != NULL);
+    this->framesFailed++;
+    this->flushRetryTime = millis() + AEON_BUS_BACKOFF;
+    if (this->flushRetryTime == 0)
+    {
+      this->flushRetryTime = 1;
+    }
+  }
+
+  release(BUS_DEVICE_DISPLAY);
+}
+
+/*
+Send the pending frame completely
+*/
+void AEON_Bus::flush()
+{
+  do
+  {
+    service();
+  } while (this->flushing);
+}
+
+/*
+A frame is on the way to the display or waits for the next flush
+*/
+bool AEON_Bus::isFlushing()
+{
+  return this->flushing || this->framePending;
+}
+
+/*
+Counters of a device since the start or resetStats()
+*/
+SBUS_STATS AEON_Bus::getStats(EBusDevice device)
+{
+  return this->stats[device];
+}
+
+/*
+Frames that went out to the display
+*/
+uint32_t AEON_Bus::getFramesSent()
+{
+  return this->framesSent;
+}
+
+/*
+Frames equal to the one on the display, nothing was sent
+*/
+uint32_t AEON_Bus::getFramesSkipped()
+{
+  return this->framesSkipped;
+}
+
+/*
+Flushes dropped after a failed transfer, the latest frame follows after the backoff
+*/
+uint32_t AEON_Bus::getFramesFailed()
+{
+  return this->framesFailed;
+}
+
+/*
+Counters of the devices and the frames back to 0
+*/
+void AEON_Bus::resetStats()
+{
+  memset(this->stats, 0, sizeof(this->stats));
+  this->framesSent = 0;
+  this->framesSkipped = 0;
+  this->framesFailed = 0;
+}
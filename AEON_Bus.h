@@ -0,0 +1,104 @@
+/*
+AEON_Bus.h - The class owns the I2C bus (Wire) shared by the display and the RTC.
+Every transaction goes through the bus: register reads and writes of the RTC are short and run with high
+priority, a display frame is queued with submitFrame() and sent in chunks of AEON_BUS_CHUNK_SIZE bytes by
+service(). A frame that is equal to the one on the display is not sent again, the callback of a frame
+only runs when it was sent. Between two chunks a waiting high priority transaction gets the bus, so the time an RTC access
+waits is bounded by one chunk and not by a whole frame. The bus is guarded by a mutex and can be used from
+both cores. For every device the bus counts transactions, bytes and the time spent waiting for the bus.
+
+Every transaction has a deadline (AEON_BUS_TIMEOUT), a failed transaction is retried up to AEON_BUS_RETRIES
+times and a bus clear (9 clocks on SCL and a stop condition) runs before the retry, so a device that holds
+SDA low can not block the loop. A device whose transaction failed after all retries is marked as faulty
+until its next successful transaction, the owner of the device reports it through its error state.
+*/
+
+#ifndef AEON_BUS_h
+#define AEON_BUS_h
+
+#include <Arduino.h>
+#include <pico/mutex.h>
+#include "AEON_Config.h"
+#include "AEON_Enums.h"
+
+#define BUS_FRAME_SIZE (AEON_DISPLAY_WIDTH * AEON_DISPLAY_HEIGHT / 8)
+
+typedef void (*frameCallback)(const uint8_t *frame, size_t size);
+
+typedef struct
+{
+  uint32_t transactions;  // I2C transactions (write or read)
+  uint32_t bytesWritten;  // Bytes written without the address byte
+  uint32_t bytesRead;     // Bytes read
+  uint32_t waits;         // Number of times the device waited for the bus
+  uint32_t waitTotal;     // Time waited for the bus in microseconds
+  uint32_t waitMax;       // Longest wait for the bus in microseconds
+  uint32_t retries;       // Transactions repeated after a failure
+  uint32_t failures;      // Transactions that failed after all retries
+  uint32_t timeouts;      // Transactions or waits for the bus that ran into the deadline
+  uint32_t busClears;     // Bus clears after a failed transaction of the device
+} SBUS_STATS;
+
+class AEON_Bus
+{
+private:
+  mutex_t lock;
+
+  uint8_t addresses[BUS_DEVICE_Count];
+  EBusPriority priorities[BUS_DEVICE_Count];
+  volatile bool waiting[BUS_DEVICE_Count]; // Device waits for the bus
+  volatile bool faults[BUS_DEVICE_Count];  // Last transaction of the device failed
+  SBUS_STATS stats[BUS_DEVICE_Count];
+
+  // Display frame
+  uint8_t frame[BUS_FRAME_SIZE];
+  const uint8_t *frameSource; // Latest submitted frame, copied when the next flush starts
+  uint8_t frameColumns;
+  bool framePending;
+  bool frameValid;            // frame holds what is shown on the display
+  frameCallback frameShown;   // Of the submitted frame
+  frameCallback flushShown;   // Of the frame that is sent, called when all of it is on the display
+  bool flushing;
+  uint16_t flushPosition;
+  uint32_t framesSent;
+  uint32_t framesSkipped;
+  uint32_t framesFailed;
+  unsigned long flushRetryTime; // A failed flush waits until this time (millis)
+
+  bool acquire(EBusDevice device);
+  void release(EBusDevice device);
+  bool isHighWaiting();
+  bool execute(EBusDevice device, const uint8_t *head, size_t headLength, const uint8_t *data, size_t length, uint8_t *rx, size_t rxLength);
+  bool transmit(EBusDevice device, uint8_t first, const uint8_t *data, size_t length);
+  bool clearBus();
+  bool startFlush();
+
+public:
+  AEON_Bus();
+
+  void begin();
+  void attach(EBusDevice device, uint8_t address, EBusPriority priority);
+
+  bool probe(EBusDevice device);
+  bool writeRegister(EBusDevice device, uint8_t reg, const uint8_t *data, size_t length);
+  bool readRegister(EBusDevice device, uint8_t reg, uint8_t *data, size_t length);
+
+  // Run a transaction of a library that talks to Wire itself (e.g. the display init sequence)
+  bool beginExclusive(EBusDevice device);
+  void endExclusive(EBusDevice device);
+
+  bool hasFault(EBusDevice device);
+
+  void submitFrame(const uint8_t *source, uint8_t columns, frameCallback shown = NULL);
+  void service();
+  void flush();
+  bool isFlushing();
+
+  SBUS_STATS getStats(EBusDevice device);
+  uint32_t getFramesSent();
+  uint32_t getFramesSkipped();
+  uint32_t getFramesFailed();
+  void resetStats();
+};
+
+#endif
@@ -11,6 +11,7 @@ PIN Button OK   = 25
 #include <Arduino.h>
 #include "AEON_Enums.h"
 #include "AEON_Button.h"
+#include "AEON_Trace.h"
 
 unsigned long AEON_Button::debounceDelay = 50;     // default 50
 unsigned long AEON_Button::shortPressTime = 1500;  // default 1500
@@ -37,6 +38,12 @@ EPressed AEON_Button::loopButton() {
 
   // Check if button state has changed
   if (reading != this->lastButtonState) {
+    TRACE(button(this->pinNum, reading));
+
+    // The first bounce is the edge for the latency measurement
+    if (!this->lastState) {
+      this->edgeTime = micros();
+    }
     this->lastDebounceTime = millis();
     this->lastState = true;
   }
@@ -73,3 +80,10 @@ EPressed AEON_Button::loopButton() {
 
   return localPressed;
 }
+
+/*
+Time of the first edge of the last change (micros)
+*/
+unsigned long AEON_Button::getEdgeTime() {
+  return this->edgeTime;
+}
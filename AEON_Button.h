@@ -17,6 +17,7 @@ private:
     bool lastButtonState = false;        // the previous reading from the input pin
     unsigned long lastDebounceTime = 0;  // the last time the output pin was toggled
     unsigned long pressedButtonTime = 0; // the time for pressed button
+    unsigned long edgeTime = 0;          // first edge since the button was stable (micros)
     static unsigned long debounceDelay;  // the debounce time
     static unsigned long shortPressTime; // time for short press
 
@@ -24,6 +25,7 @@ public:
     AEON_Button(int pinNum, const char *buttonName);
     void setupButton();
     EPressed loopButton();
+    unsigned long getEdgeTime();
 };
 
 #endif
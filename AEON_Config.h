@@ -0,0 +1,219 @@
+/*
+AEON_Config.h - Build options of AEON. Every option can be changed here or be set by the build
+with -D<OPTION>=<value>, the values below are the defaults for the AEON board.
+*/
+
+#ifndef AEON_CONFIG_h
+#define AEON_CONFIG_h
+
+/*
+Display controller
+AEON_CONTROLLER_SSD1306 = EA OLEDM128-6LWA / EA OLEDL128-6LWA
+AEON_CONTROLLER_SSD1309 = 128x64 SSD1309 modules with external VCC
+AEON_CONTROLLER_HOST    = Framebuffer only, nothing is sent over I2C (host builds and tests)
+*/
+#define AEON_CONTROLLER_SSD1306 1
+#define AEON_CONTROLLER_SSD1309 2
+#define AEON_CONTROLLER_HOST 3
+
+#ifndef AEON_DISPLAY_CONTROLLER
+#define AEON_DISPLAY_CONTROLLER AEON_CONTROLLER_SSD1306
+#endif
+
+// Display geometry in pixels
+#ifndef AEON_DISPLAY_WIDTH
+#define AEON_DISPLAY_WIDTH 128
+#endif
+
+#ifndef AEON_DISPLAY_HEIGHT
+#define AEON_DISPLAY_HEIGHT 64
+#endif
+
+/*
+Languages (AEON_Strings.h)
+AEON_LANGUAGE_ALL = All string packs, the language is selected in the setup menu
+AEON_LANGUAGE_*   = Only the pack of this language is in the flash, every language setting shows it
+*/
+#define AEON_LANGUAGE_ALL -1
+#define AEON_LANGUAGE_ENGLISH 0
+#define AEON_LANGUAGE_GERMAN 1
+#define AEON_LANGUAGE_FRENCH 2
+#define AEON_LANGUAGE_SPAIN 3
+
+#ifndef AEON_LANGUAGE
+#define AEON_LANGUAGE AEON_LANGUAGE_ALL
+#endif
+
+/*
+Language packs (AEON_Strings.h)
+AEON_PACKS     = 1: The language packs in the file system region of the flash are mounted at the start
+                 and follow the built-in languages in the setup menu
+AEON_PACKS_MAX = Packs that are mounted at most
+*/
+#ifndef AEON_PACKS
+#define AEON_PACKS 1
+#endif
+
+#ifndef AEON_PACKS_MAX
+#define AEON_PACKS_MAX 8
+#endif
+
+/*
+Remaining lifespan (AEON_LifeTable.h)
+AEON_LIFE_TABLES = 1: The remaining days are the life expectancy at the current age from the life table
+                   of the country and sex (AEON_LifeTables.h), the lifespan setting moves it. Needs
+                   published tables, the build stops while AEON_LifeTables.h holds placeholders
+                   0: The remaining days are the lifespan setting minus the age
+*/
+#ifndef AEON_LIFE_TABLES
+#define AEON_LIFE_TABLES 0
+#endif
+
+/*
+Base page
+AEON_COUNTDOWN = 1: The base page shows the remaining days with hours, minutes and seconds and the per mille
+                 of the life that has passed, counted every second from the baseline of the day
+                 0: The remaining days only
+*/
+#ifndef AEON_COUNTDOWN
+#define AEON_COUNTDOWN 0
+#endif
+
+/*
+AEON_THOUSANDS_SEPARATOR = 1: The remaining days on the base page are grouped by the separator of the language
+                           (12,345 / 12.345)
+                           0: The digits only (12345)
+*/
+#ifndef AEON_THOUSANDS_SEPARATOR
+#define AEON_THOUSANDS_SEPARATOR 1
+#endif
+
+/*
+I2C bus
+AEON_BUS_SDA / AEON_BUS_SCL = I2C pins (AEON: 4 / 5)
+AEON_BUS_CLOCK          = SCL frequency in Hz
+AEON_BUS_CHUNK_SIZE     = Frame bytes per I2C transaction while flushing the display, every
+                          chunk is a point where a waiting RTC transaction gets the bus
+AEON_BUS_SERVICE_BUDGET = Time in microseconds a flush may use the bus per bus.service()
+AEON_BUS_TIMEOUT        = Deadline of one I2C transaction in milliseconds, the controller is reset after a
+                          timeout (Wire.setTimeout(ms, true), arduino-pico 3.0.0 or newer)
+AEON_BUS_LOCK_TIMEOUT   = Time in milliseconds a transaction waits for the bus before it fails
+AEON_BUS_RETRIES        = Retries of a failed transaction, a bus clear runs before a retry
+                          unless the device only did not answer to its address
+AEON_BUS_BACKOFF        = Time in milliseconds the display flush pauses after a failed frame
+*/
+#ifndef AEON_BUS_SDA
+#define AEON_BUS_SDA 4
+#endif
+
+#ifndef AEON_BUS_SCL
+#define AEON_BUS_SCL 5
+#endif
+
+#ifndef AEON_BUS_CLOCK
+#define AEON_BUS_CLOCK 400000
+#endif
+
+#ifndef AEON_BUS_CHUNK_SIZE
+#define AEON_BUS_CHUNK_SIZE 64
+#endif
+
+#ifndef AEON_BUS_SERVICE_BUDGET
+#define AEON_BUS_SERVICE_BUDGET 2000
+#endif
+
+#ifndef AEON_BUS_TIMEOUT
+#define AEON_BUS_TIMEOUT 10
+#endif
+
+#ifndef AEON_BUS_LOCK_TIMEOUT
+#define AEON_BUS_LOCK_TIMEOUT 100
+#endif
+
+#ifndef AEON_BUS_RETRIES
+#define AEON_BUS_RETRIES 2
+#endif
+
+#ifndef AEON_BUS_BACKOFF
+#define AEON_BUS_BACKOFF 1000
+#endif
+
+/*
+State machine tables (AEON_FSM.h)
+AEON_FSM_STATES = Number of state ids (EState)
+AEON_FSM_EVENTS = Number of event ids per state (EEvent)
+*/
+#ifndef AEON_FSM_STATES
+#define AEON_FSM_STATES 32
+#endif
+
+#ifndef AEON_FSM_EVENTS
+#define AEON_FSM_EVENTS 4
+#endif
+
+/*
+Log (AEON_Log.h)
+AEON_LOG_RECORDS = Records in the ring of each core, power of two
+AEON_LOG_DRAIN   = Records printed per loop1() pass
+*/
+#ifndef AEON_LOG_RECORDS
+#define AEON_LOG_RECORDS 64
+#endif
+
+#ifndef AEON_LOG_DRAIN
+#define AEON_LOG_DRAIN 4
+#endif
+
+/*
+Profiler (AEON_Profiler.h)
+AEON_PROFILER = 1: Histograms of the loop phases and pages, "profile" on Serial prints them.
+                0: PROFILE_SCOPE() is empty and nothing is measured
+*/
+#ifndef AEON_PROFILER
+#define AEON_PROFILER 1
+#endif
+
+/*
+Input trace (AEON_Trace.h)
+AEON_TRACE         = 1: "trace start" / "trace stop" on Serial record the button edges and RTC readings
+AEON_TRACE_RECORDS = Records in the ring between core 0 and core 1, power of two
+AEON_TRACE_ROM     = Bytes of the EEPROM recorded at the start (signature and settings)
+*/
+#ifndef AEON_TRACE
+#define AEON_TRACE 1
+#endif
+
+#ifndef AEON_TRACE_RECORDS
+#define AEON_TRACE_RECORDS 128
+#endif
+
+#ifndef AEON_TRACE_ROM
+#define AEON_TRACE_ROM 32
+#endif
+
+/*
+Memory (AEON_Memory.h)
+AEON_STACK_PAINT = 1: Both cores paint their stack at the start, "memory" on Serial prints the deepest use
+*/
+#ifndef AEON_STACK_PAINT
+#define AEON_STACK_PAINT 1
+#endif
+
+/*
+Benchmarks (AEON_Bench.h)
+AEON_BENCH_TIME = Microseconds a benchmark runs at least, the iterations double until it is reached
+*/
+#ifndef AEON_BENCH_TIME
+#define AEON_BENCH_TIME 20000
+#endif
+
+/*
+Heap
+AEON_ZERO_HEAP = 1: The firmware does not allocate after setup. The heap in use is noted when the boot
+                 is finished and checked every second, any growth is logged (AEON_Heap.h)
+*/
+#ifndef AEON_ZERO_HEAP
+#define AEON_ZERO_HEAP 1
+#endif
+
+#endif
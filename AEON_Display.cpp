@@ -11,23 +11,39 @@ and various page-specific functions. The display driver returns an error state t
 #include <Arduino.h>
 #include <Adafruit_GFX.h>
 #include <Adafruit_SSD1306.h>
+#include "AEON_Config.h"
+#include "AEON_Panel.h"
+#include "AEON_Font.h"
 #include "AEON_Enums.h"
 #include "AEON_Strings.h"
 #include "AEON_Display.h"
+#include "AEON_Raster.h"
+#include "AEON_Format.h"
+#include "AEON_Profiler.h"
 #include "AEON_Time.h"
+#include "AEON_Bus.h"
+#include "AEON_Boot.h"
 
+extern AEON_Bus bus;
+extern AEON_Boot boot;
 extern AEON_Time timer;
 extern AEON_Strings strings;
 
-#define SCREEN_WIDTH 128 // OLED display width, in pixels
-#define SCREEN_HEIGHT 64 // OLED display height, in pixels
-
-#define OLED_RESET 3        // Reset pin # default 3 (old_18)
-#define SCREEN_ADDRESS 0x3C // See Datasheet for Address; 0x78 or 0x3C for 128x64
+// Panel geometry, controller and backend are selected in AEON_Config.h
+typedef AEON_PanelGeometry Panel;
 
 #define CHAR_BUFFER 32 // Set the Chars
 
-Adafruit_SSD1306 display(SCREEN_WIDTH, SCREEN_HEIGHT, &Wire, OLED_RESET);
+AEON_PanelDisplay display;
+AEON_Raster<Panel> raster;
+
+/*
+Keep the base page for the next boot, called by the bus when the frame was sent and not for every render
+*/
+static void storeBootFrame(const uint8_t *frame, size_t size)
+{
+  boot.storeFrame(frame, size);
+}
 
 /*
  Display
@@ -41,48 +57,59 @@ EReturn_DISPLAY AEON_Display::setupDisplay()
   uint16_t width;
   uint16_t height;
 
-  // SSD1306_SWITCHCAPVCC = generate display voltage from 3.3V internally
+  // Supply, address and init commands come from the controller of the panel
   Serial.println("Setup Display");
-  if (!display.begin(SSD1306_SWITCHCAPVCC, SCREEN_ADDRESS))
+  if (!display.begin())
   {
     Serial.println(F("SSD1306 allocation failed"));
     // for (;;)
     //     ; // Don't proceed, loop forever
     localReturn = EReturn_DISPLAY::ERROR_DISPLAY_ALLOCATION_FAILD;
+    this->lastErrorState = localReturn;
   }
 
-  // Show initial display buffer contents on the screen
-  // the library initializes this with an splash screen.
-  display.display();
-  delay(1);
-  display.clearDisplay();
+  // Lines and rectangles are drawn directly into the buffer of the display
+  raster.setBuffer(display.getBuffer());
   display.setRotation(degrees_0);
+  boot.mark(BOOT_PHASE_DISPLAY);
 
-  // Show the display buffer on the screen. You MUST call display() after
-  // drawing commands to make them visible on screen!
-  display.display();
-
-  // Set Logo
-  display.clearDisplay();
-  display.setTextSize(LARGE);
-  display.setTextColor(SSD1306_WHITE);
-  display.getTextBounds("AEON", 0, 0, &x1, &y1, &width, &height);
-  display.setCursor((SCREEN_WIDTH - width) / 2, (SCREEN_HEIGHT - height) / 3);
-  display.println(F("AEON"));
-
-  display.setTextSize(SMALL);
-  display.setCursor(44, 56);
-  display.println(F("by Manuel Ziel"));
+  // Show the last base page of the previous run at once, the splash only after a power loss.
+  // ROM and RTC are set up on core 1 meanwhile, the first real page follows when they are done.
+  if (!boot.restoreFrame(display.getBuffer(), Panel::BUFFER_SIZE))
+  {
+    // Set Logo
+    display.clearDisplay();
+    display.setTextSize(LARGE);
+    display.setTextColor(SSD1306_WHITE);
+    display.getTextBounds("AEON", 0, 0, &x1, &y1, &width, &height);
+    display.setCursor(Panel::centerX(width), (Panel::HEIGHT - height) / 3);
+    display.println(F("AEON"));
+
+    display.setTextSize(SMALL);
+    display.setCursor(44, 56);
+    display.println(F("by Manuel Ziel"));
+  }
   display.display();
-  delay(2000);
+  bus.flush();
+  boot.mark(BOOT_PHASE_SPLASH);
 
   return localReturn;
 }
 
 /*
-
+Send the next chunks of the frame and check if the display still answers
 */
-void AEON_Display::loopDisplay() {}
+void AEON_Display::loopDisplay()
+{
+  PROFILE_SCOPE(PROFILE_LOOP_DISPLAY);
+
+  bus.service();
+
+  if (bus.hasFault(BUS_DEVICE_DISPLAY))
+  {
+    this->lastErrorState = EReturn_DISPLAY::ERROR_DISPLAY_ALLOCATION_FAILD;
+  }
+}
 
 /*
 
@@ -127,7 +154,7 @@ void AEON_Display::printInt(int i)
 /*
 
 */
-void AEON_Display::printString(String s)
+void AEON_Display::printString(const char *s)
 {
   display.println(s);
 }
@@ -145,19 +172,14 @@ Reset the error to state return null
 */
 void AEON_Display::resetErrorStateDisplay()
 {
-  EReturn_DISPLAY lastErrorState = EReturn_DISPLAY::DISPLAY_RETURN_NULL;
+  this->lastErrorState = EReturn_DISPLAY::DISPLAY_RETURN_NULL;
 }
 
 /*
-Show the base page with Date, Time and remaining days.
+Date, Time and the "Remaining Days" text of the base pages
 */
-void AEON_Display::pageBase(int year, int month, int day, int dayOfTheWeek, int hour, int minute, int second, int lifetime)
+void AEON_Display::pageBaseHeader(int year, int month, int day, int dayOfTheWeek, int hour, int minute, int second)
 {
-  int16_t x1;
-  int16_t y1;
-  uint16_t width;
-  uint16_t height;
-
   // Clear display and set text color
   display.clearDisplay();
   display.setTextSize(SMALL);
@@ -165,54 +187,131 @@ void AEON_Display::pageBase(int year, int month, int day, int dayOfTheWeek, int
 
   // First line
   char bufFirstLine[CHAR_BUFFER];
-  snprintf(bufFirstLine, sizeof(bufFirstLine), "%s, %s %02d %4d",
-           strings.getWeekday(dayOfTheWeek),
-           strings.getMonth(month),
-           //dayOfWeekMapping[dayOfTheWeek],
-           //monthOfYearMapping[month],
-           day, year);
+  AEON_Format(bufFirstLine, sizeof(bufFirstLine))
+      .text(strings.getWeekday(dayOfTheWeek))
+      .text(", ")
+      .text(strings.getMonth(month))
+      .character(' ')
+      .number(day, 2)
+      .character(' ')
+      .number(year, 4, ' '); // "%s, %s %02d %4d"
   display.setCursor(0, 0);
   display.println(bufFirstLine);
 
   // Second line
   char bufSecondLine[CHAR_BUFFER];
-  snprintf(bufSecondLine, sizeof(bufSecondLine), "%02d:%02d:%02d",
-           hour, minute, second);
+  AEON_Format(bufSecondLine, sizeof(bufSecondLine))
+      .number(hour, 2)
+      .character(':')
+      .number(minute, 2)
+      .character(':')
+      .number(second, 2); // "%02d:%02d:%02d"
   display.setCursor(0, 10);
   display.println(bufSecondLine);
 
   // Third line
-  display.drawLine(0, 20, 128, 20, SSD1306_WHITE); // Line from x0-y20 to x128-y20
+  raster.drawHLine(0, 20, Panel::WIDTH, RASTER_WHITE); // Line from x0-y20 to x128-y20
 
   // Fourth line
   const char *remainingDaysText = strings.getString(AEON_Strings::EStrings::RemainingDays);
-  int remainingDaysTextLen = strlen(remainingDaysText);
-  int remainingDaysTextXPos = (SCREEN_WIDTH - (remainingDaysTextLen * 6)) / 2;
+  int remainingDaysTextLen = AEON_Font::length(remainingDaysText);
+  int remainingDaysTextXPos = Panel::centerX(Panel::textWidth(remainingDaysTextLen, SMALL));
   display.setCursor(remainingDaysTextXPos, 25);
   display.println(remainingDaysText);
+}
+
+/*
+Show the base page with Date, Time and remaining days.
+*/
+void AEON_Display::pageBase(int year, int month, int day, int dayOfTheWeek, int hour, int minute, int second, int lifetime)
+{
+  PROFILE_SCOPE(PROFILE_PAGE_BASE);
+
+  int16_t x1;
+  int16_t y1;
+  uint16_t width;
+  uint16_t height;
+
+  pageBaseHeader(year, month, day, dayOfTheWeek, hour, minute, second);
 
   // Last line
   display.setTextSize(LARGE);
 
   char bufLifetime[CHAR_BUFFER];
-  sprintf(bufLifetime, "%02d:", lifetime);
+  AEON_Format lifetimeText(bufLifetime, sizeof(bufLifetime));
 
-  int value;
-  if (lifetime > 0)
+  if (lifetime <= 0)
   {
-    sprintf(bufLifetime, "%02d", lifetime);
-  }
-  else
-  {
-    value = abs(lifetime);
-    sprintf(bufLifetime, "+%02d", value);
+    // Lived longer than the lifespan
+    lifetimeText.character('+');
   }
+  lifetimeText.grouped(abs(lifetime), AEON_THOUSANDS_SEPARATOR ? strings.getThousandsSeparator() : '\0', 2); // "%02d", 12,345 / 12.345
 
   display.getTextBounds(bufLifetime, 0, 0, &x1, &y1, &width, &height);
-  display.setCursor((SCREEN_WIDTH - width) / 2, 40);
+  display.setCursor(Panel::centerX(width), 40);
   display.println(bufLifetime);
 
-  display.display();
+  display.display(storeBootFrame); // Shown at the next boot
+}
+
+/*
+Show the base page with Date, Time, the remaining days with hours, minutes and seconds (AEON_COUNTDOWN) and
+the per mille of the life that has passed next to the time. After the end of the lifespan the time since then.
+*/
+void AEON_Display::pageBaseCountdown(int year, int month, int day, int dayOfTheWeek, int hour, int minute, int second, long lifetime, long countdown, int elapsed)
+{
+  PROFILE_SCOPE(PROFILE_PAGE_BASE);
+
+  pageBaseHeader(year, month, day, dayOfTheWeek, hour, minute, second);
+
+  // Elapsed, right of the time
+  char bufElapsed[CHAR_BUFFER];
+  AEON_Format elapsedText(bufElapsed, sizeof(bufElapsed));
+  elapsedText.number(elapsed / 10).character('.').number(elapsed % 10).character('%'); // "%d.%d%%"
+  display.setTextSize(SMALL);
+  display.setCursor(Panel::WIDTH - Panel::textWidth(elapsedText.length(), SMALL), 10);
+  display.print(bufElapsed);
+
+  // Lived longer than the lifespan, count up from its end
+  bool over = lifetime < 0;
+  if (over)
+  {
+    lifetime = -lifetime - 1;
+    countdown = 86400 - countdown;
+    if (countdown == 86400)
+    {
+      countdown = 0;
+      lifetime++;
+    }
+  }
+
+  // Days
+  char bufLifetime[CHAR_BUFFER];
+  AEON_Format lifetimeText(bufLifetime, sizeof(bufLifetime));
+  if (over)
+  {
+    lifetimeText.character('+');
+  }
+  lifetimeText.grouped(lifetime, AEON_THOUSANDS_SEPARATOR ? strings.getThousandsSeparator() : '\0', 2);
+
+  // Digits, sign and separator are ASCII, one cell each, the width comes from the count without getTextBounds()
+  display.setTextSize(MIDDLE);
+  display.setCursor(Panel::centerX(Panel::textWidth(lifetimeText.length(), MIDDLE)), 36);
+  display.print(bufLifetime);
+
+  // Last line
+  char bufCountdown[CHAR_BUFFER];
+  AEON_Format countdownText(bufCountdown, sizeof(bufCountdown));
+  countdownText.number(countdown / 3600, 2)
+      .character(':')
+      .number(countdown / 60 % 60, 2)
+      .character(':')
+      .number(countdown % 60, 2); // "%02d:%02d:%02d"
+  display.setTextSize(SMALL);
+  display.setCursor(Panel::centerX(Panel::textWidth(countdownText.length(), SMALL)), 56);
+  display.print(bufCountdown);
+
+  display.display(storeBootFrame); // Shown at the next boot
 }
 
 /*
@@ -223,6 +322,8 @@ the middle of the display and reads "Setup Time".
 */
 void AEON_Display::pageSetupTime()
 {
+  PROFILE_SCOPE(PROFILE_PAGE_TIME);
+
   // Variables
   int16_t x1;
   int16_t y1;
@@ -237,17 +338,17 @@ void AEON_Display::pageSetupTime()
   const char *setup = strings.getString(AEON_Strings::EStrings::Setup);
   display.setTextSize(MIDDLE);
   display.getTextBounds(setup, 0, 0, &x1, &y1, &width, &height);
-  display.setCursor((SCREEN_WIDTH - width) / 2, 0);
+  display.setCursor(Panel::centerX(width), 0);
   display.println(setup);
 
   // Second line
-  display.drawLine(0, 20, 128, 20, SSD1306_WHITE); // Line from x0-y20 to x128-y20
+  raster.drawHLine(0, 20, Panel::WIDTH, RASTER_WHITE); // Line from x0-y20 to x128-y20
 
   // Third line
   const char* setupTime = strings.getString(AEON_Strings::EStrings::SetupTime);
   display.setTextSize(SMALL);
   display.getTextBounds(setupTime, 0, 0, &x1, &y1, &width, &height);
-  display.setCursor((SCREEN_WIDTH - width) / 2, 40);
+  display.setCursor(Panel::centerX(width), 40);
   display.println(setupTime);
 
   display.display();
@@ -261,6 +362,8 @@ sets the text color to white, and then prints the time and boundary sizes in the
 */
 void AEON_Display::pageSetupTime_set_time(EState state, int hour, int minute, int second)
 {
+  PROFILE_SCOPE(PROFILE_PAGE_TIME);
+
   int16_t x1;
   int16_t y1;
   uint16_t width;
@@ -274,11 +377,11 @@ void AEON_Display::pageSetupTime_set_time(EState state, int hour, int minute, in
   const char* time = strings.getString(AEON_Strings::EStrings::Time);
   display.setTextSize(MIDDLE);
   display.getTextBounds(time, 0, 0, &x1, &y1, &width, &height);
-  display.setCursor((SCREEN_WIDTH - width) / 2, 0);
+  display.setCursor(Panel::centerX(width), 0);
   display.println(time);
 
   // Second line
-  display.drawLine(0, 20, 128, 20, SSD1306_WHITE); // Line from x0-y20 to x128-y20
+  raster.drawHLine(0, 20, Panel::WIDTH, RASTER_WHITE); // Line from x0-y20 to x128-y20
 
   // Third line
   uint16_t width_first_boundary;
@@ -322,25 +425,19 @@ void AEON_Display::pageSetupTime_set_time(EState state, int hour, int minute, in
 
   if (boundarySize[1] == MIDDLE)
   {
-    sprintf(bufFirstBoundary, "%02d:",
-            hour);
+    AEON_Format(bufFirstBoundary, sizeof(bufFirstBoundary)).number(hour, 2).character(':');
 
-    sprintf(bufSecondBoundary, "%02d",
-            minute);
+    AEON_Format(bufSecondBoundary, sizeof(bufSecondBoundary)).number(minute, 2);
 
-    sprintf(bufThirdBoundary, ":%02d",
-            second);
+    AEON_Format(bufThirdBoundary, sizeof(bufThirdBoundary)).character(':').number(second, 2);
   }
   else
   {
-    sprintf(bufFirstBoundary, "%02d",
-            hour);
+    AEON_Format(bufFirstBoundary, sizeof(bufFirstBoundary)).number(hour, 2);
 
-    sprintf(bufSecondBoundary, ":%02d:",
-            minute);
+    AEON_Format(bufSecondBoundary, sizeof(bufSecondBoundary)).character(':').number(minute, 2).character(':');
 
-    sprintf(bufThirdBoundary, "%02d",
-            second);
+    AEON_Format(bufThirdBoundary, sizeof(bufThirdBoundary)).number(second, 2);
   }
 
   // Calc width of the bounds
@@ -354,7 +451,7 @@ void AEON_Display::pageSetupTime_set_time(EState state, int hour, int minute, in
   display.getTextBounds(bufThirdBoundary, 0, 0, &x1_third_boundary, &y1_third_boundary, &width_third_boundary, &height_third_boundary);
 
   uint16_t complBoundarysWidth = (width_first_boundary + (width_second_boundary + width_third_boundary));
-  uint16_t spaceBoundarysToScreen = (SCREEN_WIDTH - complBoundarysWidth) / 2;
+  uint16_t spaceBoundarysToScreen = Panel::centerX(complBoundarysWidth);
 
   // First boundary
   display.setTextSize(boundarySize[0]);
@@ -382,6 +479,8 @@ the middle of the display and reads "Setup Date".
 */
 void AEON_Display::pageSetupDate()
 {
+  PROFILE_SCOPE(PROFILE_PAGE_DATE);
+
   int16_t x1;
   int16_t y1;
   uint16_t width;
@@ -395,17 +494,17 @@ void AEON_Display::pageSetupDate()
   const char *setup = strings.getString(AEON_Strings::EStrings::Setup);
   display.setTextSize(MIDDLE);
   display.getTextBounds(setup, 0, 0, &x1, &y1, &width, &height);
-  display.setCursor((SCREEN_WIDTH - width) / 2, 0);
+  display.setCursor(Panel::centerX(width), 0);
   display.println(setup);
 
   // Second line
-  display.drawLine(0, 20, 128, 20, SSD1306_WHITE); // Line from x0-y20 to x128-y20
+  raster.drawHLine(0, 20, Panel::WIDTH, RASTER_WHITE); // Line from x0-y20 to x128-y20
 
   // Third line
   const char *setupDate = strings.getString(AEON_Strings::EStrings::SetupDate);
   display.setTextSize(SMALL);
   display.getTextBounds(setupDate, 0, 0, &x1, &y1, &width, &height);
-  display.setCursor((SCREEN_WIDTH - width) / 2, 40);
+  display.setCursor(Panel::centerX(width), 40);
   display.println(setupDate);
 
   display.display();
@@ -419,6 +518,8 @@ sets the text color to white, and then prints the Date and boundary sizes in the
 */
 void AEON_Display::pageSetupDate_set_date(EState state, int year, int month, int day)
 {
+  PROFILE_SCOPE(PROFILE_PAGE_DATE);
+
 
   int16_t x1;
   int16_t y1;
@@ -433,11 +534,11 @@ void AEON_Display::pageSetupDate_set_date(EState state, int year, int month, int
   const char *date = strings.getString(AEON_Strings::EStrings::Date);
   display.setTextSize(MIDDLE);
   display.getTextBounds(date, 0, 0, &x1, &y1, &width, &height);
-  display.setCursor((SCREEN_WIDTH - width) / 2, 0);
+  display.setCursor(Panel::centerX(width), 0);
   display.println(date);
 
   // Second line
-  display.drawLine(0, 20, 128, 20, SSD1306_WHITE); // Line from x0-y20 to x128-y20
+  raster.drawHLine(0, 20, Panel::WIDTH, RASTER_WHITE); // Line from x0-y20 to x128-y20
 
   // Third line
   uint16_t width_first_boundary;
@@ -481,25 +582,19 @@ void AEON_Display::pageSetupDate_set_date(EState state, int year, int month, int
 
   if (boundarySize[1] == MIDDLE)
   {
-    sprintf(bufFirstBoundary, "%02d:",
-            year);
+    AEON_Format(bufFirstBoundary, sizeof(bufFirstBoundary)).number(year, 2).character(':');
 
-    sprintf(bufSecondBoundary, "%s",
-            strings.getMonth(month));
+    AEON_Format(bufSecondBoundary, sizeof(bufSecondBoundary)).text(strings.getMonth(month));
 
-    sprintf(bufThirdBoundary, ":%02d",
-            day);
+    AEON_Format(bufThirdBoundary, sizeof(bufThirdBoundary)).character(':').number(day, 2);
   }
   else
   {
-    sprintf(bufFirstBoundary, "%02d",
-            year);
+    AEON_Format(bufFirstBoundary, sizeof(bufFirstBoundary)).number(year, 2);
 
-    sprintf(bufSecondBoundary, ":%s:",
-            strings.getMonth(month));
+    AEON_Format(bufSecondBoundary, sizeof(bufSecondBoundary)).character(':').text(strings.getMonth(month)).character(':');
 
-    sprintf(bufThirdBoundary, "%02d",
-            day);
+    AEON_Format(bufThirdBoundary, sizeof(bufThirdBoundary)).number(day, 2);
   }
 
   // Calc width of the bounds
@@ -513,7 +608,7 @@ void AEON_Display::pageSetupDate_set_date(EState state, int year, int month, int
   display.getTextBounds(bufThirdBoundary, 0, 0, &x1_third_boundary, &y1_third_boundary, &width_third_boundary, &height_third_boundary);
 
   uint16_t complBoundarysWidth = (width_first_boundary + (width_second_boundary + width_third_boundary));
-  uint16_t spaceBoundarysToScreen = (SCREEN_WIDTH - complBoundarysWidth) / 2;
+  uint16_t spaceBoundarysToScreen = Panel::centerX(complBoundarysWidth);
 
   // First boundary
   display.setTextSize(boundarySize[0]);
@@ -541,6 +636,8 @@ the middle of the display and reads "Setup Birthday".
 */
 void AEON_Display::pageSetupBirthday()
 {
+  PROFILE_SCOPE(PROFILE_PAGE_BIRTHDAY);
+
   int16_t x1;
   int16_t y1;
   uint16_t width;
@@ -554,17 +651,17 @@ void AEON_Display::pageSetupBirthday()
   const char *setup = strings.getString(AEON_Strings::EStrings::Setup);
   display.setTextSize(MIDDLE);
   display.getTextBounds(setup, 0, 0, &x1, &y1, &width, &height);
-  display.setCursor((SCREEN_WIDTH - width) / 2, 0);
+  display.setCursor(Panel::centerX(width), 0);
   display.println(setup);
 
   // Second line
-  display.drawLine(0, 20, 128, 20, SSD1306_WHITE); // Line from x0-y20 to x128-y20
+  raster.drawHLine(0, 20, Panel::WIDTH, RASTER_WHITE); // Line from x0-y20 to x128-y20
 
   // Third line
   const char *setupBirthday = strings.getString(AEON_Strings::EStrings::SetupBirthday);
   display.setTextSize(SMALL);
   display.getTextBounds(setupBirthday, 0, 0, &x1, &y1, &width, &height);
-  display.setCursor((SCREEN_WIDTH - width) / 2, 40);
+  display.setCursor(Panel::centerX(width), 40);
   display.println(setupBirthday);
 
   display.display();
@@ -578,6 +675,8 @@ sets the text color to white, and then prints the Date and boundary sizes in the
 */
 void AEON_Display::pageSetupBirthday_set_date(EState state, int year, int month, int day)
 {
+  PROFILE_SCOPE(PROFILE_PAGE_BIRTHDAY);
+
 
   int16_t x1;
   int16_t y1;
@@ -591,11 +690,11 @@ void AEON_Display::pageSetupBirthday_set_date(EState state, int year, int month,
   const char *birthday = strings.getString(AEON_Strings::EStrings::Birthday);
   display.setTextSize(MIDDLE);
   display.getTextBounds(birthday, 0, 0, &x1, &y1, &width, &height);
-  display.setCursor((SCREEN_WIDTH - width) / 2, 0);
+  display.setCursor(Panel::centerX(width), 0);
   display.println(birthday);
 
   // Second line
-  display.drawLine(0, 20, 128, 20, SSD1306_WHITE); // Line from x0-y20 to x128-y20
+  raster.drawHLine(0, 20, Panel::WIDTH, RASTER_WHITE); // Line from x0-y20 to x128-y20
 
   // Third line
   uint16_t width_first_boundary;
@@ -639,25 +738,19 @@ void AEON_Display::pageSetupBirthday_set_date(EState state, int year, int month,
 
   if (boundarySize[1] == MIDDLE)
   {
-    sprintf(bufFirstBoundary, "%02d:",
-            year);
+    AEON_Format(bufFirstBoundary, sizeof(bufFirstBoundary)).number(year, 2).character(':');
 
-    sprintf(bufSecondBoundary, "%s",
-            strings.getMonth(month));
+    AEON_Format(bufSecondBoundary, sizeof(bufSecondBoundary)).text(strings.getMonth(month));
 
-    sprintf(bufThirdBoundary, ":%02d",
-            day);
+    AEON_Format(bufThirdBoundary, sizeof(bufThirdBoundary)).character(':').number(day, 2);
   }
   else
   {
-    sprintf(bufFirstBoundary, "%02d",
-            year);
+    AEON_Format(bufFirstBoundary, sizeof(bufFirstBoundary)).number(year, 2);
 
-    sprintf(bufSecondBoundary, ":%s:",
-            strings.getMonth(month));
+    AEON_Format(bufSecondBoundary, sizeof(bufSecondBoundary)).character(':').text(strings.getMonth(month)).character(':');
 
-    sprintf(bufThirdBoundary, "%02d",
-            day);
+    AEON_Format(bufThirdBoundary, sizeof(bufThirdBoundary)).number(day, 2);
   }
 
   // Calc width of the bounds
@@ -671,7 +764,7 @@ void AEON_Display::pageSetupBirthday_set_date(EState state, int year, int month,
   display.getTextBounds(bufThirdBoundary, 0, 0, &x1_third_boundary, &y1_third_boundary, &width_third_boundary, &height_third_boundary);
 
   uint16_t complBoundarysWidth = (width_first_boundary + (width_second_boundary + width_third_boundary));
-  uint16_t spaceBoundarysToScreen = (SCREEN_WIDTH - complBoundarysWidth) / 2;
+  uint16_t spaceBoundarysToScreen = Panel::centerX(complBoundarysWidth);
 
   // First boundary
   display.setTextSize(boundarySize[0]);
@@ -699,6 +792,8 @@ the middle of the display and reads "Setup Sex".
 */
 void AEON_Display::pageSetupSex()
 {
+  PROFILE_SCOPE(PROFILE_PAGE_SEX);
+
   int16_t x1;
   int16_t y1;
   uint16_t width;
@@ -712,17 +807,17 @@ void AEON_Display::pageSetupSex()
   const char *setup = strings.getString(AEON_Strings::EStrings::Setup);
   display.setTextSize(MIDDLE);
   display.getTextBounds(setup, 0, 0, &x1, &y1, &width, &height);
-  display.setCursor((SCREEN_WIDTH - width) / 2, 0);
+  display.setCursor(Panel::centerX(width), 0);
   display.println(setup);
 
   // Second line
-  display.drawLine(0, 20, 128, 20, SSD1306_WHITE); // Line from x0-y20 to x128-y20
+  raster.drawHLine(0, 20, Panel::WIDTH, RASTER_WHITE); // Line from x0-y20 to x128-y20
 
   // Third line
   const char *setupSex = strings.getString(AEON_Strings::EStrings::SetupSex);
   display.setTextSize(SMALL);
   display.getTextBounds(setupSex, 0, 0, &x1, &y1, &width, &height);
-  display.setCursor((SCREEN_WIDTH - width) / 2, 40);
+  display.setCursor(Panel::centerX(width), 40);
   display.println(setupSex);
 
   display.display();
@@ -734,6 +829,8 @@ sets the text color to white, and then prints the Sex and boundary sizes in the
 */
 void AEON_Display::pageSetupSex_set(ESex sex)
 {
+  PROFILE_SCOPE(PROFILE_PAGE_SEX);
+
   int16_t x1;
   int16_t y1;
   uint16_t width;
@@ -746,11 +843,11 @@ void AEON_Display::pageSetupSex_set(ESex sex)
   const char* charSex = strings.getString(AEON_Strings::EStrings::Sex);
   display.setTextSize(MIDDLE);
   display.getTextBounds(charSex, 0, 0, &x1, &y1, &width, &height);
-  display.setCursor((SCREEN_WIDTH - width) / 2, 0);
+  display.setCursor(Panel::centerX(width), 0);
   display.println(charSex);
 
   // Second line
-  display.drawLine(0, 20, 128, 20, SSD1306_WHITE); // Line from x0-y20 to x128-y20
+  raster.drawHLine(0, 20, Panel::WIDTH, RASTER_WHITE); // Line from x0-y20 to x128-y20
 
   // Third line
   uint16_t width_first_boundary;
@@ -775,7 +872,7 @@ void AEON_Display::pageSetupSex_set(ESex sex)
   char bufSecondBoundary[CHAR_BUFFER];
   char bufThirdBoundary[CHAR_BUFFER];
 
-  sprintf(bufFirstBoundary, "%s", " ");
+  AEON_Format(bufFirstBoundary, sizeof(bufFirstBoundary)).text(" ");
 
   const char* female = strings.getString(AEON_Strings::EStrings::Female);
   const char* male = strings.getString(AEON_Strings::EStrings::Male);
@@ -783,18 +880,18 @@ void AEON_Display::pageSetupSex_set(ESex sex)
   switch (sex)
   {
   case ESex::Female:
-    sprintf(bufSecondBoundary, "%s", female);
+    AEON_Format(bufSecondBoundary, sizeof(bufSecondBoundary)).text(female);
     break;
 
   case ESex::Male:
-    sprintf(bufSecondBoundary, "%s", male);
+    AEON_Format(bufSecondBoundary, sizeof(bufSecondBoundary)).text(male);
     break;
 
   default:
     break;
   }
 
-  sprintf(bufThirdBoundary, "%s", " ");
+  AEON_Format(bufThirdBoundary, sizeof(bufThirdBoundary)).text(" ");
 
   // Calc width of the bounds
   display.setTextSize(boundarySize[0]);
@@ -807,7 +904,7 @@ void AEON_Display::pageSetupSex_set(ESex sex)
   display.getTextBounds(bufThirdBoundary, 0, 0, &x1_third_boundary, &y1_third_boundary, &width_third_boundary, &height_third_boundary);
 
   uint16_t complBoundarysWidth = (width_first_boundary + (width_second_boundary + width_third_boundary));
-  uint16_t spaceBoundarysToScreen = (SCREEN_WIDTH - complBoundarysWidth) / 2;
+  uint16_t spaceBoundarysToScreen = Panel::centerX(complBoundarysWidth);
 
   // First boundary
   display.setTextSize(boundarySize[0]);
@@ -827,6 +924,83 @@ void AEON_Display::pageSetupSex_set(ESex sex)
   display.display();
 }
 
+/*
+This function displays a setup page on the display, allowing the user to set AEON.
+The page consists of a title and a subtitle, separated by a horizontal line. The title
+is centered at the top of the display and reads "Setup". The subtitle is centered in
+the middle of the display and reads "Setup Country".
+*/
+void AEON_Display::pageSetupCountry()
+{
+  PROFILE_SCOPE(PROFILE_PAGE_COUNTRY);
+
+  int16_t x1;
+  int16_t y1;
+  uint16_t width;
+  uint16_t height;
+
+  // Clear display and set text color
+  display.clearDisplay();
+  display.setTextColor(SSD1306_WHITE);
+
+  // First line
+  const char *setup = strings.getString(AEON_Strings::EStrings::Setup);
+  display.setTextSize(MIDDLE);
+  display.getTextBounds(setup, 0, 0, &x1, &y1, &width, &height);
+  display.setCursor(Panel::centerX(width), 0);
+  display.println(setup);
+
+  // Second line
+  raster.drawHLine(0, 20, Panel::WIDTH, RASTER_WHITE); // Line from x0-y20 to x128-y20
+
+  // Third line
+  const char *setupCountry = strings.getString(AEON_Strings::EStrings::SetupCountry);
+  display.setTextSize(SMALL);
+  display.getTextBounds(setupCountry, 0, 0, &x1, &y1, &width, &height);
+  display.setCursor(Panel::centerX(width), 40);
+  display.println(setupCountry);
+
+  display.display();
+}
+
+/*
+Sets the Country for the page setup display. The display shows the code of the current Country (AEON_Lifespan.h),
+the default lifespans follow it.
+*/
+void AEON_Display::pageSetupCountry_set(const char *country)
+{
+  PROFILE_SCOPE(PROFILE_PAGE_COUNTRY);
+
+  int16_t x1;
+  int16_t y1;
+  uint16_t width;
+  uint16_t height;
+
+  display.clearDisplay();
+  display.setTextColor(SSD1306_WHITE);
+
+  // First line
+  const char* charCountry = strings.getString(AEON_Strings::EStrings::Country);
+  display.setTextSize(MIDDLE);
+  display.getTextBounds(charCountry, 0, 0, &x1, &y1, &width, &height);
+  display.setCursor(Panel::centerX(width), 0);
+  display.println(charCountry);
+
+  // Second line
+  raster.drawHLine(0, 20, Panel::WIDTH, RASTER_WHITE); // Line from x0-y20 to x128-y20
+
+  // Third line
+  char bufCountry[CHAR_BUFFER];
+  AEON_Format(bufCountry, sizeof(bufCountry)).text(country);
+
+  display.setTextSize(MIDDLE);
+  display.getTextBounds(bufCountry, 0, 0, &x1, &y1, &width, &height);
+  display.setCursor(Panel::centerX(width), 40);
+  display.print(bufCountry);
+
+  display.display();
+}
+
 /*
 This function displays a setup page on the display, allowing the user to set AEON.
 The page consists of a title and a subtitle, separated by a horizontal line. The title
@@ -835,6 +1009,8 @@ the middle of the display and reads "Setup Lifespan".
 */
 void AEON_Display::pageSetupLifespan()
 {
+  PROFILE_SCOPE(PROFILE_PAGE_LIFESPAN);
+
   int16_t x1;
   int16_t y1;
   uint16_t width;
@@ -848,17 +1024,17 @@ void AEON_Display::pageSetupLifespan()
   const char *setup = strings.getString(AEON_Strings::EStrings::Setup);
   display.setTextSize(MIDDLE);
   display.getTextBounds(setup, 0, 0, &x1, &y1, &width, &height);
-  display.setCursor((SCREEN_WIDTH - width) / 2, 0);
+  display.setCursor(Panel::centerX(width), 0);
   display.println(setup);
 
   // Second line
-  display.drawLine(0, 20, 128, 20, SSD1306_WHITE); // Line from x0-y20 to x128-y20
+  raster.drawHLine(0, 20, Panel::WIDTH, RASTER_WHITE); // Line from x0-y20 to x128-y20
 
   // Third line
   const char* setupLifespan = strings.getString(AEON_Strings::EStrings::SetupLifespan);
   display.setTextSize(SMALL);
   display.getTextBounds(setupLifespan, 0, 0, &x1, &y1, &width, &height);
-  display.setCursor((SCREEN_WIDTH - width) / 2, 40);
+  display.setCursor(Panel::centerX(width), 40);
   display.println(setupLifespan);
 
   display.display();
@@ -870,6 +1046,8 @@ sets the text color to white, and then prints the Lifespan and boundary sizes in
 */
 void AEON_Display::pageSetupLifespan_set(int lifespan)
 {
+  PROFILE_SCOPE(PROFILE_PAGE_LIFESPAN);
+
   int16_t x1;
   int16_t y1;
   uint16_t width;
@@ -882,11 +1060,11 @@ void AEON_Display::pageSetupLifespan_set(int lifespan)
   const char* charLifespan = strings.getString(AEON_Strings::EStrings::Lifespan);
   display.setTextSize(MIDDLE);
   display.getTextBounds(charLifespan, 0, 0, &x1, &y1, &width, &height);
-  display.setCursor((SCREEN_WIDTH - width) / 2, 0);
+  display.setCursor(Panel::centerX(width), 0);
   display.println(charLifespan);
 
   // Second line
-  display.drawLine(0, 20, 128, 20, SSD1306_WHITE); // Line from x0-y20 to x128-y20
+  raster.drawHLine(0, 20, Panel::WIDTH, RASTER_WHITE); // Line from x0-y20 to x128-y20
 
   // Third line
   uint16_t width_first_boundary;
@@ -911,14 +1089,11 @@ void AEON_Display::pageSetupLifespan_set(int lifespan)
   char bufSecondBoundary[CHAR_BUFFER];
   char bufThirdBoundary[CHAR_BUFFER];
 
-  sprintf(bufFirstBoundary, "%s",
-          charLifespan);
+  AEON_Format(bufFirstBoundary, sizeof(bufFirstBoundary)).text(charLifespan);
 
-  sprintf(bufSecondBoundary, "%s",
-          " ");
+  AEON_Format(bufSecondBoundary, sizeof(bufSecondBoundary)).text(" ");
 
-  sprintf(bufThirdBoundary, "%02d",
-          lifespan);
+  AEON_Format(bufThirdBoundary, sizeof(bufThirdBoundary)).number(lifespan, 2);
 
   // Calc width of the bounds
   display.setTextSize(boundarySize[0]);
@@ -931,7 +1106,7 @@ void AEON_Display::pageSetupLifespan_set(int lifespan)
   display.getTextBounds(bufThirdBoundary, 0, 0, &x1_third_boundary, &y1_third_boundary, &width_third_boundary, &height_third_boundary);
 
   uint16_t complBoundarysWidth = (width_first_boundary + (width_second_boundary + width_third_boundary));
-  uint16_t spaceBoundarysToScreen = (SCREEN_WIDTH - complBoundarysWidth) / 2;
+  uint16_t spaceBoundarysToScreen = Panel::centerX(complBoundarysWidth);
 
   // First boundary
   display.setTextSize(boundarySize[0]);
@@ -959,6 +1134,8 @@ the middle of the display and reads "Setup Language".
 */
 void AEON_Display::pageSetupLanguage()
 {
+  PROFILE_SCOPE(PROFILE_PAGE_LANGUAGE);
+
   int16_t x1;
   int16_t y1;
   uint16_t width;
@@ -972,17 +1149,17 @@ void AEON_Display::pageSetupLanguage()
   const char* setup = strings.getString(AEON_Strings::EStrings::Setup);
   display.setTextSize(MIDDLE);
   display.getTextBounds(setup, 0, 0, &x1, &y1, &width, &height);
-  display.setCursor((SCREEN_WIDTH - width) / 2, 0);
+  display.setCursor(Panel::centerX(width), 0);
   display.println(setup);
 
   // Second line
-  display.drawLine(0, 20, 128, 20, SSD1306_WHITE); // Line from x0-y20 to x128-y20
+  raster.drawHLine(0, 20, Panel::WIDTH, RASTER_WHITE); // Line from x0-y20 to x128-y20
 
   // Third line
   const char* setupLanguage = strings.getString(AEON_Strings::EStrings::SetupLanguage);
   display.setTextSize(SMALL);
   display.getTextBounds(setupLanguage, 0, 0, &x1, &y1, &width, &height);
-  display.setCursor((SCREEN_WIDTH - width) / 2, 40);
+  display.setCursor(Panel::centerX(width), 40);
   display.println(setupLanguage);
 
   display.display();
@@ -994,6 +1171,8 @@ sets the text color to white, and then prints the Sex and boundary sizes in the
 */
 void AEON_Display::pageSetupLanguage_set(ELanguage language)
 {
+  PROFILE_SCOPE(PROFILE_PAGE_LANGUAGE);
+
   int16_t x1;
   int16_t y1;
   uint16_t width;
@@ -1007,11 +1186,11 @@ void AEON_Display::pageSetupLanguage_set(ELanguage language)
   const char* charLanguage = strings.getString(AEON_Strings::EStrings::Language);
   display.setTextSize(MIDDLE);
   display.getTextBounds(charLanguage, 0, 0, &x1, &y1, &width, &height);
-  display.setCursor((SCREEN_WIDTH - width) / 2, 0);
+  display.setCursor(Panel::centerX(width), 0);
   display.println(charLanguage);
 
   // Second line
-  display.drawLine(0, 20, 128, 20, SSD1306_WHITE); // Line from x0-y20 to x128-y20
+  raster.drawHLine(0, 20, Panel::WIDTH, RASTER_WHITE); // Line from x0-y20 to x128-y20
 
   // Third line
   uint16_t width_first_boundary;
@@ -1036,7 +1215,7 @@ void AEON_Display::pageSetupLanguage_set(ELanguage language)
   char bufSecondBoundary[CHAR_BUFFER];
   char bufThirdBoundary[CHAR_BUFFER];
 
-  sprintf(bufFirstBoundary, "%s", " ");
+  AEON_Format(bufFirstBoundary, sizeof(bufFirstBoundary)).text(" ");
 
   const char* string = "";
 
@@ -1044,29 +1223,32 @@ void AEON_Display::pageSetupLanguage_set(ELanguage language)
   {
   case ELanguage::English :
     string = strings.getString(AEON_Strings::EStrings::English);
-    sprintf(bufSecondBoundary, "%s", string);
+    AEON_Format(bufSecondBoundary, sizeof(bufSecondBoundary)).text(string);
     break;
 
   case ELanguage::German :
     string = strings.getString(AEON_Strings::EStrings::German);
-    sprintf(bufSecondBoundary, "%s", string);
+    AEON_Format(bufSecondBoundary, sizeof(bufSecondBoundary)).text(string);
     break;
 
     case ELanguage::French :
     string = strings.getString(AEON_Strings::EStrings::French);
-    sprintf(bufSecondBoundary, "%s", string);
+    AEON_Format(bufSecondBoundary, sizeof(bufSecondBoundary)).text(string);
     break;
 
     case ELanguage::Spain :
     string = strings.getString(AEON_Strings::EStrings::Spain);
-    sprintf(bufSecondBoundary, "%s", string);
+    AEON_Format(bufSecondBoundary, sizeof(bufSecondBoundary)).text(string);
     break;
 
+  // Loaded language pack
   default:
+    string = strings.getLanguageName(language);
+    AEON_Format(bufSecondBoundary, sizeof(bufSecondBoundary)).text(string);
     break;
   }
 
-  sprintf(bufThirdBoundary, "%s", " ");
+  AEON_Format(bufThirdBoundary, sizeof(bufThirdBoundary)).text(" ");
 
   // Calc width of the bounds
   display.setTextSize(boundarySize[0]);
@@ -1079,7 +1261,7 @@ void AEON_Display::pageSetupLanguage_set(ELanguage language)
   display.getTextBounds(bufThirdBoundary, 0, 0, &x1_third_boundary, &y1_third_boundary, &width_third_boundary, &height_third_boundary);
 
   uint16_t complBoundarysWidth = (width_first_boundary + (width_second_boundary + width_third_boundary));
-  uint16_t spaceBoundarysToScreen = (SCREEN_WIDTH - complBoundarysWidth) / 2;
+  uint16_t spaceBoundarysToScreen = Panel::centerX(complBoundarysWidth);
 
   // First boundary
   display.setTextSize(boundarySize[0]);
@@ -1107,6 +1289,8 @@ the middle of the display and reads "Setup Reset".
 */
 void AEON_Display::pageSetupReset()
 {
+  PROFILE_SCOPE(PROFILE_PAGE_RESET);
+
   int16_t x1;
   int16_t y1;
   uint16_t width;
@@ -1120,17 +1304,17 @@ void AEON_Display::pageSetupReset()
   const char *setup = strings.getString(AEON_Strings::EStrings::Setup);
   display.setTextSize(MIDDLE);
   display.getTextBounds(setup, 0, 0, &x1, &y1, &width, &height);
-  display.setCursor((SCREEN_WIDTH - width) / 2, 0);
+  display.setCursor(Panel::centerX(width), 0);
   display.println(setup);
 
   // Second line
-  display.drawLine(0, 20, 128, 20, SSD1306_WHITE); // Line from x0-y20 to x128-y20
+  raster.drawHLine(0, 20, Panel::WIDTH, RASTER_WHITE); // Line from x0-y20 to x128-y20
 
   // Third line
   const char* reset = strings.getString(AEON_Strings::EStrings::SetupReset);
   display.setTextSize(SMALL);
   display.getTextBounds(reset, 0, 0, &x1, &y1, &width, &height);
-  display.setCursor((SCREEN_WIDTH - width) / 2, 40);
+  display.setCursor(Panel::centerX(width), 40);
   display.println(reset);
 
   display.display();
@@ -1142,6 +1326,8 @@ sets the text color to white, and then prints the Question and boundary sizes in
 */
 void AEON_Display::pageSetupReset_set(EState state)
 {
+  PROFILE_SCOPE(PROFILE_PAGE_RESET);
+
   int16_t x1;
   int16_t y1;
   uint16_t width;
@@ -1155,11 +1341,11 @@ void AEON_Display::pageSetupReset_set(EState state)
   const char* reset = strings.getString(AEON_Strings::EStrings::Reset);
   display.setTextSize(MIDDLE);
   display.getTextBounds(reset, 0, 0, &x1, &y1, &width, &height);
-  display.setCursor((SCREEN_WIDTH - width) / 2, 0);
+  display.setCursor(Panel::centerX(width), 0);
   display.println(reset);
 
   // Second line
-  display.drawLine(0, 20, 128, 20, SSD1306_WHITE); // Line from x0-y20 to x128-y20
+  raster.drawHLine(0, 20, Panel::WIDTH, RASTER_WHITE); // Line from x0-y20 to x128-y20
 
   // Third line
   uint16_t width_first_boundary;
@@ -1200,12 +1386,12 @@ void AEON_Display::pageSetupReset_set(EState state)
 
   
   const char* yes = strings.getString(AEON_Strings::EStrings::YES);
-  sprintf(bufFirstBoundary, "%s",yes);
+  AEON_Format(bufFirstBoundary, sizeof(bufFirstBoundary)).text(yes);
 
-  sprintf(bufSecondBoundary, "%s"," ");
+  AEON_Format(bufSecondBoundary, sizeof(bufSecondBoundary)).text(" ");
 
   const char* no = strings.getString(AEON_Strings::EStrings::NO);
-  sprintf(bufThirdBoundary, "%s",no);
+  AEON_Format(bufThirdBoundary, sizeof(bufThirdBoundary)).text(no);
 
   // Calc width of the bounds
   display.setTextSize(boundarySize[0]);
@@ -1218,7 +1404,7 @@ void AEON_Display::pageSetupReset_set(EState state)
   display.getTextBounds(bufThirdBoundary, 0, 0, &x1_third_boundary, &y1_third_boundary, &width_third_boundary, &height_third_boundary);
 
   uint16_t complBoundarysWidth = (width_first_boundary + (width_second_boundary + width_third_boundary));
-  uint16_t spaceBoundarysToScreen = (SCREEN_WIDTH - complBoundarysWidth) / 2;
+  uint16_t spaceBoundarysToScreen = Panel::centerX(complBoundarysWidth);
 
   // First boundary
   display.setTextSize(boundarySize[0]);
@@ -1243,6 +1429,8 @@ void AEON_Display::pageSetupReset_set(EState state)
 */
 void AEON_Display::pageSetupReset_count_final(int cnt_reset)
 {
+  PROFILE_SCOPE(PROFILE_PAGE_RESET);
+
 
   int16_t x1;
   int16_t y1;
@@ -1257,11 +1445,11 @@ void AEON_Display::pageSetupReset_count_final(int cnt_reset)
   const char* reset = strings.getString(AEON_Strings::EStrings::Reset);
   display.setTextSize(MIDDLE);
   display.getTextBounds(reset, 0, 0, &x1, &y1, &width, &height);
-  display.setCursor((SCREEN_WIDTH - width) / 2, 0);
+  display.setCursor(Panel::centerX(width), 0);
   display.println(reset);
 
   // Second line
-  display.drawLine(0, 20, 128, 20, SSD1306_WHITE); // Line from x0-y20 to x128-y20
+  raster.drawHLine(0, 20, Panel::WIDTH, RASTER_WHITE); // Line from x0-y20 to x128-y20
 
   // Third line
   uint16_t width_first_bundary;
@@ -1286,11 +1474,11 @@ void AEON_Display::pageSetupReset_count_final(int cnt_reset)
   char bufSecoundBoundary[CHAR_BUFFER];
   char bufThirdBoundary[CHAR_BUFFER];
 
-  sprintf(bufFirstBoundary, "%s ", reset);
+  AEON_Format(bufFirstBoundary, sizeof(bufFirstBoundary)).text(reset).character(' ');
 
-  sprintf(bufSecoundBoundary, "%s", "");
+  AEON_Format(bufSecoundBoundary, sizeof(bufSecoundBoundary)).text("");
 
-  sprintf(bufThirdBoundary, "%d", cnt_reset);
+  AEON_Format(bufThirdBoundary, sizeof(bufThirdBoundary)).number(cnt_reset);
 
   // Calc width of the bounds
   display.setTextSize(boundarySize[0]);
@@ -1303,7 +1491,7 @@ void AEON_Display::pageSetupReset_count_final(int cnt_reset)
   display.getTextBounds(bufThirdBoundary, 0, 0, &x1_third_boundary, &y1_third_boundary, &width_third_boundary, &height_third_boundary);
 
   uint16_t complBoundarysWidth = (width_first_bundary + (width_second_bundary + width_third_boundary));
-  uint16_t spaceBoundarysToScreen = (SCREEN_WIDTH - complBoundarysWidth) / 2;
+  uint16_t spaceBoundarysToScreen = Panel::centerX(complBoundarysWidth);
 
   // First boundary
   display.setTextSize(boundarySize[0]);
@@ -1328,6 +1516,8 @@ Back to Base
 */
 void AEON_Display::pageSetupBack()
 {
+  PROFILE_SCOPE(PROFILE_PAGE_BACK);
+
   int16_t x1;
   int16_t y1;
   uint16_t width;
@@ -1341,17 +1531,17 @@ void AEON_Display::pageSetupBack()
   const char *setup = strings.getString(AEON_Strings::EStrings::Setup);
   display.setTextSize(MIDDLE);
   display.getTextBounds(setup, 0, 0, &x1, &y1, &width, &height);
-  display.setCursor((SCREEN_WIDTH - width) / 2, 0);
+  display.setCursor(Panel::centerX(width), 0);
   display.println(setup);
 
   // Second line
-  display.drawLine(0, 20, 128, 20, SSD1306_WHITE); // Line from x0-y20 to x128-y20
+  raster.drawHLine(0, 20, Panel::WIDTH, RASTER_WHITE); // Line from x0-y20 to x128-y20
 
   // Third line
   const char* back = strings.getString(AEON_Strings::EStrings::SetupBack);
   display.setTextSize(SMALL);
   display.getTextBounds(back, 0, 0, &x1, &y1, &width, &height);
-  display.setCursor((SCREEN_WIDTH - width) / 2, 40);
+  display.setCursor(Panel::centerX(width), 40);
   display.println(back);
 
   display.display();
@@ -1360,8 +1550,10 @@ void AEON_Display::pageSetupBack()
 /*
 
 */
-void AEON_Display::pageERROR(char *errorText)
+void AEON_Display::pageERROR(const char *errorText)
 {
+  PROFILE_SCOPE(PROFILE_PAGE_ERROR);
+
   int16_t x1;
   int16_t y1;
   uint16_t width;
@@ -1375,16 +1567,16 @@ void AEON_Display::pageERROR(char *errorText)
   display.setTextSize(MIDDLE);
   const char* error = strings.getString(AEON_Strings::EStrings::Error);
   display.getTextBounds(error, 0, 0, &x1, &y1, &width, &height);
-  display.setCursor((SCREEN_WIDTH - width) / 2, 0);
+  display.setCursor(Panel::centerX(width), 0);
   display.println(error);
 
   // Second line
-  display.drawLine(0, 20, 128, 20, SSD1306_WHITE); // Line from x0-y20 to x128-y20
+  raster.drawHLine(0, 20, Panel::WIDTH, RASTER_WHITE); // Line from x0-y20 to x128-y20
 
   // Third line
   display.setTextSize(SMALL);
   display.getTextBounds(errorText, 0, 0, &x1, &y1, &width, &height);
-  display.setCursor((SCREEN_WIDTH - width) / 2, 40);
+  display.setCursor(Panel::centerX(width), 40);
   display.println(errorText);
 
   display.display();
@@ -22,7 +22,7 @@ private:
   int y_Cursor;
   int x_Cursor;
   int printI;
-  String printStr;
+  const char *printStr;
 
   /*
   00 = EEPROM_RETURN_NULL
@@ -37,6 +37,8 @@ private:
 
  EReturn_DISPLAY lastErrorState; 
 
+  void pageBaseHeader(int year, int month, int day, int dayOfTheWeek, int hour, int minute, int second);
+
 public:
 
   EReturn_DISPLAY setupDisplay();
@@ -47,12 +49,13 @@ public:
   void setTextSize(int i);
   void setCurs(int y, int x);
   void printInt(int i);
-  void printString(String s);
+  void printString(const char *s);
   void drawPixel(int x, int y);
   void resetErrorStateDisplay();
 
   // Pages
   void pageBase(int year, int month, int day, int dayOfTheWeek, int hour, int minute, int second, int lifetime);
+  void pageBaseCountdown(int year, int month, int day, int dayOfTheWeek, int hour, int minute, int second, long lifetime, long countdown, int elapsed);
   void pageSetupTime();
   void pageSetupTime_set_time(EState state, int hour, int minute, int second);
   void pageSetupDate();
@@ -61,6 +64,8 @@ public:
   void pageSetupBirthday_set_date(EState state, int year, int month, int day);
   void pageSetupSex();
   void pageSetupSex_set(ESex sex);
+  void pageSetupCountry();
+  void pageSetupCountry_set(const char *country);
   void pageSetupLifespan();
   void pageSetupLifespan_set(int lifespan);
   void pageSetupLanguage();
@@ -69,7 +74,7 @@ public:
   void pageSetupReset_set(EState state);
   void pageSetupReset_count_final(int cnt_reset);
   void pageSetupBack();
-  void pageERROR(char *errorText);
+  void pageERROR(const char *errorText);
 
   EReturn_DISPLAY getErrorState();
 };
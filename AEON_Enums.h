@@ -18,6 +18,101 @@ enum ERotation
   degrees_270,
 };
 
+enum EBusDevice
+{
+  BUS_DEVICE_DISPLAY, // SSD1306 / SSD1309
+  BUS_DEVICE_RTC,     // DS3231
+  BUS_DEVICE_Count
+};
+
+enum EBusPriority
+{
+  BUS_PRIORITY_LOW,   // Waits for high priority transactions between two chunks
+  BUS_PRIORITY_HIGH
+};
+
+enum EBootPhase
+{
+  BOOT_PHASE_BUS,        // I2C bus started (core 0)
+  BOOT_PHASE_DISPLAY,    // Display controller initialized (core 0)
+  BOOT_PHASE_SPLASH,     // Cached frame or splash on the display (core 0)
+  BOOT_PHASE_ROM,        // EEPROM loaded (core 1)
+  BOOT_PHASE_RTC,        // RTC checked and time read (core 1)
+  BOOT_PHASE_FSM,        // State machine built (core 0)
+  BOOT_PHASE_FIRST_PAGE, // First page with real data on the display (core 0)
+  BOOT_PHASE_Count
+};
+
+enum ELogEvent
+{
+  LOG_TIME,              // Unix time of the RTC, every second
+  LOG_ERROR,             // Error states ROM, time, display
+  LOG_ROM_LOAD,          // Init, birthday year, month, day
+  LOG_ROM_SETTINGS,      // Sex, lifespan female, lifespan male, language
+  LOG_ROM_SAVE,          // Saved to the EEPROM (1 = OK)
+  LOG_ROM_COMMIT_FAILED, // EEPROM commit failed
+  LOG_HEAP,              // Heap grew after setup, bytes
+  LOG_LATENCY,           // Button, edge -> press, press -> frame queued, frame queued -> on the display (us)
+  LOG_Count
+};
+
+enum EProfile
+{
+  PROFILE_LOOP,          // loop() of core 0
+  PROFILE_LOOP_TIME,     // loopTime()
+  PROFILE_LOOP_BUTTON,   // loopButton()
+  PROFILE_LOOP_PAGES,    // loopPages()
+  PROFILE_LOOP_DISPLAY,  // loopDisplay(), chunks of the frame on the bus
+  PROFILE_LOOP_ERROR,    // loopError()
+  PROFILE_DISPLAY,       // display.display(), queue the frame
+  PROFILE_PAGE_BASE,     // Pages, including display.display()
+  PROFILE_PAGE_TIME,
+  PROFILE_PAGE_DATE,
+  PROFILE_PAGE_BIRTHDAY,
+  PROFILE_PAGE_SEX,
+  PROFILE_PAGE_COUNTRY,
+  PROFILE_PAGE_LIFESPAN,
+  PROFILE_PAGE_LANGUAGE,
+  PROFILE_PAGE_RESET,
+  PROFILE_PAGE_BACK,
+  PROFILE_PAGE_ERROR,
+  PROFILE_LATENCY_DEBOUNCE, // Button latency (AEON_Latency.h): edge -> press recognized
+  PROFILE_LATENCY_DISPATCH, // press -> FSM dispatched (transition done)
+  PROFILE_LATENCY_RENDER,   // dispatched -> next frame queued
+  PROFILE_LATENCY_QUEUE,    // frame queued -> flush started
+  PROFILE_LATENCY_FLUSH,    // flush started -> frame on the display
+  PROFILE_LATENCY_TOTAL,    // edge -> frame on the display
+  PROFILE_Count
+};
+
+enum ELatencyStage
+{
+  LATENCY_EDGE,        // First edge on the pin since the button was stable
+  LATENCY_PRESS,       // Debounced, the button reports the press
+  LATENCY_DISPATCHED,  // fsm.dispatch() and the transition are done
+  LATENCY_RENDERED,    // The next frame is queued with display.display()
+  LATENCY_FLUSH_START, // The bus starts to send that frame
+  LATENCY_SHOWN,       // The frame is on the display (sent, or equal to the frame on the display)
+  LATENCY_STAGE_Count
+};
+
+enum ETraceRecord
+{
+  TRACE_START,  // Start of a recording, unix time of the RTC
+  TRACE_ROM,    // 4 bytes of the EEPROM (settings)
+  TRACE_BUTTON, // Edge on a button pin
+  TRACE_RTC,    // Time read from the RTC
+  TRACE_END,    // End of a recording, dropped records
+  TRACE_Count
+};
+
+enum ERasterColor
+{
+  RASTER_BLACK,   // Same values as SSD1306_BLACK,
+  RASTER_WHITE,   // SSD1306_WHITE and
+  RASTER_INVERSE, // SSD1306_INVERSE
+};
+
 enum ETextSize
 {
   TEXT_NULL,
@@ -43,6 +138,8 @@ enum EState
   STATE_Setup_Birthday_Day,       // Setup Birthday Day
   STATE_Setup_Sex,                // Setup Sex
   STATE_Setup_Sex_Set,            // Setup Sex Set
+  STATE_Setup_Country,            // Setup Country
+  STATE_Setup_Country_Set,        // Setup Country Set
   STATE_Setup_Lifespan,           // Setup Lifespan
   STATE_Setup_Lifespan_Set,       // Setup Lifespan Set
   STATE_Setup_Language,           // Setup Language
@@ -84,7 +181,7 @@ enum ESex {
   Male
 };
 
-enum ELanguage {
+enum ELanguage : unsigned char { // Loaded languages follow Count (AEON_Strings.h)
   English,
   German,
   French,
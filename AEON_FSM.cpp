@@ -5,10 +5,6 @@ AEON_FSM.cpp
 
 #include "AEON_FSM.h"
 
-Transition *ALWAYS_FALSE_TRANSITION = new Transition(
-    -1, []{ return false; },
-    NULL, -1);
-
 bool dummy_guard(void)
 {
     return true;
@@ -29,6 +25,22 @@ guard gd(guard g)
     return *g == NULL ? dummy_guard : g;
 }
 
+bool false_guard(void)
+{
+    return false;
+}
+
+/*
+Empty slot of the table, the guard never lets it pass
+*/
+Transition::Transition()
+{
+    this->eventId = -1;
+    this->fnOnTransition = dummy_callback;
+    this->fnGuard = false_guard;
+    this->nextStateId = -1;
+}
+
 Transition::Transition(
     EventId eventId,
     guard fnGuard,
@@ -41,6 +53,15 @@ Transition::Transition(
     this->nextStateId = nextState;
 }
 
+State::State()
+{
+    this->parent = NULL;
+    this->stateId = -1;
+    this->fnOnEnterState = dummy_callback;
+    this->fnOnExitState = dummy_callback;
+    this->fnOnStayInState = dummy_callback;
+}
+
 State::State(
     FSM *parent,
     StateId stateId,
@@ -63,7 +84,14 @@ State *State::addTransition(
     StateId nextState)
 {
 
-    this->transitions[eventId] = new Transition(eventId, fnGuard, fnOnTransition, nextState);
+    if (eventId >= 0 && eventId < AEON_FSM_EVENTS)
+    {
+        this->transitions[eventId] = Transition(eventId, fnGuard, fnOnTransition, nextState);
+    }
+    else if (this->parent != NULL)
+    {
+        this->parent->rejected++;
+    }
 
     return this;
 }
@@ -73,15 +101,34 @@ FSM *State::end()
     return this->parent;
 }
 
+FSM::FSM()
+{
+    this->currentStateId = -1;
+    this->rejected = 0;
+    this->stateNames = NULL;
+    this->stateNameCount = 0;
+    this->eventNames = NULL;
+    this->eventNameCount = 0;
+}
+
 State *FSM::addState(
     StateId stateId,
     callback fnOnEnterState,
     callback fnOnExitState,
     callback fnOnStayInState)
 {
-    this->states[stateId] = new State(this, stateId, fnOnEnterState, fnOnExitState, fnOnStayInState);
+    State *state = &this->spare;
+    if (stateId >= 0 && stateId < AEON_FSM_STATES)
+    {
+        state = &this->states[stateId];
+    }
+    else
+    {
+        this->rejected++;
+    }
+    *state = State(this, stateId, fnOnEnterState, fnOnExitState, fnOnStayInState);
 
-    return this->states[stateId];
+    return state;
 }
 
 void FSM::setCurrentStateId(StateId initialState)
@@ -96,10 +143,13 @@ StateId FSM::getCurrentStateId(void)
 
 bool FSM::dispatch(EventId e)
 {
-    State *currentState = this->states[this->currentStateId];
+    if (this->currentStateId < 0 || this->currentStateId >= AEON_FSM_STATES || e < 0 || e >= AEON_FSM_EVENTS)
+    {
+        return false;
+    }
 
-    Transition *currentTransition = currentState->transitions[e];
-    currentTransition = currentTransition == NULL ? ALWAYS_FALSE_TRANSITION : currentTransition;
+    State *currentState = &this->states[this->currentStateId];
+    Transition *currentTransition = &currentState->transitions[e];
 
     if (!currentTransition->fnGuard())
     {
@@ -113,9 +163,72 @@ bool FSM::dispatch(EventId e)
 
     this->setCurrentStateId(currentTransition->nextStateId);
 
-    currentState = this->states[this->currentStateId];
-
-    currentState->fnOnEnterState();
+    if (this->currentStateId >= 0 && this->currentStateId < AEON_FSM_STATES)
+    {
+        currentState = &this->states[this->currentStateId];
+        currentState->fnOnEnterState();
+    }
 
     return true;
-}
\ No newline at end of file
+}
+
+/*
+State added with addState()
+*/
+bool FSM::hasState(StateId stateId)
+{
+    return stateId >= 0 && stateId < AEON_FSM_STATES && this->states[stateId].stateId == stateId;
+}
+
+/*
+Transition added with addTransition(), without one the event leaves the state as it is
+*/
+bool FSM::hasTransition(StateId stateId, EventId eventId)
+{
+    return this->hasState(stateId) && eventId >= 0 && eventId < AEON_FSM_EVENTS && this->states[stateId].transitions[eventId].eventId == eventId;
+}
+
+/*
+The transition depends on a guard, getNextStateId() is only where it leads when the guard lets it pass
+*/
+bool FSM::hasGuard(StateId stateId, EventId eventId)
+{
+    return this->hasTransition(stateId, eventId) && this->states[stateId].transitions[eventId].fnGuard != dummy_guard;
+}
+
+/*
+-1 without a transition
+*/
+StateId FSM::getNextStateId(StateId stateId, EventId eventId)
+{
+    return this->hasTransition(stateId, eventId) ? this->states[stateId].transitions[eventId].nextStateId : -1;
+}
+
+/*
+Ids of addState() and addTransition() outside of AEON_FSM_STATES and AEON_FSM_EVENTS, nothing of them is stored
+*/
+int FSM::getRejected()
+{
+    return this->rejected;
+}
+
+/*
+Tables of names, the index is the id. The tables are not copied.
+*/
+void FSM::setNames(const char *const *stateNames, int stateCount, const char *const *eventNames, int eventCount)
+{
+    this->stateNames = stateNames;
+    this->stateNameCount = stateCount;
+    this->eventNames = eventNames;
+    this->eventNameCount = eventCount;
+}
+
+const char *FSM::getStateName(StateId stateId)
+{
+    return (stateId >= 0 && stateId < this->stateNameCount) ? this->stateNames[stateId] : "?";
+}
+
+const char *FSM::getEventName(EventId eventId)
+{
+    return (eventId >= 0 && eventId < this->eventNameCount) ? this->eventNames[eventId] : "?";
+}
@@ -1,11 +1,15 @@
 /*
 AEON_FSM.h
+States and transitions live in fixed tables of the FSM (AEON_FSM_STATES states with AEON_FSM_EVENTS
+transitions each, see AEON_Config.h), the state id and the event id are the index. Nothing is allocated.
+The tables can be read back (hasState, hasTransition, getNextStateId), the host build checks the menu
+graph with it (extras/host, aeon_fsm). An id outside of the tables is not stored and counted (getRejected). setNames() gives the ids names for logs, benchmarks and tools.
 */
 
 #include <Arduino.h>
 #include <stdlib.h>
-#include <map>
 #include <string.h>
+#include "AEON_Config.h"
 
 typedef int EventId;
 
@@ -26,6 +30,7 @@ private:
     StateId nextStateId;
 
 public:
+    Transition();
     Transition(
         EventId eventId,
         guard fnGuard,
@@ -46,9 +51,10 @@ private:
     callback fnOnExitState;
     callback fnOnStayInState;
 
-    std::map<EventId, Transition *> transitions{};
+    Transition transitions[AEON_FSM_EVENTS]; // Index = EventId
 
 public:
+    State();
     State(
         FSM *parent,
         StateId stateId,
@@ -67,12 +73,22 @@ public:
 
 class FSM
 {
+    friend class State;
 
 private:
-    std::map<StateId, State *> states;
+    State states[AEON_FSM_STATES]; // Index = StateId
+    State spare;                   // Takes states with an id outside of the table
+    int rejected;                  // States and transitions with an id outside of the tables
     StateId currentStateId;
 
+    const char *const *stateNames;
+    int stateNameCount;
+    const char *const *eventNames;
+    int eventNameCount;
+
 public:
+    FSM();
+
     State *addState(
         StateId stateId,
         callback fnOnEnterState,
@@ -84,4 +100,15 @@ public:
 
     // zustand wurde gewechselt
     bool dispatch(EventId e);
+
+    // Tables, read only
+    bool hasState(StateId stateId);
+    bool hasTransition(StateId stateId, EventId eventId);
+    bool hasGuard(StateId stateId, EventId eventId);
+    StateId getNextStateId(StateId stateId, EventId eventId);
+    int getRejected();
+
+    void setNames(const char *const *stateNames, int stateCount, const char *const *eventNames, int eventCount);
+    const char *getStateName(StateId stateId);
+    const char *getEventName(EventId eventId);
 };
\ No newline at end of file
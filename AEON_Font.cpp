@@ -0,0 +1,151 @@
+/*
+AEON_Font.cpp
+*/
+
+#include "AEON_Font.h"
+#include "AEON_FontGlyphs.h"
+
+// Glyphs of the loaded language pack, in the flash
+static const SFONT_GLYPH *packGlyphs = NULL;
+static uint8_t packGlyphCount = 0;
+
+AEON_Font::AEON_Font()
+{
+  this->character = 0;
+  this->pending = 0;
+}
+
+/*
+Feed one byte of UTF-8
+*/
+bool AEON_Font::decode(uint8_t byte, uint32_t *decoded)
+{
+  if (this->pending > 0)
+  {
+    if ((byte & 0xC0) == 0x80)
+    {
+      this->character = (this->character << 6) | (byte & 0x3F);
+      if (--this->pending == 0)
+      {
+        *decoded = this->character;
+        return true;
+      }
+      return false;
+    }
+
+    // Sequence broken off, the byte starts the next character
+    this->pending = 0;
+  }
+
+  if (byte < 0x80)
+  {
+    *decoded = byte;
+    return true;
+  }
+  if ((byte & 0xE0) == 0xC0)
+  {
+    this->character = byte & 0x1F;
+    this->pending = 1;
+  }
+  else if ((byte & 0xF0) == 0xE0)
+  {
+    this->character = byte & 0x0F;
+    this->pending = 2;
+  }
+  else if ((byte & 0xF8) == 0xF0)
+  {
+    this->character = byte & 0x07;
+    this->pending = 3;
+  }
+  else
+  {
+    *decoded = FONT_REPLACEMENT;
+    return true;
+  }
+  return false;
+}
+
+/*
+Decode one character and move the string behind it
+*/
+uint32_t AEON_Font::next(const char **text)
+{
+  AEON_Font decoder;
+  uint32_t decoded;
+
+  while (**text)
+  {
+    if (decoder.decode((uint8_t)*(*text)++, &decoded))
+    {
+      return decoded;
+    }
+  }
+  return 0;
+}
+
+/*
+Characters of an UTF-8 text, not its bytes
+*/
+size_t AEON_Font::length(const char *text)
+{
+  size_t characters = 0;
+  while (next(&text))
+  {
+    characters++;
+  }
+  return characters;
+}
+
+/*
+One index into the flat table of the subset
+*/
+const uint8_t *AEON_Font::getGlyph(uint32_t character)
+{
+  if (character >= FONT_FIRST && character < FONT_FIRST + FONT_SPAN)
+  {
+    uint8_t index = fontIndex[character - FONT_FIRST];
+    if (index)
+    {
+      return fontGlyphs[index - 1];
+    }
+  }
+
+  // Glyphs of the pack
+  int low = 0;
+  int high = (int)packGlyphCount - 1;
+  while (low <= high)
+  {
+    int middle = (low + high) / 2;
+    if (packGlyphs[middle].character == character)
+    {
+      return packGlyphs[middle].columns;
+    }
+    if (packGlyphs[middle].character < character)
+    {
+      low = middle + 1;
+    }
+    else
+    {
+      high = middle - 1;
+    }
+  }
+  return NULL;
+}
+
+/*
+Glyphs in AEON_FontGlyphs.h
+*/
+uint8_t AEON_Font::getGlyphCount()
+{
+  return sizeof(fontGlyphs) / sizeof(fontGlyphs[0]);
+}
+
+/*
+Called when the language changes, with 0 glyphs for a built-in language
+*/
+void AEON_Font::setPackGlyphs(const SFONT_GLYPH *glyphs, uint8_t count)
+{
+  packGlyphCount = 0;
+  packGlyphs = glyphs;
+  packGlyphCount = glyphs ? count : 0;
+}
@@ -0,0 +1,50 @@
+/*
+AEON_Font.h - UTF-8 text with the classic 5x7 font of Adafruit GFX.
+
+The string packs are UTF-8. ASCII is drawn by Adafruit GFX, every other character the packs use has a
+glyph in the same format (5 columns, bit 0 at the top, one empty column after it) in AEON_FontGlyphs.h.
+The subset is generated from the string packs by aeon_fontgen (extras/host), so the font holds only the
+glyphs that are used. A character finds its glyph with one index into a flat table over the range of
+the subset.
+
+A loaded language pack (AEON_Strings.h) brings the glyphs of its characters that are not in the subset,
+setPackGlyphs() adds them, they are found by a binary search.
+
+Text is decoded byte by byte while it is drawn (decode()), nothing is allocated. A character without a
+glyph and an invalid byte are drawn as '?', an incomplete sequence is dropped.
+*/
+
+#ifndef AEON_FONT_h
+#define AEON_FONT_h
+
+#include <Arduino.h>
+
+#define FONT_REPLACEMENT 0xFFFD // Invalid byte
+
+typedef struct
+{
+  uint16_t character;
+  uint8_t columns[5];
+  uint8_t reserved;
+} SFONT_GLYPH;
+
+class AEON_Font
+{
+private:
+  uint32_t character; // Character being decoded
+  uint8_t pending;    // Continuation bytes still missing
+
+public:
+  AEON_Font();
+
+  bool decode(uint8_t byte, uint32_t *decoded); // true when a character is complete
+
+  static uint32_t next(const char **text); // Next character of a string, 0 at the end
+  static size_t length(const char *text);  // Characters of a string
+
+  static const uint8_t *getGlyph(uint32_t character); // 5 columns, NULL for ASCII and missing glyphs
+  static uint8_t getGlyphCount();
+  static void setPackGlyphs(const SFONT_GLYPH *glyphs, uint8_t count); // Sorted by character
+};
+
+#endif
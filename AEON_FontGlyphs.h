@@ -0,0 +1,32 @@
+/*
+AEON_FontGlyphs.h - Glyphs of AEON_Font for the characters of the string packs above ASCII.
+Generated by aeon_fontgen (extras/host) from AEON_Strings.cpp, do not edit.
+*/
+
+#ifndef AEON_FONT_GLYPHS_h
+#define AEON_FONT_GLYPHS_h
+
+#define FONT_FIRST 0xCD
+#define FONT_SPAN 48
+
+static const uint8_t fontGlyphs[][5] = {
+    {0x00, 0x44, 0x7E, 0x45, 0x00}, // U+00CD Í
+    {0x20, 0x54, 0x56, 0x79, 0x40}, // U+00E1 á
+    {0x20, 0x55, 0x54, 0x79, 0x40}, // U+00E4 ä
+    {0x38, 0x44, 0xC4, 0x44, 0x28}, // U+00E7 ç
+    {0x38, 0x54, 0x56, 0x55, 0x18}, // U+00E9 é
+    {0x00, 0x44, 0x7E, 0x41, 0x00}, // U+00ED í
+    {0x7E, 0x09, 0x05, 0x06, 0x79}, // U+00F1 ñ
+    {0x38, 0x45, 0x44, 0x45, 0x38}, // U+00F6 ö
+    {0x3C, 0x42, 0x41, 0x22, 0x7C}, // U+00FB û
+    {0x3C, 0x41, 0x40, 0x21, 0x7C}, // U+00FC ü
+};
+
+// Glyph + 1 of FONT_FIRST + i, 0 = no glyph
+static const uint8_t fontIndex[FONT_SPAN] = {
+    1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 2, 0, 0, 3, 0, 0, 4, 0, 5, 0, 0, 0,
+    6, 0, 0, 0, 7, 0, 0, 0, 0, 8, 0, 0, 0, 0, 9, 10,
+};
+
+#endif
@@ -0,0 +1,163 @@
+/*
+AEON_Format.cpp
+*/
+
+#include <Arduino.h>
+#include "AEON_Format.h"
+
+const char AEON_Format::DIGITS[200] = {
+    '0', '0', '0', '1', '0', '2', '0', '3', '0', '4', '0', '5', '0', '6', '0', '7', '0', '8', '0', '9',
+    '1', '0', '1', '1', '1', '2', '1', '3', '1', '4', '1', '5', '1', '6', '1', '7', '1', '8', '1', '9',
+    '2', '0', '2', '1', '2', '2', '2', '3', '2', '4', '2', '5', '2', '6', '2', '7', '2', '8', '2', '9',
+    '3', '0', '3', '1', '3', '2', '3', '3', '3', '4', '3', '5', '3', '6', '3', '7', '3', '8', '3', '9',
+    '4', '0', '4', '1', '4', '2', '4', '3', '4', '4', '4', '5', '4', '6', '4', '7', '4', '8', '4', '9',
+    '5', '0', '5', '1', '5', '2', '5', '3', '5', '4', '5', '5', '5', '6', '5', '7', '5', '8', '5', '9',
+    '6', '0', '6', '1', '6', '2', '6', '3', '6', '4', '6', '5', '6', '6', '6', '7', '6', '8', '6', '9',
+    '7', '0', '7', '1', '7', '2', '7', '3', '7', '4', '7', '5', '7', '6', '7', '7', '7', '8', '7', '9',
+    '8', '0', '8', '1', '8', '2', '8', '3', '8', '4', '8', '5', '8', '6', '8', '7', '8', '8', '8', '9',
+    '9', '0', '9', '1', '9', '2', '9', '3', '9', '4', '9', '5', '9', '6', '9', '7', '9', '8', '9', '9'};
+
+/*
+Digits of the value in reverse order, returns the count
+*/
+static uint8_t reverseDigits(unsigned long value, char *digits)
+{
+  uint8_t count = 0;
+
+  while (value >= 100)
+  {
+    const char *pair = &AEON_Format::DIGITS[(value % 100) * 2];
+    value /= 100;
+    digits[count++] = pair[1];
+    digits[count++] = pair[0];
+  }
+
+  if (value >= 10)
+  {
+    const char *pair = &AEON_Format::DIGITS[value * 2];
+    digits[count++] = pair[1];
+    digits[count++] = pair[0];
+  }
+  else
+  {
+    digits[count++] = (char)('0' + value);
+  }
+
+  return count;
+}
+
+AEON_Format::AEON_Format(char *buffer, size_t size)
+{
+  this->buffer = buffer;
+  this->size = size;
+  this->position = 0;
+
+  if (size > 0)
+  {
+    buffer[0] = '\0';
+  }
+}
+
+/*
+Append one char, nothing happens if the buffer is full
+*/
+AEON_Format &AEON_Format::character(char c)
+{
+  if (this->position + 1 < this->size)
+  {
+    this->buffer[this->position++] = c;
+    this->buffer[this->position] = '\0';
+  }
+  return *this;
+}
+
+/*
+Append a string ("%s")
+*/
+AEON_Format &AEON_Format::text(const char *s)
+{
+  while (*s != '\0' && this->position + 1 < this->size)
+  {
+    this->buffer[this->position++] = *s++;
+  }
+
+  if (this->size > 0)
+  {
+    this->buffer[this->position] = '\0';
+  }
+  return *this;
+}
+
+/*
+Append a decimal number, the width counts the sign like printf
+*/
+AEON_Format &AEON_Format::number(long value, uint8_t width, char pad, bool sign)
+{
+  char digits[AEON_Format::digitCount(~0UL)];
+  bool negative = value < 0;
+  unsigned long magnitude = negative ? 0UL - (unsigned long)value : (unsigned long)value;
+  char signChar = negative ? '-' : (sign ? '+' : '\0');
+
+  uint8_t count = reverseDigits(magnitude, digits);
+  int padding = (int)width - count - (signChar != '\0' ? 1 : 0);
+
+  if (pad == '0')
+  {
+    if (signChar != '\0')
+    {
+      character(signChar);
+    }
+    for (; padding > 0; padding--)
+    {
+      character('0');
+    }
+  }
+  else
+  {
+    for (; padding > 0; padding--)
+    {
+      character(pad);
+    }
+    if (signChar != '\0')
+    {
+      character(signChar);
+    }
+  }
+
+  while (count > 0)
+  {
+    character(digits[--count]);
+  }
+  return *this;
+}
+
+/*
+Append a decimal number with a separator between the thousands (12345 -> "12,345"), zero padded to the
+width like "%02ld". The separator '\0' leaves the digits ungrouped.
+*/
+AEON_Format &AEON_Format::grouped(long value, char separator, uint8_t width)
+{
+  char digits[AEON_Format::digitCount(~0UL)];
+  bool negative = value < 0;
+  unsigned long magnitude = negative ? 0UL - (unsigned long)value : (unsigned long)value;
+
+  uint8_t count = reverseDigits(magnitude, digits);
+  int padding = (int)width - count - (negative ? 1 : 0);
+  int total = padding > 0 ? count + padding : count; // The zeros of the padding are grouped as well
+
+  if (negative)
+  {
+    character('-');
+  }
+
+  while (total > 0)
+  {
+    total--;
+    character(total < count ? digits[total] : '0');
+    if (separator != '\0' && total > 0 && (total % 3) == 0)
+    {
+      character(separator);
+    }
+  }
+  return *this;
+}
@@ -0,0 +1,46 @@
+/*
+AEON_Format.h - Formats text and numbers straight into a buffer of the caller, without printf and without heap.
+The calls can be chained like the transitions of the FSM, the buffer is always terminated and the text
+is cut at the end of the buffer like with snprintf:
+
+  char buf[CHAR_BUFFER];
+  AEON_Format(buf, sizeof(buf)).number(hour, 2).character(':').number(minute, 2); // "%02d:%02d"
+
+number() converts two digits per step with a lookup table. A width pads like printf, with '0' after the
+sign ("%02d") or with ' ' before it ("%4d"), sign puts a '+' before positive values ("%+03d"). grouped()
+puts a thousands separator between groups of three, the separator comes from the language
+(AEON_Strings::getThousandsSeparator()), '\0' groups nothing. Its width pads with '0' like number().
+extras/host/aeon_format checks both against snprintf.
+*/
+
+#ifndef AEON_FORMAT_h
+#define AEON_FORMAT_h
+
+#include <Arduino.h>
+
+class AEON_Format
+{
+private:
+  char *buffer;
+  size_t size;
+  size_t position;
+
+public:
+  // "00" "01" ... "99"
+  static const char DIGITS[200];
+
+  // Decimal digits of a value without sign
+  static constexpr uint8_t digitCount(unsigned long value) { return value < 10 ? 1 : 1 + digitCount(value / 10); }
+
+  AEON_Format(char *buffer, size_t size);
+
+  AEON_Format &character(char c);
+  AEON_Format &text(const char *s);
+  AEON_Format &number(long value, uint8_t width = 0, char pad = '0', bool sign = false);
+  AEON_Format &grouped(long value, char separator, uint8_t width = 0);
+
+  const char *c_str() { return buffer; }
+  size_t length() { return position; }
+};
+
+#endif
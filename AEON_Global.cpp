@@ -1,10 +1,7 @@
 /* 
 AEON_Global.cpp
-
-Lifespan based on The World Factbook - https://www.cia.gov/the-world-factbook/
 */
 
-#include <map>
 #include "AEON_Global.h"
 #include "AEON_Enums.h"
 
@@ -24,18 +21,10 @@ int GLOBAL_DEFAULTS::defaultBirthdayDay     = 1;
 ESex GLOBAL_DEFAULTS::defaultSex            = ESex::Female;
 ELanguage GLOBAL_DEFAULTS::defaultLanguage  = ELanguage::English;
 
-// Initialising the default Lifespan Female
-std::map<ELanguage, int> GLOBAL_DEFAULTS::defaultLifespanFemale = {
-    {ELanguage::English, 82}, // Europe Union
-    {ELanguage::German, 83},  // Germany
-    {ELanguage::French, 85},  // French Worldwide
-    {ELanguage::Spain, 85},   // Spain Worldwide
-};
-
-// Initialising the default Lifespan Male
-std::map<ELanguage, int> GLOBAL_DEFAULTS::defaultLifespanMale = {
-    {ELanguage::English, 77}, // Europe Union
-    {ELanguage::German, 78},  // Germany
-    {ELanguage::French, 79},  // French Worldwide
-    {ELanguage::Spain, 79},   // Spain Worldwide
+// Country of a new ROM for every language
+const char GLOBAL_DEFAULTS::defaultCountry[ELanguage::Count][3] = {
+    "EU", // English - Europe Union
+    "DE", // German  - Germany
+    "FR", // French  - French Worldwide
+    "ES", // Spain   - Spain Worldwide
 };
\ No newline at end of file
@@ -5,7 +5,6 @@ AEON_Global.h
 #ifndef AEON_GLOBAL_h
 #define AEON_GLOBAL_h
 
-#include <map>
 #include <Arduino.h>
 #include "AEON_Enums.h"
 
@@ -24,8 +23,7 @@ struct GLOBAL_DEFAULTS
     static int defaultBirthdayMonth;
     static int defaultBirthdayDay;
     static ESex defaultSex;
-    static std::map<ELanguage, int> defaultLifespanFemale;
-    static std::map<ELanguage, int> defaultLifespanMale;
+    static const char defaultCountry[ELanguage::Count][3]; // Index = ELanguage, lifespans in AEON_Lifespan.h
     static ELanguage defaultLanguage;
 };
 
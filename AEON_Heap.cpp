@@ -0,0 +1,106 @@
+/*
+AEON_Heap.cpp
+*/
+
+#include <Arduino.h>
+#include <malloc.h>
+#include "AEON_Config.h"
+#include "AEON_Heap.h"
+#include "AEON_Log.h"
+
+extern AEON_Log logger;
+
+// Provided by the host build, see AEON_Heap.h
+extern "C" uint32_t aeon_allocation_count(void) __attribute__((weak));
+
+AEON_Heap::AEON_Heap()
+{
+  this->locked = false;
+  this->baseline = 0;
+  this->peak = 0;
+  this->violations = 0;
+}
+
+/*
+The boot is finished, from now on the heap must not grow
+*/
+void AEON_Heap::lock()
+{
+#if AEON_ZERO_HEAP
+  this->baseline = getUsed();
+  this->peak = this->baseline;
+  this->locked = true;
+#endif
+}
+
+/*
+Report when the heap grew since the last check
+*/
+void AEON_Heap::check()
+{
+#if AEON_ZERO_HEAP
+  if (!this->locked)
+  {
+    return;
+  }
+
+  size_t used = getUsed();
+  if (used > this->peak)
+  {
+    this->peak = used;
+    this->violations++;
+
+    logger.write(LOG_HEAP, (int32_t)(used - this->baseline));
+  }
+#endif
+}
+
+/*
+Bytes allocated on the heap
+*/
+size_t AEON_Heap::getUsed()
+{
+  struct mallinfo info = mallinfo();
+  return info.uordblks;
+}
+
+/*
+The heap does not give memory back to the system
+*/
+size_t AEON_Heap::getReserved()
+{
+  struct mallinfo info = mallinfo();
+  return info.arena;
+}
+
+/*
+Bytes the heap grew over the end of setup() at its peak
+*/
+size_t AEON_Heap::getGrowth()
+{
+  return this->peak - this->baseline;
+}
+
+/*
+Times the heap grew after the end of setup()
+*/
+uint32_t AEON_Heap::getViolations()
+{
+  return this->violations;
+}
+
+/*
+The host build counts every allocation (aeon_allocation_count)
+*/
+bool AEON_Heap::countsAllocations()
+{
+  return aeon_allocation_count != NULL;
+}
+
+/*
+Calls of malloc, calloc and realloc since the start, 0 if they are not counted
+*/
+uint32_t AEON_Heap::getAllocations()
+{
+  return countsAllocations() ? aeon_allocation_count() : 0;
+}
@@ -0,0 +1,42 @@
+/*
+AEON_Heap.h - The class watches the heap in zero heap mode (AEON_ZERO_HEAP in AEON_Config.h).
+All buffers of the firmware are static: the frame buffer of the display, the tables of the state machine,
+the lifespan tables and the text buffers. lock() notes the bytes in use when the boot is finished, check()
+compares them every second and logs every growth (LOG_HEAP), with the total growth since the boot.
+The allocator of the core is already wrapped by arduino-pico, so the check reads the bytes in use from
+mallinfo() instead of wrapping malloc and new at link time. Every malloc, new and String is seen by it.
+
+The number of allocations is only known where the platform counts them: the host build (extras/host)
+wraps malloc and provides aeon_allocation_count(), on the RP2040 countsAllocations() is false.
+*/
+
+#ifndef AEON_HEAP_h
+#define AEON_HEAP_h
+
+#include <Arduino.h>
+#include "AEON_Config.h"
+
+class AEON_Heap
+{
+private:
+  bool locked;
+  size_t baseline;    // Bytes in use at lock()
+  size_t peak;        // Most bytes in use since lock()
+  uint32_t violations; // Checks that found more bytes in use
+
+public:
+  AEON_Heap();
+
+  void lock();
+  void check();
+
+  size_t getUsed();
+  size_t getReserved(); // Bytes the heap took from the system, its high-water mark
+  size_t getGrowth();
+  uint32_t getViolations();
+
+  bool countsAllocations();
+  uint32_t getAllocations();
+};
+
+#endif
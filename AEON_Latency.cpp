@@ -0,0 +1,173 @@
+/*
+AEON_Latency.cpp
+*/
+
+#include <Arduino.h>
+#include "AEON_Config.h"
+#include "AEON_Enums.h"
+#include "AEON_Latency.h"
+#include "AEON_Profiler.h"
+#include "AEON_Log.h"
+
+extern AEON_Log logger;
+
+AEON_Latency::AEON_Latency()
+{
+  this->active = false;
+  this->button = 0;
+  this->reached = 0;
+  for (int i = 0; i < LATENCY_STAGE_Count; i++)
+  {
+    this->stages[i] = 0;
+  }
+  this->completed = 0;
+  this->replaced = 0;
+}
+
+/*
+micros() of a stage of the press
+*/
+void AEON_Latency::mark(ELatencyStage stage)
+{
+  this->stages[stage] = micros();
+  this->reached |= (1 << stage);
+}
+
+/*
+The stage is marked for the press
+*/
+bool AEON_Latency::hasReached(ELatencyStage stage)
+{
+  return this->reached & (1 << stage);
+}
+
+/*
+The button reports a press, the edge was seen before the debounce time
+*/
+void AEON_Latency::press(uint8_t button, unsigned long edgeTime)
+{
+  if (this->active)
+  {
+    this->replaced++;
+  }
+
+  this->active = true;
+  this->button = button;
+  this->reached = 0;
+  this->stages[LATENCY_EDGE] = edgeTime;
+  this->reached |= (1 << LATENCY_EDGE);
+  mark(LATENCY_PRESS);
+}
+
+/*
+The FSM got the event of the press
+*/
+void AEON_Latency::dispatched()
+{
+  if (this->active && !hasReached(LATENCY_DISPATCHED))
+  {
+    mark(LATENCY_DISPATCHED);
+  }
+}
+
+/*
+A frame is queued, the first one after the press shows the result. A transition that draws its page
+queues the frame inside of the dispatch, the dispatch ends with it.
+*/
+void AEON_Latency::frameSubmitted()
+{
+  if (this->active && !hasReached(LATENCY_RENDERED))
+  {
+    if (!hasReached(LATENCY_DISPATCHED))
+    {
+      mark(LATENCY_DISPATCHED);
+    }
+    mark(LATENCY_RENDERED);
+  }
+}
+
+/*
+The bus takes the latest queued frame, a flush that started before the render does not count
+*/
+void AEON_Latency::flushStarted()
+{
+  if (this->active && hasReached(LATENCY_RENDERED) && !hasReached(LATENCY_FLUSH_START))
+  {
+    mark(LATENCY_FLUSH_START);
+  }
+}
+
+/*
+The display shows the frame of the press, the measurement is done
+*/
+void AEON_Latency::frameShown()
+{
+  if (this->active && hasReached(LATENCY_FLUSH_START))
+  {
+    mark(LATENCY_SHOWN);
+    finish();
+  }
+}
+
+/*
+Add the stages to the histograms and log them
+*/
+void AEON_Latency::finish()
+{
+  static const EProfile probes[LATENCY_STAGE_Count - 1] = {PROFILE_LATENCY_DEBOUNCE, PROFILE_LATENCY_DISPATCH, PROFILE_LATENCY_RENDER, PROFILE_LATENCY_QUEUE, PROFILE_LATENCY_FLUSH};
+  uint32_t cyclesPerMicro = rp2040.f_cpu() / 1000000;
+
+  for (int i = 0; i < LATENCY_STAGE_Count - 1; i++)
+  {
+    profiler.record(probes[i], (this->stages[i + 1] - this->stages[i]) * cyclesPerMicro);
+  }
+  profiler.record(PROFILE_LATENCY_TOTAL, (this->stages[LATENCY_SHOWN] - this->stages[LATENCY_EDGE]) * cyclesPerMicro);
+
+  logger.write(LOG_LATENCY, this->button,
+               this->stages[LATENCY_PRESS] - this->stages[LATENCY_EDGE],
+               this->stages[LATENCY_RENDERED] - this->stages[LATENCY_PRESS],
+               this->stages[LATENCY_SHOWN] - this->stages[LATENCY_RENDERED]);
+
+  this->active = false;
+  this->completed++;
+}
+
+/*
+A press is on the way to the display
+*/
+bool AEON_Latency::isActive()
+{
+  return this->active;
+}
+
+/*
+Button of the last measurement
+*/
+uint8_t AEON_Latency::getButton()
+{
+  return this->button;
+}
+
+/*
+Timestamp of a stage of the last measurement (micros)
+*/
+unsigned long AEON_Latency::getStage(ELatencyStage stage)
+{
+  return this->stages[stage];
+}
+
+/*
+Presses measured up to the display
+*/
+uint32_t AEON_Latency::getCompleted()
+{
+  return this->completed;
+}
+
+/*
+Presses dropped because the next press came before their frame
+*/
+uint32_t AEON_Latency::getReplaced()
+{
+  return this->replaced;
+}
@@ -0,0 +1,59 @@
+/*
+AEON_Latency.h - Button to photon latency: the time from the edge on a button pin until the frame that
+shows the result is on the display. A press is followed through the stages of ELatencyStage, every stage
+gets a timestamp (micros). The button, the loop and the bus report the stages:
+
+  edge (AEON_Button) -> press (loopButton) -> dispatched (loopButton) -> rendered (bus.submitFrame)
+  -> flush start (bus, first flush after the render) -> shown (bus, frame complete or equal)
+
+When the frame is shown the stage times go into the PROFILE_LATENCY_* histograms of the profiler ("profile"
+on Serial) and a LOG_LATENCY record. A press during a running measurement replaces it.
+With AEON_PROFILER 0 nothing is measured.
+*/
+
+#ifndef AEON_LATENCY_h
+#define AEON_LATENCY_h
+
+#include <Arduino.h>
+#include "AEON_Config.h"
+#include "AEON_Enums.h"
+
+class AEON_Latency
+{
+private:
+  bool active;
+  uint8_t button;
+  uint8_t reached; // Bit per stage
+  unsigned long stages[LATENCY_STAGE_Count];
+  uint32_t completed;
+  uint32_t replaced;
+
+  void mark(ELatencyStage stage);
+  bool hasReached(ELatencyStage stage);
+  void finish();
+
+public:
+  AEON_Latency();
+
+  void press(uint8_t button, unsigned long edgeTime);
+  void dispatched();
+  void frameSubmitted();
+  void flushStarted();
+  void frameShown();
+
+  bool isActive();
+  uint8_t getButton();
+  unsigned long getStage(ELatencyStage stage);
+  uint32_t getCompleted();
+  uint32_t getReplaced();
+};
+
+extern AEON_Latency latency;
+
+#if AEON_PROFILER
+#define LATENCY(call) latency.call
+#else
+#define LATENCY(call)
+#endif
+
+#endif
@@ -0,0 +1,225 @@
+/*
+AEON_LifeTable.cpp
+*/
+
+#include "AEON_LifeTable.h"
+#include "AEON_Lifespan.h"
+#include "AEON_LifeTables.h"
+
+#if AEON_LIFE_TABLES && LIFE_TABLES_PLACEHOLDER
+#error "AEON_LifeTables.h holds placeholder tables, generate it from published life tables (extras/lifetables) or set AEON_LIFE_TABLES 0"
+#endif
+
+#define LIFE_TABLE_COUNT (sizeof(lifeTables) / sizeof(lifeTables[0]))
+#define DAYS_PER_400_YEARS 146097L // Gregorian calendar, 365.2425 days a year
+#define LIFE_TABLE_HALF_YEAR 15778476ULL // Seconds, DAYS_PER_400_YEARS * LIFE_TABLE_DAY / 800
+
+AEON_LifeTable::AEON_LifeTable()
+{
+  this->tables = AEON_LIFE_TABLES ? lifeTables : NULL;
+  this->tableCount = AEON_LIFE_TABLES ? LIFE_TABLE_COUNT : 0;
+  this->valid = false;
+}
+
+AEON_LifeTable::AEON_LifeTable(const SLIFE_TABLE *tables, uint8_t count)
+{
+  this->tables = tables;
+  this->tableCount = count;
+  this->valid = false;
+}
+
+/*
+Calculated again when the date or a setting changed, otherwise the last result
+*/
+long AEON_LifeTable::getRemainingDays(int year, int month, int day, int birthYear, int birthMonth, int birthDay, const char *country, ESex sex, int lifespan)
+{
+  int code = AEON_Lifespan::code(country);
+  if (this->valid && this->day == day && this->month == month && this->year == year && this->birthDay == birthDay &&
+      this->birthMonth == birthMonth && this->birthYear == birthYear && this->country == code && this->sex == sex &&
+      this->lifespan == lifespan)
+  {
+    return this->remainingDays;
+  }
+
+  this->valid = true;
+  this->year = year;
+  this->month = month;
+  this->day = day;
+  this->birthYear = birthYear;
+  this->birthMonth = birthMonth;
+  this->birthDay = birthDay;
+  this->country = code;
+  this->sex = sex;
+  this->lifespan = lifespan;
+
+  long age = getDayNumber(year, month, day) - getDayNumber(birthYear, birthMonth + 1, birthDay);
+  int64_t lifespanSeconds = (int64_t)lifespan * DAYS_PER_400_YEARS * LIFE_TABLE_DAY / 400;
+  const SLIFE_TABLE *table = find(country);
+
+  int64_t remaining;
+  this->lived = (int64_t)age * LIFE_TABLE_DAY;
+  if (table == NULL || age < 0)
+  {
+    remaining = lifespanSeconds - this->lived;
+  }
+  else
+  {
+    const uint16_t *deaths = table->deaths[sex == Male ? Male : Female];
+    remaining = getExpectancySeconds(deaths, age) + lifespanSeconds - getExpectancySeconds(deaths, 0);
+  }
+
+  // Up to 10 times the life plus the day, the product of getElapsed() stays in 64 bits
+  int64_t life = this->lived + remaining;
+  this->elapsedScale = this->lived >= 0 && life >= LIFE_TABLE_DAY && this->lived / 10 <= life ? ((uint64_t)1000 << LIFE_TABLE_ELAPSED_SHIFT) / (uint64_t)life : 0;
+
+  // Whole days rounded down and the rest, also after the end of the lifespan
+  int64_t days = remaining >= 0 ? remaining / LIFE_TABLE_DAY : -((-remaining + LIFE_TABLE_DAY - 1) / LIFE_TABLE_DAY);
+  this->remainingDays = (long)days;
+  this->remainingSeconds = (long)(remaining - days * LIFE_TABLE_DAY);
+  return this->remainingDays;
+}
+
+/*
+The baseline minus the second of the day, one day is borrowed when the rest is used up
+*/
+void AEON_LifeTable::getCountdown(long secondOfDay, long *days, long *seconds)
+{
+  *days = this->remainingDays;
+  *seconds = this->remainingSeconds - secondOfDay;
+  if (*seconds < 0)
+  {
+    *seconds += LIFE_TABLE_DAY;
+    (*days)--;
+  }
+}
+
+/*
+Lived seconds times the per mille per second of the day, 0 before the birthday
+*/
+int AEON_LifeTable::getElapsed(long secondOfDay)
+{
+  return (int)(((uint64_t)(this->lived + secondOfDay) * this->elapsedScale) >> LIFE_TABLE_ELAPSED_SHIFT);
+}
+
+/*
+Binary search over the codes
+*/
+const SLIFE_TABLE *AEON_LifeTable::find(const char *country)
+{
+  int code = AEON_Lifespan::code(country);
+  int low = 0;
+  int high = (int)this->tableCount - 1;
+  while (low <= high)
+  {
+    int middle = (low + high) / 2;
+    int current = AEON_Lifespan::code(this->tables[middle].code);
+    if (current == code)
+    {
+      return &this->tables[middle];
+    }
+    if (current < code)
+    {
+      low = middle + 1;
+    }
+    else
+    {
+      high = middle - 1;
+    }
+  }
+  return NULL;
+}
+
+/*
+Tables of AEON_LifeTables.h
+*/
+uint8_t AEON_LifeTable::getCount()
+{
+  return LIFE_TABLE_COUNT;
+}
+
+/*
+Table of AEON_LifeTables.h, the first one for an index outside
+*/
+const SLIFE_TABLE &AEON_LifeTable::get(uint8_t index)
+{
+  return lifeTables[index < LIFE_TABLE_COUNT ? index : 0];
+}
+
+/*
+Days of getExpectancySeconds()
+*/
+long AEON_LifeTable::getExpectancy(const uint16_t *deaths, long ageDays)
+{
+  return (long)(getExpectancySeconds(deaths, ageDays) / LIFE_TABLE_DAY);
+}
+
+/*
+Expectancy = person-years lived above the age / survivors at the age. Survivors and person-years are
+counted twice (sum of the survivors at both ends of a year) and in 1/65536 of a person, the fraction
+of the year of age in 1/65536 as well, the person-years of the age in 1/2^32.
+*/
+int64_t AEON_LifeTable::getExpectancySeconds(const uint16_t *deaths, long ageDays)
+{
+  if (ageDays < 0)
+  {
+    ageDays = 0;
+  }
+  uint32_t age = (uint64_t)ageDays * 400 / DAYS_PER_400_YEARS;
+  if (age >= LIFE_TABLE_AGES)
+  {
+    return 0;
+  }
+  uint64_t fraction = (((uint64_t)ageDays * 400 % DAYS_PER_400_YEARS) << 16) / DAYS_PER_400_YEARS;
+
+  // Survivors at the start and the end of the year of age
+  uint32_t survivors = LIFE_TABLE_RADIX;
+  for (uint32_t x = 0; x < age; x++)
+  {
+    survivors -= deaths[x];
+  }
+  uint32_t survivorsNext = survivors - deaths[age];
+
+  // Person-years of the older ages
+  uint64_t years = 0;
+  uint32_t living = survivorsNext;
+  for (uint32_t x = age + 1; x < LIFE_TABLE_AGES; x++)
+  {
+    uint32_t next = living - deaths[x];
+    years += living + next;
+    living = next;
+  }
+
+  // Survivors at the age and the rest of its year
+  uint64_t survivorsAge = ((uint64_t)survivors << 16) - fraction * deaths[age];
+  if (survivorsAge == 0)
+  {
+    return 0;
+  }
+
+  // Twice the person-years in 1/2^32, nothing is cut off when only a fraction of a person is left
+  uint64_t yearsAge = (65536 - fraction) * (survivorsAge + ((uint64_t)survivorsNext << 16)) + (years << 32);
+  uint64_t denominator = survivorsAge << 16;
+
+  // Half years and the rest of the division in seconds, the rest is cut to 39 bits so the product stays in 64
+  uint64_t halfYears = yearsAge / denominator;
+  uint64_t rest = yearsAge % denominator;
+  while (denominator >= (1ULL << 39))
+  {
+    denominator >>= 1;
+    rest >>= 1;
+  }
+  return (int64_t)(halfYears * LIFE_TABLE_HALF_YEAR + rest * LIFE_TABLE_HALF_YEAR / denominator);
+}
+
+/*
+Days from the civil date, proleptic Gregorian calendar (H. Hinnant, days_from_civil)
+*/
+long AEON_LifeTable::getDayNumber(int year, int month, int day)
+{
+  year -= month <= 2;
+  long era = (year >= 0 ? year : year - 399) / 400;
+  long yearOfEra = year - era * 400;
+  long dayOfYear = (153 * (month + (month > 2 ? -3 : 9)) + 2) / 5 + day - 1;
+  long dayOfEra = yearOfEra * 365 + yearOfEra / 4 - yearOfEra / 100 + dayOfYear;
+  return era * DAYS_PER_400_YEARS + dayOfEra - 719468;
+}
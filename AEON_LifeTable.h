@@ -0,0 +1,92 @@
+/*
+AEON_LifeTable.h - Remaining lifespan from period life tables.
+
+A life table follows a cohort of LIFE_TABLE_RADIX people from birth to the last age of the table with
+the death probabilities (qx) of one period. The flash holds the deaths of every age (dx, the difference
+of two survivors lx) as uint16_t for women and men, so one table is 444 bytes and the survivors are
+exact fixed point numbers: lx = LIFE_TABLE_RADIX - the deaths of the younger ages, nothing is left
+after the last age. The tables are generated from CSV files (qx by age) by aeon_lifetable (extras/host)
+into AEON_LifeTables.h, sorted by the code of the country (AEON_Lifespan.h).
+
+getExpectancy() is the life expectancy at an age in days, the age may be any day: the deaths are spread
+evenly over a year of age, the survivors between two ages are linear. Integer arithmetic only.
+
+The remaining days are the life expectancy at the current age plus the difference of the lifespan
+setting to the life expectancy at birth of the table, at the default lifespan of the country the
+setting does not move it. A country without a table and AEON_LIFE_TABLES 0 give the lifespan setting
+minus the age, the default until AEON_LifeTables.h holds published tables (LIFE_TABLES_PLACEHOLDER 0).
+The tables of AEON_LifeTables.h are the ones of the firmware, the host check extras/host/aeon_remaining
+passes tables with a known life expectancy to the constructor.
+getRemainingDays() keeps the inputs of the last calculation and calculates again only
+when one changes, the date once a day.
+
+The calculation of the day is a baseline at the start of the day in seconds: the remaining and the lived
+seconds and the per mille of the whole life per second in Q48. The countdown of the base page
+(AEON_COUNTDOWN) takes the second of the day away from it with a borrow of one day, the elapsed per
+mille is one multiplication and a shift (getCountdown(), getElapsed()), nothing of the day is calculated
+again.
+*/
+
+#ifndef AEON_LIFE_TABLE_h
+#define AEON_LIFE_TABLE_h
+
+#include <Arduino.h>
+#include "AEON_Enums.h"
+#include "AEON_Config.h"
+
+#define LIFE_TABLE_AGES 111          // 0 to 110, everybody dies in the last age
+#define LIFE_TABLE_RADIX (1UL << 19) // Survivors at birth, the deaths of one age fit an uint16_t
+#define LIFE_TABLE_DAY 86400L       // Seconds
+#define LIFE_TABLE_ELAPSED_SHIFT 48 // Fixed point of the per mille per second, 11 times 1000 << 48 fits 63 bits
+
+typedef struct
+{
+  char code[3]; // Country, ISO 3166
+  uint16_t deaths[2][LIFE_TABLE_AGES]; // Index = ESex, then the age
+} SLIFE_TABLE;
+
+class AEON_LifeTable
+{
+private:
+  const SLIFE_TABLE *tables; // Sorted by the code
+  uint8_t tableCount;
+
+  // Inputs of the last calculation
+  bool valid;
+  int year;
+  int month;
+  int day;
+  int birthYear;
+  int birthMonth;
+  int birthDay;
+  int country;
+  ESex sex;
+  int lifespan;
+
+  // Baseline at the start of the day
+  long remainingDays;    // Rounded down
+  long remainingSeconds; // Rest of the day, 0 to LIFE_TABLE_DAY - 1
+  int64_t lived;         // Seconds
+  uint64_t elapsedScale; // Per mille of the whole life per second, Q48
+
+public:
+  AEON_LifeTable();                                         // AEON_LifeTables.h, none with AEON_LIFE_TABLES 0
+  AEON_LifeTable(const SLIFE_TABLE *tables, uint8_t count); // Tables of the caller
+
+  // Today with month 1 to 12 (AEON_Time), the birthday with month 0 to 11 (AEON_ROM)
+  long getRemainingDays(int year, int month, int day, int birthYear, int birthMonth, int birthDay, const char *country, ESex sex, int lifespan);
+  // Of the day of the last getRemainingDays()
+  void getCountdown(long secondOfDay, long *days, long *seconds); // Days rounded down, seconds of the rest
+  int getElapsed(long secondOfDay);                               // Per mille of the life
+
+  const SLIFE_TABLE *find(const char *country); // NULL when the country has no table
+
+  // AEON_LifeTables.h
+  static uint8_t getCount();
+  static const SLIFE_TABLE &get(uint8_t index);
+  static long getExpectancy(const uint16_t *deaths, long ageDays); // Remaining days at the age
+  static int64_t getExpectancySeconds(const uint16_t *deaths, long ageDays);
+  static long getDayNumber(int year, int month, int day);          // Days since 1970-01-01, month 1 to 12
+};
+
+#endif
@@ -0,0 +1,78 @@
+/*
+AEON_LifeTables.h - Life tables of AEON_LifeTable, deaths of every age per LIFE_TABLE_RADIX births.
+Generated by aeon_lifetable (extras/host) from extras/lifetables, do not edit.
+*/
+
+#ifndef AEON_LIFE_TABLES_h
+#define AEON_LIFE_TABLES_h
+
+#define LIFE_TABLES_PLACEHOLDER 1 // A table is a placeholder of aeon_lifetable --placeholder, not published data
+
+static const SLIFE_TABLE lifeTables[] = {
+    // DE, e0 83.00 / 78.00 years, placeholder, Gompertz-Makeham fitted to 83 / 78 years
+    {"DE",
+     {{1573, 112, 113, 114, 115, 116, 117, 118, 120, 122, 123, 125, 128, 130, 132, 135,
+       139, 142, 146, 151, 155, 161, 167, 173, 181, 188, 197, 207, 218, 230, 243, 257,
+       273, 291, 311, 332, 356, 382, 411, 444, 478, 518, 561, 608, 660, 719, 782, 852,
+       929, 1014, 1108, 1211, 1325, 1449, 1586, 1736, 1902, 2083, 2282, 2499, 2736, 2997, 3280, 3590,
+       3926, 4291, 4688, 5116, 5580, 6079, 6614, 7187, 7798, 8447, 9132, 9853, 10605, 11386, 12187, 13005,
+       13828, 14645, 15443, 16205, 16916, 17552, 18095, 18518, 18803, 18921, 18857, 18590, 18109, 17410, 16495, 15377,
+       14084, 12646, 11111, 9532, 7961, 6458, 5071, 3843, 2798, 1951, 1297, 816, 485, 270, 254},
+      {1573, 117, 119, 120, 122, 124, 125, 128, 130, 133, 136, 139, 143, 147, 151, 156,
+       162, 167, 174, 182, 189, 199, 208, 219, 231, 245, 259, 275, 294, 313, 335, 359,
+       385, 415, 447, 484, 522, 566, 614, 667, 726, 789, 861, 939, 1025, 1119, 1224, 1338,
+       1465, 1603, 1755, 1922, 2105, 2306, 2525, 2766, 3029, 3315, 3627, 3967, 4336, 4736, 5169, 5637,
+       6139, 6680, 7257, 7872, 8527, 9216, 9941, 10697, 11481, 12286, 13105, 13929, 14746, 15541, 16301, 17004,
+       17634, 18164, 18577, 18843, 18945, 18860, 18570, 18067, 17344, 16405, 15268, 13955, 12504, 10960, 9376, 7810,
+       6314, 4941, 3728, 2704, 1876, 1240, 777, 458, 253, 130, 62, 27, 11, 3, 2}}},
+    // ES, e0 85.00 / 79.00 years, placeholder, Gompertz-Makeham fitted to 85 / 79 years
+    {"ES",
+     {{1573, 111, 111, 112, 113, 114, 115, 116, 117, 118, 120, 121, 123, 125, 128, 129,
+       133, 135, 138, 142, 146, 151, 155, 160, 166, 173, 180, 188, 197, 207, 217, 229,
+       242, 256, 273, 290, 309, 331, 355, 381, 410, 441, 477, 516, 558, 606, 658, 715,
+       779, 848, 926, 1010, 1103, 1206, 1318, 1443, 1579, 1729, 1894, 2073, 2272, 2488, 2725, 2983,
+       3266, 3574, 3909, 4272, 4668, 5095, 5556, 6054, 6587, 7158, 7767, 8414, 9098, 9816, 10567, 11346,
+       12147, 12964, 13785, 14604, 15401, 16166, 16879, 17518, 18066, 18495, 18784, 18912, 18856, 18598, 18127, 17437,
+       16532, 15424, 14137, 12706, 11175, 9596, 8026, 6519, 5126, 3891, 2839, 1983, 1321, 834, 1036},
+      {1573, 116, 117, 119, 120, 122, 123, 126, 128, 130, 133, 135, 139, 143, 147, 151,
+       156, 161, 168, 174, 181, 189, 198, 208, 219, 231, 244, 259, 275, 293, 312, 335,
+       358, 385, 414, 447, 482, 522, 565, 613, 665, 724, 788, 859, 937, 1023, 1117, 1221,
+       1336, 1461, 1600, 1751, 1918, 2101, 2301, 2520, 2760, 3023, 3308, 3619, 3959, 4327, 4727, 5158,
+       5625, 6128, 6666, 7243, 7858, 8511, 9199, 9923, 10679, 11462, 12267, 13085, 13909, 14726, 15521, 16282,
+       16987, 17617, 18151, 18565, 18835, 18940, 18860, 18574, 18075, 17357, 16423, 15290, 13980, 12532, 10991, 9407,
+       7839, 6343, 4966, 3751, 2723, 1890, 1251, 785, 463, 257, 132, 62, 28, 11, 5}}},
+    // EU, e0 82.00 / 77.00 years, placeholder, Gompertz-Makeham fitted to 82 / 77 years
+    {"EU",
+     {{1573, 113, 114, 115, 116, 117, 118, 120, 122, 123, 126, 127, 130, 133, 135, 139,
+       142, 146, 151, 156, 161, 166, 174, 181, 188, 198, 207, 218, 230, 243, 258, 274,
+       291, 311, 333, 356, 383, 412, 444, 480, 519, 561, 610, 662, 719, 784, 853, 932,
+       1016, 1110, 1214, 1327, 1452, 1590, 1740, 1906, 2088, 2286, 2504, 2743, 3003, 3287, 3597, 3934,
+       4301, 4697, 5127, 5592, 6091, 6627, 7201, 7813, 8463, 9149, 9871, 10624, 11404, 12208, 13025, 13849,
+       14665, 15462, 16225, 16934, 17568, 18109, 18530, 18811, 18927, 18857, 18586, 18101, 17396, 16477, 15355, 14057,
+       12618, 11081, 9499, 7931, 6428, 5045, 3819, 2779, 1936, 1285, 808, 480, 266, 138, 112},
+      {1573, 119, 120, 122, 123, 126, 128, 130, 133, 136, 139, 143, 147, 152, 156, 162,
+       167, 175, 181, 190, 199, 208, 220, 231, 245, 260, 275, 294, 314, 335, 360, 386,
+       416, 448, 484, 523, 567, 616, 668, 727, 791, 863, 940, 1027, 1122, 1226, 1341, 1468,
+       1606, 1759, 1926, 2110, 2310, 2531, 2772, 3035, 3322, 3634, 3976, 4345, 4745, 5180, 5648, 6151,
+       6693, 7271, 7888, 8542, 9232, 9959, 10715, 11500, 12306, 13125, 13949, 14766, 15561, 16320, 17022, 17649,
+       18179, 18587, 18852, 18950, 18860, 18566, 18059, 17330, 16388, 15246, 13929, 12476, 10930, 9346, 7779, 6286,
+       4915, 3707, 2686, 1861, 1229, 769, 453, 250, 128, 61, 26, 11, 3, 2, 0}}},
+    // FR, e0 85.00 / 79.00 years, placeholder, Gompertz-Makeham fitted to 85 / 79 years
+    {"FR",
+     {{1573, 111, 111, 112, 113, 114, 115, 116, 117, 118, 120, 121, 123, 125, 128, 129,
+       133, 135, 138, 142, 146, 151, 155, 160, 166, 173, 180, 188, 197, 207, 217, 229,
+       242, 256, 273, 290, 309, 331, 355, 381, 410, 441, 477, 516, 558, 606, 658, 715,
+       779, 848, 926, 1010, 1103, 1206, 1318, 1443, 1579, 1729, 1894, 2073, 2272, 2488, 2725, 2983,
+       3266, 3574, 3909, 4272, 4668, 5095, 5556, 6054, 6587, 7158, 7767, 8414, 9098, 9816, 10567, 11346,
+       12147, 12964, 13785, 14604, 15401, 16166, 16879, 17518, 18066, 18495, 18784, 18912, 18856, 18598, 18127, 17437,
+       16532, 15424, 14137, 12706, 11175, 9596, 8026, 6519, 5126, 3891, 2839, 1983, 1321, 834, 1036},
+      {1573, 116, 117, 119, 120, 122, 123, 126, 128, 130, 133, 135, 139, 143, 147, 151,
+       156, 161, 168, 174, 181, 189, 198, 208, 219, 231, 244, 259, 275, 293, 312, 335,
+       358, 385, 414, 447, 482, 522, 565, 613, 665, 724, 788, 859, 937, 1023, 1117, 1221,
+       1336, 1461, 1600, 1751, 1918, 2101, 2301, 2520, 2760, 3023, 3308, 3619, 3959, 4327, 4727, 5158,
+       5625, 6128, 6666, 7243, 7858, 8511, 9199, 9923, 10679, 11462, 12267, 13085, 13909, 14726, 15521, 16282,
+       16987, 17617, 18151, 18565, 18835, 18940, 18860, 18574, 18075, 17357, 16423, 15290, 13980, 12532, 10991, 9407,
+       7839, 6343, 4966, 3751, 2723, 1890, 1251, 785, 463, 257, 132, 62, 28, 11, 5}}},
+};
+
+#endif
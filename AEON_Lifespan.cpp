@@ -0,0 +1,105 @@
+/*
+AEON_Lifespan.cpp
+
+Life expectancy at birth in years, rounded to whole years, based on The World Factbook -
+https://www.cia.gov/the-world-factbook/
+*/
+
+#include "AEON_Lifespan.h"
+
+// Sorted by code
+static constexpr SLIFESPAN lifespans[] = {
+    {"AT", 84, 79}, // Austria
+    {"AU", 85, 81}, // Australia
+    {"BE", 84, 79}, // Belgium
+    {"CA", 85, 80}, // Canada
+    {"CH", 86, 82}, // Switzerland
+    {"CZ", 82, 76}, // Czechia
+    {"DE", 83, 78}, // Germany
+    {"DK", 84, 80}, // Denmark
+    {"ES", 85, 79}, // Spain
+    {"EU", 82, 77}, // European Union
+    {"FI", 84, 79}, // Finland
+    {"FR", 85, 79}, // France
+    {"GB", 83, 79}, // United Kingdom
+    {"IE", 84, 80}, // Ireland
+    {"IT", 85, 81}, // Italy
+    {"JP", 88, 82}, // Japan
+    {"LU", 85, 80}, // Luxembourg
+    {"NL", 84, 80}, // Netherlands
+    {"NO", 85, 81}, // Norway
+    {"NZ", 84, 81}, // New Zealand
+    {"PL", 82, 74}, // Poland
+    {"PT", 84, 78}, // Portugal
+    {"SE", 85, 81}, // Sweden
+    {"US", 82, 78}, // United States
+};
+
+#define LIFESPAN_COUNT (sizeof(lifespans) / sizeof(lifespans[0]))
+
+static constexpr bool isSorted()
+{
+  for (size_t i = 1; i < LIFESPAN_COUNT; i++)
+  {
+    if (AEON_Lifespan::code(lifespans[i - 1].code) >= AEON_Lifespan::code(lifespans[i].code))
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+static_assert(isSorted(), "lifespans must be sorted by code, find() is a binary search");
+static_assert(LIFESPAN_COUNT <= 255, "The index of a country is an uint8_t");
+
+/*
+Binary search over the codes
+*/
+int AEON_Lifespan::find(int code)
+{
+  int low = 0;
+  int high = (int)LIFESPAN_COUNT - 1;
+  while (low <= high)
+  {
+    int middle = (low + high) / 2;
+    int current = AEON_Lifespan::code(lifespans[middle].code);
+    if (current == code)
+    {
+      return middle;
+    }
+    if (current < code)
+    {
+      low = middle + 1;
+    }
+    else
+    {
+      high = middle - 1;
+    }
+  }
+  return -1;
+}
+
+/*
+Country of the index, the first one for an index outside of the table
+*/
+const SLIFESPAN &AEON_Lifespan::get(uint8_t index)
+{
+  return lifespans[index < LIFESPAN_COUNT ? index : 0];
+}
+
+/*
+Countries of the table
+*/
+uint8_t AEON_Lifespan::getCount()
+{
+  return LIFESPAN_COUNT;
+}
+
+/*
+Default lifespan in years of the country and sex
+*/
+int AEON_Lifespan::getDefault(uint8_t index, ESex sex)
+{
+  const SLIFESPAN &lifespan = get(index);
+  return sex == Female ? lifespan.female : lifespan.male;
+}
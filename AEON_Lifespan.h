@@ -0,0 +1,38 @@
+/*
+AEON_Lifespan.h - Default lifespans by country.
+
+One table of every country with its life expectancy at birth for women and men. The table is constexpr
+and sorted by the ISO 3166 code of the country, it stays in the flash and nothing is built at the start.
+find() is a binary search over the codes, a static_assert keeps the table sorted. "EU" is the average
+of the European Union.
+
+The country is a setting of its own (AEON_ROM), the language only gives the country of a new ROM. The
+ROM keeps the two letters of the code in one int (code()), a saved country stays valid when countries
+are added to the table.
+*/
+
+#ifndef AEON_LIFESPAN_h
+#define AEON_LIFESPAN_h
+
+#include <Arduino.h>
+#include "AEON_Enums.h"
+
+typedef struct
+{
+  char code[3]; // ISO 3166, "DE"
+  uint8_t female;
+  uint8_t male;
+} SLIFESPAN;
+
+class AEON_Lifespan
+{
+public:
+  static int find(int code); // Index of the country, -1 when it is not in the table
+  static const SLIFESPAN &get(uint8_t index);
+  static uint8_t getCount();
+  static int getDefault(uint8_t index, ESex sex);
+
+  static constexpr int code(const char *country) { return (country[0] << 8) | country[1]; } // "DE" -> 0x4445
+};
+
+#endif
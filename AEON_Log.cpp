@@ -0,0 +1,176 @@
+/*
+AEON_Log.cpp
+
+Line format: <seconds>.<ms> <core> <event> <arguments>, the milliseconds since the start wrap after 49.7 days
+*/
+
+#include <Arduino.h>
+#include <pico/platform.h>
+#include <RTClib.h>
+#include "AEON_Config.h"
+#include "AEON_Enums.h"
+#include "AEON_Format.h"
+#include "AEON_Log.h"
+
+#define LOG_LINE 64
+
+static const char *const eventNames[LOG_Count] = {"TIME", "ERROR", "ROM LOAD", "ROM SETTINGS", "ROM SAVE", "ROM COMMIT FAILED", "HEAP", "LATENCY"};
+
+/*
+Add a record to the ring of the calling core, drop it if the ring is full
+*/
+static void logWrite(SLOG_RING *rings, ELogEvent event, uint8_t argCount, int32_t a, int32_t b, int32_t c, int32_t d)
+{
+  uint8_t core = get_core_num();
+  SLOG_RING &ring = rings[core];
+
+  uint32_t head = ring.head;
+  if (head - ring.tail >= AEON_LOG_RECORDS)
+  {
+    ring.dropped = ring.dropped + 1;
+    return;
+  }
+
+  SLOG_RECORD &record = ring.records[head & (AEON_LOG_RECORDS - 1)];
+  record.time = millis();
+  record.event = event;
+  record.core = core;
+  record.argCount = argCount;
+  record.args[0] = a;
+  record.args[1] = b;
+  record.args[2] = c;
+  record.args[3] = d;
+
+  // The record is complete before the reader sees the new head
+  __sync_synchronize();
+  ring.head = head + 1;
+}
+
+AEON_Log::AEON_Log()
+{
+  for (int i = 0; i < LOG_CORES; i++)
+  {
+    this->rings[i].head = 0;
+    this->rings[i].tail = 0;
+    this->rings[i].dropped = 0;
+  }
+}
+
+/*
+A record with no and with up to LOG_ARGS arguments
+*/
+void AEON_Log::write(ELogEvent event)
+{
+  logWrite(this->rings, event, 0, 0, 0, 0, 0);
+}
+
+void AEON_Log::write(ELogEvent event, int32_t a)
+{
+  logWrite(this->rings, event, 1, a, 0, 0, 0);
+}
+
+void AEON_Log::write(ELogEvent event, int32_t a, int32_t b)
+{
+  logWrite(this->rings, event, 2, a, b, 0, 0);
+}
+
+void AEON_Log::write(ELogEvent event, int32_t a, int32_t b, int32_t c)
+{
+  logWrite(this->rings, event, 3, a, b, c, 0);
+}
+
+void AEON_Log::write(ELogEvent event, int32_t a, int32_t b, int32_t c, int32_t d)
+{
+  logWrite(this->rings, event, 4, a, b, c, d);
+}
+
+/*
+Take the oldest record of the ring
+*/
+bool AEON_Log::read(SLOG_RING &ring, SLOG_RECORD &record)
+{
+  uint32_t tail = ring.tail;
+  if (tail == ring.head)
+  {
+    return false;
+  }
+
+  __sync_synchronize();
+  record = ring.records[tail & (AEON_LOG_RECORDS - 1)];
+
+  // The copy is done before the writer can reuse the slot
+  __sync_synchronize();
+  ring.tail = tail + 1;
+  return true;
+}
+
+/*
+Text of a record, returns the length
+*/
+size_t AEON_Log::format(const SLOG_RECORD &record, char *buffer, size_t size)
+{
+  AEON_Format line(buffer, size);
+  line.number(record.time / 1000).character('.').number(record.time % 1000, 3).character(' ').number(record.core).character(' ');
+  line.text(record.event < LOG_Count ? eventNames[record.event] : "?");
+
+  if (record.event == LOG_TIME)
+  {
+    char time[] = "hh:mm:ss DDD, MMM DD YYYY";
+    line.character(' ').text(DateTime((uint32_t)record.args[0]).toString(time));
+  }
+  else
+  {
+    for (uint8_t i = 0; i < record.argCount; i++)
+    {
+      line.character(' ').number(record.args[i]);
+    }
+  }
+
+  line.text("\r\n");
+  return line.length();
+}
+
+/*
+Print a few records of both rings while a host is connected (core 1, loop1)
+*/
+void AEON_Log::drain()
+{
+  if (!Serial)
+  {
+    return;
+  }
+
+  char buffer[LOG_LINE];
+  SLOG_RECORD record;
+
+  for (int i = 0; i < AEON_LOG_DRAIN; i++)
+  {
+    // The USB buffer has no room, try again at the next pass
+    if (Serial.availableForWrite() < LOG_LINE)
+    {
+      return;
+    }
+
+    // Core 0 first, it writes most of the records
+    if (!read(this->rings[0], record) && !read(this->rings[1], record))
+    {
+      return;
+    }
+
+    size_t length = format(record, buffer, sizeof(buffer));
+    Serial.write((const uint8_t *)buffer, length);
+  }
+}
+
+/*
+Records dropped because a ring was full
+*/
+uint32_t AEON_Log::getDropped()
+{
+  uint32_t dropped = 0;
+  for (int i = 0; i < LOG_CORES; i++)
+  {
+    dropped += this->rings[i].dropped;
+  }
+  return dropped;
+}
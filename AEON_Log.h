@@ -0,0 +1,61 @@
+/*
+AEON_Log.h - Binary log that never blocks the loop.
+write() puts a record (timestamp, core, event, up to 4 arguments) into the ring of the calling core and
+returns at once. Every ring has one writer (its core) and one reader (drain() on core 1), so head and tail
+need no lock. A full ring drops the record and counts it, the loop never waits for Serial. drain() runs in
+loop1(), formats a few records per pass and writes them over USB only while a host is connected and the
+USB buffer has room. Records stay in the ring while no host is connected.
+*/
+
+#ifndef AEON_LOG_h
+#define AEON_LOG_h
+
+#include <Arduino.h>
+#include "AEON_Config.h"
+#include "AEON_Enums.h"
+
+#define LOG_ARGS 4
+#define LOG_CORES 2
+
+static_assert((AEON_LOG_RECORDS & (AEON_LOG_RECORDS - 1)) == 0, "AEON_LOG_RECORDS must be a power of two");
+
+typedef struct
+{
+  uint32_t time;  // millis(), 32 bit micros() would wrap after 71 minutes
+  uint8_t event;  // ELogEvent
+  uint8_t core;
+  uint8_t argCount;
+  int32_t args[LOG_ARGS];
+} SLOG_RECORD;
+
+typedef struct
+{
+  SLOG_RECORD records[AEON_LOG_RECORDS];
+  volatile uint32_t head; // Written by the core of the ring
+  volatile uint32_t tail; // Written by drain()
+  volatile uint32_t dropped;
+} SLOG_RING;
+
+class AEON_Log
+{
+private:
+  SLOG_RING rings[LOG_CORES];
+
+  bool read(SLOG_RING &ring, SLOG_RECORD &record);
+  size_t format(const SLOG_RECORD &record, char *buffer, size_t size);
+
+public:
+  AEON_Log();
+
+  void write(ELogEvent event);
+  void write(ELogEvent event, int32_t a);
+  void write(ELogEvent event, int32_t a, int32_t b);
+  void write(ELogEvent event, int32_t a, int32_t b, int32_t c);
+  void write(ELogEvent event, int32_t a, int32_t b, int32_t c, int32_t d);
+
+  void drain();
+
+  uint32_t getDropped();
+};
+
+#endif
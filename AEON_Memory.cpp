@@ -0,0 +1,178 @@
+/*
+AEON_Memory.cpp
+*/
+
+#include <Arduino.h>
+#include <pico/platform.h>
+#include "AEON_Config.h"
+#include "AEON_Heap.h"
+#include "AEON_Memory.h"
+
+#define STACK_PATTERN 0xA5A5A5A5UL
+#define STACK_MARGIN 64 // Bytes below the stack pointer that paintStack() leaves alone
+
+extern AEON_Heap heap;
+
+// Linker script of the RP2040 core (memmap_default.ld), missing on the host
+extern "C" char __data_start__[] __attribute__((weak));
+extern "C" char __data_end__[] __attribute__((weak));
+extern "C" char __bss_start__[] __attribute__((weak));
+extern "C" char __bss_end__[] __attribute__((weak));
+extern "C" char __end__[] __attribute__((weak));
+extern "C" char __HeapLimit[] __attribute__((weak));
+extern "C" char __StackBottom[] __attribute__((weak));
+extern "C" char __StackTop[] __attribute__((weak));
+extern "C" char __StackOneBottom[] __attribute__((weak));
+extern "C" char __StackOneTop[] __attribute__((weak));
+
+/*
+Bytes from start to end, 0 without the symbols
+*/
+static size_t span(const char *start, const char *end)
+{
+  uintptr_t from = (uintptr_t)start;
+  uintptr_t to = (uintptr_t)end;
+  return (from != 0 && to > from) ? to - from : 0;
+}
+
+AEON_Memory::AEON_Memory()
+{
+  for (int i = 0; i < MEMORY_CORES; i++)
+  {
+    this->painted[i] = false;
+  }
+}
+
+/*
+Stack of a core in the linker script: core 0 in SCRATCH_Y, core 1 in SCRATCH_X
+*/
+uint8_t *AEON_Memory::getStackBottom(uint8_t core)
+{
+  return (uint8_t *)(core == 0 ? __StackBottom : __StackOneBottom);
+}
+
+/*
+Top of the stack of a core, from the linker script
+*/
+uint8_t *AEON_Memory::getStackTop(uint8_t core)
+{
+  return (uint8_t *)(core == 0 ? __StackTop : __StackOneTop);
+}
+
+/*
+Fill the free part of the stack of the calling core with the pattern
+*/
+void AEON_Memory::paintStack()
+{
+#if AEON_STACK_PAINT
+  uint8_t core = get_core_num();
+  uint8_t *bottom = getStackBottom(core);
+  uint8_t *top = getStackTop(core);
+  uint8_t *pointer = (uint8_t *)__builtin_frame_address(0);
+
+  if (core >= MEMORY_CORES || bottom == NULL || top == NULL || pointer <= bottom + STACK_MARGIN || pointer > top)
+  {
+    return;
+  }
+
+  volatile uint32_t *word = (volatile uint32_t *)(((uintptr_t)bottom + 3) & ~(uintptr_t)3);
+  while ((uint8_t *)(word + 1) <= pointer - STACK_MARGIN)
+  {
+    *word++ = STACK_PATTERN;
+  }
+  this->painted[core] = true;
+#endif
+}
+
+/*
+The stack of the core was painted, its high water mark can be read
+*/
+bool AEON_Memory::isPainted(uint8_t core)
+{
+  return core < MEMORY_CORES && this->painted[core];
+}
+
+/*
+Bytes of the stack of a core
+*/
+size_t AEON_Memory::getStackSize(uint8_t core)
+{
+  return span((char *)getStackBottom(core), (char *)getStackTop(core));
+}
+
+/*
+Deepest use of the stack since it was painted
+*/
+size_t AEON_Memory::getStackUsed(uint8_t core)
+{
+  if (!isPainted(core))
+  {
+    return 0;
+  }
+
+  const volatile uint32_t *word = (const volatile uint32_t *)(((uintptr_t)getStackBottom(core) + 3) & ~(uintptr_t)3);
+  uint8_t *top = getStackTop(core);
+  while ((uint8_t *)word < top && *word == STACK_PATTERN)
+  {
+    word++;
+  }
+  return top - (uint8_t *)word;
+}
+
+/*
+Initialised variables, copied from the flash at the start
+*/
+size_t AEON_Memory::getData()
+{
+  return span(__data_start__, __data_end__);
+}
+
+/*
+Bytes of .bss
+*/
+size_t AEON_Memory::getBss()
+{
+  return span(__bss_start__, __bss_end__);
+}
+
+/*
+Space between the end of .bss and the stacks
+*/
+size_t AEON_Memory::getHeapSize()
+{
+  return span(__end__, __HeapLimit);
+}
+
+/*
+Called by core 1 (serial command)
+*/
+void AEON_Memory::print(Print &out)
+{
+  if (getData() || getBss())
+  {
+    out.printf("RAM: .data %u, .bss %u bytes\n", (unsigned)getData(), (unsigned)getBss());
+  }
+  else
+  {
+    out.println("RAM: unknown");
+  }
+
+  out.printf("Heap: %u in use, %u high-water", (unsigned)heap.getUsed(), (unsigned)heap.getReserved());
+  if (getHeapSize())
+  {
+    out.printf(" of %u", (unsigned)getHeapSize());
+  }
+  out.println(" bytes");
+
+  for (uint8_t core = 0; core < MEMORY_CORES; core++)
+  {
+    if (isPainted(core))
+    {
+      out.printf("Stack core %u: %u of %u bytes high-water\n", core, (unsigned)getStackUsed(core), (unsigned)getStackSize(core));
+    }
+    else
+    {
+      out.printf("Stack core %u: unknown\n", core);
+    }
+  }
+}
@@ -0,0 +1,48 @@
+/*
+AEON_Memory.h - Memory use at runtime, "memory" on Serial prints it.
+
+RAM: .data and .bss from the linker symbols of the RP2040 core. The split per module comes from the
+linker map, see extras/host/tools/aeon_footprint.cpp.
+Stacks: each core paints its stack below the stack pointer with a pattern at the start of setup() and
+setup1() (AEON_STACK_PAINT). The high-water mark is the deepest word that no longer holds the pattern.
+A core that runs on another stack than the one of the linker script (core1_separate_stack) is not
+painted.
+Heap: the bytes in use and the bytes the heap took from the system. The heap of newlib does not give them
+back, so they are its high-water mark.
+
+Without the linker symbols (host build) RAM and stacks are reported as unknown.
+*/
+
+#ifndef AEON_MEMORY_h
+#define AEON_MEMORY_h
+
+#include <Arduino.h>
+#include "AEON_Config.h"
+
+#define MEMORY_CORES 2
+
+class AEON_Memory
+{
+private:
+  bool painted[MEMORY_CORES];
+
+  uint8_t *getStackBottom(uint8_t core);
+  uint8_t *getStackTop(uint8_t core);
+
+public:
+  AEON_Memory();
+
+  void paintStack(); // Stack of the calling core
+
+  bool isPainted(uint8_t core);
+  size_t getStackSize(uint8_t core);
+  size_t getStackUsed(uint8_t core);
+
+  size_t getData();
+  size_t getBss();
+  size_t getHeapSize();
+
+  void print(Print &out);
+};
+
+#endif
@@ -0,0 +1,329 @@
+/*
+AEON_Panel.h - Compile time description of the display panel and the display backends.
+The geometry (width, height, pages, buffer size) and the controller (I2C address, reset pin, supply and
+init commands) are template parameters, so the compiler folds all geometry math to constants and every
+panel gets its own build. The backend is selected in AEON_Config.h:
+
+AEON_PanelDriver      = Adafruit_SSD1306 with a static frame buffer and the init commands of the controller,
+                        display() queues the frame on the I2C bus (see AEON_Bus.h)
+AEON_PanelFramebuffer = The same page-major frame buffer without any bus traffic, for host builds and tests
+
+AEON_PanelText puts the UTF-8 text of AEON_Font on a backend. AEON_PanelDisplay is the backend with text
+and AEON_PanelGeometry the geometry of the configured panel.
+*/
+
+#ifndef AEON_PANEL_h
+#define AEON_PANEL_h
+
+#include <Arduino.h>
+#include <Wire.h>
+#include <Adafruit_GFX.h>
+#include <Adafruit_SSD1306.h>
+#include "AEON_Config.h"
+#include "AEON_Enums.h"
+#include "AEON_Bus.h"
+#include "AEON_Profiler.h"
+#include "AEON_Font.h"
+
+extern AEON_Bus bus;
+
+/*
+Geometry
+*/
+template <int W, int H>
+struct AEON_Geometry
+{
+  static_assert(W > 0 && W <= 128, "The controllers address 128 columns");
+  static_assert(H > 0 && H <= 64 && (H % 8) == 0, "The height must be a multiple of one page (8 rows)");
+
+  static constexpr int WIDTH = W;
+  static constexpr int HEIGHT = H;
+  static constexpr int PAGES = H / 8;
+  static constexpr int BUFFER_SIZE = W * PAGES;
+
+  // x/y to place something of the given size in the middle of the panel
+  static constexpr int centerX(int width) { return (WIDTH - width) / 2; }
+  static constexpr int centerY(int height) { return (HEIGHT - height) / 2; }
+
+  // Width of a text with the classic 6x8 font
+  static constexpr int textWidth(int chars, int textSize) { return chars * 6 * textSize; }
+};
+
+/*
+Controller
+*/
+struct AEON_ControllerSSD1306
+{
+  static constexpr uint8_t ADDRESS = 0x3C;                   // See Datasheet for Address; 0x78 or 0x3C for 128x64
+  static constexpr int8_t RESET_PIN = 3;                     // Reset pin # default 3 (old_18)
+  static constexpr uint8_t VCC_STATE = SSD1306_SWITCHCAPVCC; // Generate display voltage from 3.3V internally
+
+  // Nothing to add to the Adafruit init sequence
+  static constexpr uint8_t INIT_LENGTH = 0;
+  static constexpr uint8_t INIT[] = {0xE3}; // NOP
+};
+
+struct AEON_ControllerSSD1309
+{
+  static constexpr uint8_t ADDRESS = 0x3C;
+  static constexpr int8_t RESET_PIN = 3;
+  static constexpr uint8_t VCC_STATE = SSD1306_EXTERNALVCC; // SSD1309 has no charge pump
+
+  // Contrast, pre-charge period and VCOMH level of the SSD1309 datasheet
+  static constexpr uint8_t INIT_LENGTH = 6;
+  static constexpr uint8_t INIT[] = {
+      SSD1306_SETCONTRAST, 0xDF,
+      SSD1306_SETPRECHARGE, 0x82,
+      SSD1306_SETVCOMDETECT, 0x34};
+};
+
+/*
+Backend for SSD1306 and SSD1309, the frame buffer is static so begin() does not allocate it.
+The bus owns Wire: the init sequence runs while the bus is taken and the clock stays at AEON_BUS_CLOCK.
+*/
+template <class Geometry, class Controller>
+class AEON_PanelDriver : public Adafruit_SSD1306
+{
+private:
+  static uint8_t frame[Geometry::BUFFER_SIZE];
+
+public:
+  AEON_PanelDriver() : Adafruit_SSD1306(Geometry::WIDTH, Geometry::HEIGHT, &Wire, Controller::RESET_PIN, AEON_BUS_CLOCK, AEON_BUS_CLOCK)
+  {
+    buffer = frame;
+  }
+
+  ~AEON_PanelDriver()
+  {
+    // The frame is not allocated, keep Adafruit_SSD1306 from freeing it
+    buffer = NULL;
+  }
+
+  bool begin()
+  {
+    bus.attach(BUS_DEVICE_DISPLAY, Controller::ADDRESS, BUS_PRIORITY_LOW);
+
+    // The init sequence of the library does not check the answers of the controller
+    if (!bus.probe(BUS_DEVICE_DISPLAY) || !bus.beginExclusive(BUS_DEVICE_DISPLAY))
+    {
+      return false;
+    }
+
+    bool ok = Adafruit_SSD1306::begin(Controller::VCC_STATE, Controller::ADDRESS, true, false);
+    for (uint8_t i = 0; ok && i < Controller::INIT_LENGTH; i++)
+    {
+      ssd1306_command(Controller::INIT[i]);
+    }
+
+    bus.endExclusive(BUS_DEVICE_DISPLAY);
+    return ok;
+  }
+
+  // Queue the frame, bus.service() sends it in chunks and calls shown when it was sent
+  void display(frameCallback shown = NULL)
+  {
+    PROFILE_SCOPE(PROFILE_DISPLAY);
+    bus.submitFrame(buffer, Geometry::WIDTH, shown);
+  }
+};
+
+template <class Geometry, class Controller>
+uint8_t AEON_PanelDriver<Geometry, Controller>::frame[Geometry::BUFFER_SIZE];
+
+/*
+Backend without a controller, display() only counts the frames, every frame counts as shown
+*/
+template <class Geometry>
+class AEON_PanelFramebuffer : public Adafruit_GFX
+{
+private:
+  static uint8_t frame[Geometry::BUFFER_SIZE];
+  uint32_t frameCount;
+
+public:
+  AEON_PanelFramebuffer() : Adafruit_GFX(Geometry::WIDTH, Geometry::HEIGHT), frameCount(0) {}
+
+  bool begin()
+  {
+    clearDisplay();
+    return true;
+  }
+
+  void display(frameCallback shown = NULL)
+  {
+    PROFILE_SCOPE(PROFILE_DISPLAY);
+    frameCount++;
+    if (shown != NULL)
+    {
+      shown(frame, Geometry::BUFFER_SIZE);
+    }
+  }
+  void clearDisplay() { memset(frame, 0, Geometry::BUFFER_SIZE); }
+  uint8_t *getBuffer() { return frame; }
+  uint32_t getFrameCount() { return frameCount; }
+
+  void drawPixel(int16_t x, int16_t y, uint16_t color) override
+  {
+    if ((x < 0) || (x >= width()) || (y < 0) || (y >= height()))
+    {
+      return;
+    }
+
+    int16_t t;
+    switch (getRotation())
+    {
+    case 1:
+      t = x;
+      x = Geometry::WIDTH - y - 1;
+      y = t;
+      break;
+    case 2:
+      x = Geometry::WIDTH - x - 1;
+      y = Geometry::HEIGHT - y - 1;
+      break;
+    case 3:
+      t = x;
+      x = y;
+      y = Geometry::HEIGHT - t - 1;
+      break;
+    }
+
+    uint8_t mask = (uint8_t)(1 << (y & 7));
+    switch (color)
+    {
+    case RASTER_WHITE:
+      frame[x + (y / 8) * Geometry::WIDTH] |= mask;
+      break;
+    case RASTER_BLACK:
+      frame[x + (y / 8) * Geometry::WIDTH] &= ~mask;
+      break;
+    case RASTER_INVERSE:
+      frame[x + (y / 8) * Geometry::WIDTH] ^= mask;
+      break;
+    }
+  }
+};
+
+template <class Geometry>
+uint8_t AEON_PanelFramebuffer<Geometry>::frame[Geometry::BUFFER_SIZE];
+
+/*
+UTF-8 text on a backend. ASCII goes to Adafruit GFX, the other characters are drawn with the glyphs of
+AEON_Font in the same 6x8 cell, wrapped and scaled like the classic font. getTextBounds() counts a
+character as one cell instead of one per byte.
+*/
+template <class Backend>
+class AEON_PanelText : public Backend
+{
+private:
+  AEON_Font decoder;
+
+  void drawGlyph(int16_t x, int16_t y, const uint8_t *glyph, uint16_t color, uint16_t bg, uint8_t size_x, uint8_t size_y)
+  {
+    if ((x >= this->_width) || (y >= this->_height) || ((x + 6 * size_x - 1) < 0) || ((y + 8 * size_y - 1) < 0))
+    {
+      return;
+    }
+
+    this->startWrite();
+    for (int8_t i = 0; i < 5; i++)
+    {
+      uint8_t line = glyph[i];
+      for (int8_t j = 0; j < 8; j++, line >>= 1)
+      {
+        if (line & 1)
+        {
+          this->writeFillRect(x + i * size_x, y + j * size_y, size_x, size_y, color);
+        }
+        else if (bg != color)
+        {
+          this->writeFillRect(x + i * size_x, y + j * size_y, size_x, size_y, bg);
+        }
+      }
+    }
+    if (bg != color)
+    {
+      this->writeFillRect(x + 5 * size_x, y, size_x, 8 * size_y, bg);
+    }
+    this->endWrite();
+  }
+
+public:
+  using Backend::write;
+
+  size_t write(uint8_t c) override
+  {
+    uint32_t character;
+    if (!decoder.decode(c, &character))
+    {
+      return 1;
+    }
+    if (character < 0x80)
+    {
+      return Backend::write((uint8_t)character);
+    }
+
+    const uint8_t *glyph = AEON_Font::getGlyph(character);
+    if (glyph == NULL)
+    {
+      return Backend::write('?');
+    }
+
+    if (this->wrap && ((this->cursor_x + this->textsize_x * 6) > this->_width))
+    {
+      this->cursor_x = 0;
+      this->cursor_y += this->textsize_y * 8;
+    }
+    drawGlyph(this->cursor_x, this->cursor_y, glyph, this->textcolor, this->textbgcolor, this->textsize_x, this->textsize_y);
+    this->cursor_x += this->textsize_x * 6;
+    return 1;
+  }
+
+  void getTextBounds(const char *text, int16_t x, int16_t y, int16_t *x1, int16_t *y1, uint16_t *w, uint16_t *h)
+  {
+    int16_t minx = 0x7FFF, miny = 0x7FFF, maxx = -1, maxy = -1;
+    uint32_t character;
+
+    *x1 = x;
+    *y1 = y;
+    *w = *h = 0;
+
+    while ((character = AEON_Font::next(&text)))
+    {
+      this->charBounds(character < 0x80 ? (unsigned char)character : '?', &x, &y, &minx, &miny, &maxx, &maxy);
+    }
+
+    if (maxx >= minx)
+    {
+      *x1 = minx;
+      *w = maxx - minx + 1;
+    }
+    if (maxy >= miny)
+    {
+      *y1 = miny;
+      *h = maxy - miny + 1;
+    }
+  }
+
+  void getTextBounds(const __FlashStringHelper *text, int16_t x, int16_t y, int16_t *x1, int16_t *y1, uint16_t *w, uint16_t *h)
+  {
+    getTextBounds(reinterpret_cast<const char *>(text), x, y, x1, y1, w, h);
+  }
+};
+
+/*
+Configured panel
+*/
+typedef AEON_Geometry<AEON_DISPLAY_WIDTH, AEON_DISPLAY_HEIGHT> AEON_PanelGeometry;
+
+#if AEON_DISPLAY_CONTROLLER == AEON_CONTROLLER_SSD1306
+typedef AEON_PanelText<AEON_PanelDriver<AEON_PanelGeometry, AEON_ControllerSSD1306>> AEON_PanelDisplay;
+#elif AEON_DISPLAY_CONTROLLER == AEON_CONTROLLER_SSD1309
+typedef AEON_PanelText<AEON_PanelDriver<AEON_PanelGeometry, AEON_ControllerSSD1309>> AEON_PanelDisplay;
+#elif AEON_DISPLAY_CONTROLLER == AEON_CONTROLLER_HOST
+typedef AEON_PanelText<AEON_PanelFramebuffer<AEON_PanelGeometry>> AEON_PanelDisplay;
+#else
+#error "Unknown AEON_DISPLAY_CONTROLLER, see AEON_Config.h"
+#endif
+
+#endif
@@ -0,0 +1,177 @@
+/*
+AEON_Profiler.cpp
+*/
+
+#include <Arduino.h>
+#include <string.h>
+#include "AEON_Config.h"
+#include "AEON_Enums.h"
+#include "AEON_Format.h"
+#include "AEON_Profiler.h"
+
+static const char *const probeNames[PROFILE_Count] = {
+    "loop", "loop.time", "loop.button", "loop.pages", "loop.display", "loop.error", "display",
+    "page.base", "page.time", "page.date", "page.birthday", "page.sex", "page.country", "page.lifespan", "page.language",
+    "page.reset", "page.back", "page.error", "latency.debounce", "latency.dispatch", "latency.render",
+    "latency.queue", "latency.flush", "latency.total"};
+
+/*
+Cycles as microseconds with one decimal
+*/
+static void appendMicros(AEON_Format &line, uint32_t cycles, uint32_t cyclesPerMicro)
+{
+  uint64_t tenths = (uint64_t)cycles * 10 / cyclesPerMicro;
+  line.character(' ').number((long)(tenths / 10)).character('.').number((long)(tenths % 10));
+}
+
+AEON_Profiler::AEON_Profiler()
+{
+  clear();
+  this->resetPending = false;
+}
+
+/*
+Empty histograms, the minimum starts at the top
+*/
+void AEON_Profiler::clear()
+{
+  memset(this->histograms, 0, sizeof(this->histograms));
+  for (int i = 0; i < PROFILE_Count; i++)
+  {
+    this->histograms[i].min = UINT32_MAX;
+  }
+}
+
+/*
+Bucket of a duration: values below PROFILE_STEPS have their own bucket, above the highest bit selects the
+power of two and the next two bits the step inside of it
+*/
+uint8_t AEON_Profiler::bucket(uint32_t cycles)
+{
+  if (cycles < PROFILE_STEPS)
+  {
+    return cycles;
+  }
+
+  uint8_t octave = 31 - __builtin_clz(cycles);
+  uint8_t step = (cycles >> (octave - 2)) & (PROFILE_STEPS - 1);
+  return (octave - 1) * PROFILE_STEPS + step;
+}
+
+/*
+Largest duration of a bucket
+*/
+uint32_t AEON_Profiler::bucketLimit(uint8_t bucket)
+{
+  if (bucket < PROFILE_STEPS)
+  {
+    return bucket;
+  }
+
+  uint8_t octave = bucket / PROFILE_STEPS + 1;
+  uint8_t step = bucket % PROFILE_STEPS;
+  uint64_t limit = ((uint64_t)(PROFILE_STEPS + step + 1) << (octave - 2)) - 1;
+  return limit > UINT32_MAX ? UINT32_MAX : (uint32_t)limit;
+}
+
+/*
+Add the cycles of one run of a probe to its histogram
+*/
+void AEON_Profiler::record(EProfile probe, uint32_t cycles)
+{
+  SPROFILE_HISTOGRAM &histogram = this->histograms[probe];
+
+  histogram.count++;
+  histogram.total += cycles;
+  if (cycles < histogram.min)
+  {
+    histogram.min = cycles;
+  }
+  if (cycles > histogram.max)
+  {
+    histogram.max = cycles;
+  }
+  histogram.buckets[bucket(cycles)]++;
+}
+
+/*
+Clear the histograms if core 1 asked for it (core 0, start of the loop)
+*/
+void AEON_Profiler::service()
+{
+  if (this->resetPending)
+  {
+    clear();
+    this->resetPending = false;
+  }
+}
+
+/*
+Ask core 0 to clear the histograms at its next service()
+*/
+void AEON_Profiler::reset()
+{
+  this->resetPending = true;
+}
+
+/*
+Upper bound of the bucket that holds the percentile, in cycles
+*/
+uint32_t AEON_Profiler::percentile(EProfile probe, uint8_t percent)
+{
+  SPROFILE_HISTOGRAM &histogram = this->histograms[probe];
+  if (histogram.count == 0)
+  {
+    return 0;
+  }
+
+  uint64_t rank = ((uint64_t)histogram.count * percent + 99) / 100;
+  uint64_t seen = 0;
+  for (uint8_t i = 0; i < PROFILE_BUCKETS; i++)
+  {
+    seen += histogram.buckets[i];
+    if (seen >= rank)
+    {
+      // The bucket can reach above the largest value
+      uint32_t limit = bucketLimit(i);
+      return limit < histogram.max ? limit : histogram.max;
+    }
+  }
+  return histogram.max;
+}
+
+/*
+Histogram of a probe, core 0 keeps writing into it
+*/
+SPROFILE_HISTOGRAM *AEON_Profiler::getHistogram(EProfile probe)
+{
+  return &this->histograms[probe];
+}
+
+/*
+One line per probe that has values: name count min p50 p99 max [us]
+*/
+void AEON_Profiler::print(Print &out)
+{
+  uint32_t cyclesPerMicro = rp2040.f_cpu() / 1000000;
+  char line[96];
+
+  out.println("probe count min p50 p99 max [us]");
+  for (int i = 0; i < PROFILE_Count; i++)
+  {
+    EProfile probe = (EProfile)i;
+    SPROFILE_HISTOGRAM &histogram = this->histograms[probe];
+    if (histogram.count == 0)
+    {
+      continue;
+    }
+
+    AEON_Format text(line, sizeof(line));
+    text.text(probeNames[i]).character(' ').number(histogram.count);
+    appendMicros(text, histogram.min, cyclesPerMicro);
+    appendMicros(text, percentile(probe, 50), cyclesPerMicro);
+    appendMicros(text, percentile(probe, 99), cyclesPerMicro);
+    appendMicros(text, histogram.max, cyclesPerMicro);
+    out.println(line);
+  }
+}
@@ -0,0 +1,79 @@
+/*
+AEON_Profiler.h - Histograms of the time spent in the loop phases and pages (EProfile).
+PROFILE_SCOPE(probe) at the top of a block measures the block in CPU cycles (SysTick, rp2040.getCycleCount())
+and adds it to the histogram of the probe. The buckets are logarithmic with 4 steps per power of two, so
+every bucket is at most 25% wide and a histogram covers 1 cycle to 2^32 cycles in 124 counters.
+print() shows count, min, p50, p99 and max in microseconds; p50 and p99 are the upper bound of their bucket.
+
+Only core 0 records. reset() can be called from core 1, the histograms are cleared by core 0 at the start
+of the next loop (service()). With AEON_PROFILER 0 the scopes compile to nothing.
+*/
+
+#ifndef AEON_PROFILER_h
+#define AEON_PROFILER_h
+
+#include <Arduino.h>
+#include "AEON_Config.h"
+#include "AEON_Enums.h"
+
+#define PROFILE_STEPS 4                       // Buckets per power of two
+#define PROFILE_BUCKETS (31 * PROFILE_STEPS) // 1 .. 2^32 cycles
+
+typedef struct
+{
+  uint32_t count;
+  uint32_t min;
+  uint32_t max;
+  uint64_t total;
+  uint32_t buckets[PROFILE_BUCKETS];
+} SPROFILE_HISTOGRAM;
+
+class AEON_Profiler
+{
+private:
+  SPROFILE_HISTOGRAM histograms[PROFILE_Count];
+  volatile bool resetPending;
+
+  void clear();
+
+public:
+  AEON_Profiler();
+
+  static uint32_t now() { return rp2040.getCycleCount(); }
+  static uint8_t bucket(uint32_t cycles);
+  static uint32_t bucketLimit(uint8_t bucket);
+
+  void record(EProfile probe, uint32_t cycles);
+  void service();
+  void reset();
+
+  uint32_t percentile(EProfile probe, uint8_t percent);
+  SPROFILE_HISTOGRAM *getHistogram(EProfile probe);
+  void print(Print &out);
+};
+
+extern AEON_Profiler profiler;
+
+/*
+Measures the scope it lives in
+*/
+class AEON_ProfileScope
+{
+private:
+  EProfile probe;
+  uint32_t start;
+
+public:
+  AEON_ProfileScope(EProfile probe) : probe(probe), start(AEON_Profiler::now()) {}
+  ~AEON_ProfileScope() { profiler.record(probe, AEON_Profiler::now() - start); }
+};
+
+#if AEON_PROFILER
+#define PROFILE_CONCAT_(a, b) a##b
+#define PROFILE_CONCAT(a, b) PROFILE_CONCAT_(a, b)
+#define PROFILE_SCOPE(probe) AEON_ProfileScope PROFILE_CONCAT(profileScope, __LINE__)(probe)
+#else
+#define PROFILE_SCOPE(probe)
+#endif
+
+#endif
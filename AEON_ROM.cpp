@@ -8,6 +8,12 @@ AEON_ROM.cpp
 #include "AEON_Enums.h"
 #include "AEON_Global.h"
 #include "AEON_ROM.h"
+#include "AEON_Log.h"
+#include "AEON_Strings.h"
+#include "AEON_Lifespan.h"
+
+extern AEON_Log logger;
+extern AEON_Strings strings;
 
 /*
 ROM
@@ -75,6 +81,7 @@ void AEON_ROM::saveToEEPROM()
       this->lifespanFemale,
       this->lifespanMale,
       this->language,
+      AEON_Lifespan::code(AEON_Lifespan::get(this->country).code),
   };
 
   // Write the array of values to EEPROM at the specified address.
@@ -87,7 +94,7 @@ void AEON_ROM::saveToEEPROM()
 
 /*
 This method reads data from the EEPROM and updates the object properties.
-It also prints the loaded data to the Serial Monitor.
+It also logs the loaded data.
 */
 void AEON_ROM::getEEPROM()
 {
@@ -95,7 +102,7 @@ void AEON_ROM::getEEPROM()
 
   int arrayContent[ARRAY_SIZE];
   // The content of the EEPROM is an array with the following structure:
-  // {init, birthdayYear, birthdayMonth, birthdayDay, sex, lifespanWoman, lifespanMan}
+  // {init, birthdayYear, birthdayMonth, birthdayDay, sex, lifespanWoman, lifespanMan, language, country}
   readIntArrayFromEEPROM(EEPROM_ADDRESS, arrayContent, ARRAY_SIZE);
 
   // Update the object properties with the loaded data
@@ -109,20 +116,25 @@ void AEON_ROM::getEEPROM()
     this->lifespanFemale = arrayContent[5];
     this->lifespanMale = arrayContent[6];
     this->language = static_cast<ELanguage>(arrayContent[7]);
+    // The language pack is gone
+    if (this->language >= strings.getLanguageCount())
+    {
+      this->language = GLOBAL_DEFAULTS::defaultLanguage;
+    }
+    strings.setLanguage(this->language);
+
+    // No country in a ROM of an older firmware, the one of the language
+    int country = AEON_Lifespan::find(arrayContent[8]);
+    if (country < 0)
+    {
+      country = AEON_Lifespan::find(AEON_Lifespan::code(strings.getDefaultCountry(this->language)));
+    }
+    this->country = country < 0 ? 0 : country;
   }
 
-  // Print the loaded data to the Serial Monitor
-  Serial.printf("Init: %d, Birthday Year: %d, Birthday Month: %d, Birthday Day: %d, Sex: %d, Lifespan Female: %d, Lifespan Male: %d, Language: %d",
-                this->init,
-                this->birthdayYear,
-                this->birthdayMonth,
-                this->birthdayDay,
-                this->sex,
-                this->lifespanFemale,
-                this->lifespanMale,
-                this->language);
-
-  Serial.println();
+  // Log the loaded data
+  logger.write(LOG_ROM_LOAD, this->init, this->birthdayYear, this->birthdayMonth, this->birthdayDay);
+  logger.write(LOG_ROM_SETTINGS, this->sex, this->lifespanFemale, this->lifespanMale, this->language);
 }
 
 /*
@@ -134,9 +146,11 @@ void AEON_ROM::resetEEPROM()
   this->birthdayMonth = GLOBAL_DEFAULTS::defaultBirthdayMonth;
   this->birthdayDay = GLOBAL_DEFAULTS::defaultBirthdayDay;
   this->sex = GLOBAL_DEFAULTS::defaultSex;
-  this->lifespanFemale = GLOBAL_DEFAULTS::defaultLifespanFemale[this->language];
-  this->lifespanMale = GLOBAL_DEFAULTS::defaultLifespanMale[this->language];
   this->language = GLOBAL_DEFAULTS::defaultLanguage;
+  strings.setLanguage(this->language);
+  int country = AEON_Lifespan::find(AEON_Lifespan::code(strings.getDefaultCountry(this->language)));
+  this->country = country < 0 ? 0 : country;
+  updateDefaultLifespan();
   Serial.println("Set Defaults and reset EEPROM");
   saveToEEPROM();
 }
@@ -333,12 +347,12 @@ void AEON_ROM::setLifespan(int value)
 }
 
 /*
-Update the Lifespan with defaults
+Update the Lifespan with the defaults of the country
 */
 void AEON_ROM::updateDefaultLifespan()
 {
-  this->lifespanFemale = GLOBAL_DEFAULTS::defaultLifespanFemale[this->language];
-  this->lifespanMale = GLOBAL_DEFAULTS::defaultLifespanMale[this->language];
+  this->lifespanFemale = AEON_Lifespan::getDefault(this->country, Female);
+  this->lifespanMale = AEON_Lifespan::getDefault(this->country, Male);
 }
 
 /*
@@ -354,8 +368,8 @@ Sets the language
 */
 void AEON_ROM::setLanguage(int value)
 {
-  // int numLanguages = std::size(ELanguage{});            // c++17
-  int numLanguages = static_cast<int>(ELanguage::Count); //
+  // Built-in and loaded languages
+  int numLanguages = strings.getLanguageCount();
   int currentLanguageIndex = static_cast<int>(this->language);
 
   // Next Language
@@ -376,8 +390,38 @@ void AEON_ROM::setLanguage(int value)
 
   language = static_cast<ELanguage>(currentLanguageIndex);
   this->language = language;
+  strings.setLanguage(this->language);
+}
 
-  // Update default lifespan based on language
+/*
+Get the country code
+*/
+const char *AEON_ROM::getCountry()
+{
+  return AEON_Lifespan::get(this->country).code;
+}
+
+/*
+Sets the country, next or previous one of the table
+*/
+void AEON_ROM::setCountry(int value)
+{
+  int numCountries = AEON_Lifespan::getCount();
+
+  if (value > 0)
+  {
+    this->country = (this->country + 1) % numCountries;
+  }
+  else if (value < 0)
+  {
+    this->country = (this->country - 1 + numCountries) % numCountries;
+  }
+  else
+  {
+    return;
+  }
+
+  // Update default lifespan based on country
   updateDefaultLifespan();
 }
 
@@ -386,7 +430,7 @@ Reset the error to state return null
 */
 void AEON_ROM::resetErrorStateRom()
 {
-  EReturn_ROM lastErrorState = EReturn_ROM::ROM_RETURN_NULL;
+  this->lastErrorState = EReturn_ROM::ROM_RETURN_NULL;
 }
 
 /*
@@ -422,11 +466,11 @@ bool AEON_ROM::writeIntArrayIntoEEPROM(int address, int numbers[], int arraySize
 
     if (!EEPROM.commit())
     {
-      Serial.println("ERROR! EEPROM commit failed");
+      logger.write(LOG_ROM_COMMIT_FAILED);
       return_value = false;
     }
   }
-  Serial.printf("\n Save to EEPROM \n");
+  logger.write(LOG_ROM_SAVE, return_value);
   return return_value;
 }
 
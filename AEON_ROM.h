@@ -30,6 +30,7 @@ private:
   int lifespanFemale;
   int lifespanMale;
   ELanguage language;
+  uint8_t country; // Index into AEON_Lifespan, saved as its code
 
   /*
    * 00 = EEPROM_RETURN_NULL
@@ -58,6 +59,7 @@ public:
   void setLifespan(int value);
   void updateDefaultLifespan();
   void setLanguage(int value);
+  void setCountry(int value);
   void resetErrorStateRom();
 
   bool getInit();
@@ -70,6 +72,7 @@ public:
   int getDefaultLifespanMale();
   int getLifespan();
   ELanguage getLanguage();
+  const char *getCountry();
   EReturn_ROM getErrorState();
 
   bool writeIntArrayIntoEEPROM(int address, int numbers[], int arraySize);
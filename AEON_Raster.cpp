@@ -0,0 +1,91 @@
+/*
+AEON_Raster.cpp - Span operations of the raster primitives, they do not depend on the panel geometry.
+A horizontal span touches the same bit in consecutive bytes of one page, so it is written with one
+replicated mask per 32-bit word after the unaligned head bytes. Spans covering all 8 rows of a page
+are plain memset calls.
+*/
+
+#include <Arduino.h>
+#include <string.h>
+#include "AEON_Enums.h"
+#include "AEON_Raster.h"
+
+// Word access to the byte buffer, may_alias keeps the compiler from assuming uint8_t/uint32_t never overlap
+typedef uint32_t __attribute__((__may_alias__)) raster_word_t;
+
+/*
+Bits of the rows y0..y1 (inclusive) that fall into the page
+*/
+uint8_t AEON_RasterOps::pageMask(int y0, int y1, int page)
+{
+  int top = page * 8;
+  int first = (y0 > top) ? y0 - top : 0;
+  int last = (y1 < top + 7) ? y1 - top : 7;
+
+  return (uint8_t)((0xFF << first) & (0xFF >> (7 - last)));
+}
+
+/*
+Apply the mask to count bytes, the unaligned head and tail byte by byte and the rest word by word
+*/
+template <ERasterColor color>
+static void rasterSpan(uint8_t *dst, int count, uint8_t mask)
+{
+  const uint32_t wordMask = mask * 0x01010101UL;
+
+  while (count > 0 && ((uintptr_t)dst & 3))
+  {
+    AEON_RasterOps::applyByte(dst++, mask, color);
+    count--;
+  }
+
+  raster_word_t *words = (raster_word_t *)dst;
+  for (; count >= 4; count -= 4)
+  {
+    switch (color)
+    {
+    case RASTER_WHITE:
+      *words |= wordMask;
+      break;
+    case RASTER_BLACK:
+      *words &= ~wordMask;
+      break;
+    case RASTER_INVERSE:
+      *words ^= wordMask;
+      break;
+    }
+    words++;
+  }
+
+  dst = (uint8_t *)words;
+  while (count-- > 0)
+  {
+    AEON_RasterOps::applyByte(dst++, mask, color);
+  }
+}
+
+/*
+Mask of one page on count columns in the color
+*/
+void AEON_RasterOps::applySpan(uint8_t *dst, int count, uint8_t mask, ERasterColor color)
+{
+  // A full page is a plain byte fill
+  if (mask == 0xFF && color != RASTER_INVERSE)
+  {
+    memset(dst, (color == RASTER_WHITE) ? 0xFF : 0x00, count);
+    return;
+  }
+
+  switch (color)
+  {
+  case RASTER_WHITE:
+    rasterSpan<RASTER_WHITE>(dst, count, mask);
+    break;
+  case RASTER_BLACK:
+    rasterSpan<RASTER_BLACK>(dst, count, mask);
+    break;
+  case RASTER_INVERSE:
+    rasterSpan<RASTER_INVERSE>(dst, count, mask);
+    break;
+  }
+}
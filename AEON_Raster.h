@@ -0,0 +1,195 @@
+/*
+AEON_Raster.h - Fast line and rectangle primitives working directly on the page-major SSD1306 buffer.
+The buffer holds WIDTH bytes per page, a page covers 8 rows and bit (y & 7) of byte [x + (y / 8) * WIDTH]
+is the pixel at x/y. Horizontal spans set the same bit in consecutive bytes and are handled a 32-bit word
+at a time, vertical spans set several bits of one byte at once. Coordinates are buffer coordinates
+(rotation 0) and are clipped the same way the Adafruit driver clips them, so the result is bit exact
+to drawFastHLine/drawFastVLine/fillRect of Adafruit_SSD1306.
+
+AEON_Raster is specialized on the panel geometry (see AEON_Panel.h), the span operations that do not
+depend on the geometry live in AEON_RasterOps.
+*/
+
+#ifndef AEON_RASTER_h
+#define AEON_RASTER_h
+
+#include <Arduino.h>
+#include "AEON_Enums.h"
+
+class AEON_RasterOps
+{
+public:
+  static uint8_t pageMask(int y0, int y1, int page);
+  static void applySpan(uint8_t *dst, int count, uint8_t mask, ERasterColor color);
+
+  static inline void applyByte(uint8_t *dst, uint8_t mask, ERasterColor color)
+  {
+    switch (color)
+    {
+    case RASTER_WHITE:
+      *dst |= mask;
+      break;
+    case RASTER_BLACK:
+      *dst &= ~mask;
+      break;
+    case RASTER_INVERSE:
+      *dst ^= mask;
+      break;
+    }
+  }
+};
+
+template <class Geometry>
+class AEON_Raster
+{
+private:
+  uint8_t *buffer;
+
+  bool clipRect(int &x, int &y, int &w, int &h);
+
+public:
+  AEON_Raster() : buffer(NULL) {}
+
+  void setBuffer(uint8_t *buffer) { this->buffer = buffer; }
+  uint8_t *getBuffer() { return this->buffer; }
+
+  void drawHLine(int x, int y, int w, ERasterColor color);
+  void drawVLine(int x, int y, int h, ERasterColor color);
+  void fillRect(int x, int y, int w, int h, ERasterColor color);
+  void invertRect(int x, int y, int w, int h);
+  void clearRegion(int x, int y, int w, int h);
+};
+
+/*
+Clip the rectangle to the buffer. Returns false if nothing is left to draw, a negative width or height
+draws nothing like in the Adafruit driver.
+*/
+template <class Geometry>
+bool AEON_Raster<Geometry>::clipRect(int &x, int &y, int &w, int &h)
+{
+  if (!this->buffer || w <= 0 || h <= 0)
+  {
+    return false;
+  }
+
+  if (x < 0)
+  {
+    w += x;
+    x = 0;
+  }
+  if (y < 0)
+  {
+    h += y;
+    y = 0;
+  }
+  if (x + w > Geometry::WIDTH)
+  {
+    w = Geometry::WIDTH - x;
+  }
+  if (y + h > Geometry::HEIGHT)
+  {
+    h = Geometry::HEIGHT - y;
+  }
+
+  return w > 0 && h > 0;
+}
+
+/*
+Horizontal line from x to x + w - 1 in row y
+*/
+template <class Geometry>
+void AEON_Raster<Geometry>::drawHLine(int x, int y, int w, ERasterColor color)
+{
+  int h = 1;
+  if (!clipRect(x, y, w, h))
+  {
+    return;
+  }
+
+  AEON_RasterOps::applySpan(&this->buffer[x + (y / 8) * Geometry::WIDTH], w, (uint8_t)(1 << (y & 7)), color);
+}
+
+/*
+Vertical line from y to y + h - 1 in column x, one byte per page
+*/
+template <class Geometry>
+void AEON_Raster<Geometry>::drawVLine(int x, int y, int h, ERasterColor color)
+{
+  int w = 1;
+  if (!clipRect(x, y, w, h))
+  {
+    return;
+  }
+
+  int y1 = y + h - 1;
+  for (int page = y / 8; page <= y1 / 8; page++)
+  {
+    AEON_RasterOps::applyByte(&this->buffer[x + page * Geometry::WIDTH], AEON_RasterOps::pageMask(y, y1, page), color);
+  }
+}
+
+/*
+Filled rectangle, one span per page
+*/
+template <class Geometry>
+void AEON_Raster<Geometry>::fillRect(int x, int y, int w, int h, ERasterColor color)
+{
+  if (!clipRect(x, y, w, h))
+  {
+    return;
+  }
+
+  int y1 = y + h - 1;
+  for (int page = y / 8; page <= y1 / 8; page++)
+  {
+    AEON_RasterOps::applySpan(&this->buffer[x + page * Geometry::WIDTH], w, AEON_RasterOps::pageMask(y, y1, page), color);
+  }
+}
+
+/*
+Invert the pixels of the rectangle, used to highlight an area
+*/
+template <class Geometry>
+void AEON_Raster<Geometry>::invertRect(int x, int y, int w, int h)
+{
+  fillRect(x, y, w, h, RASTER_INVERSE);
+}
+
+/*
+Clear the rectangle. Full pages over the full width are contiguous in the buffer and cleared with a
+single memset, partial pages keep the bits outside the region.
+*/
+template <class Geometry>
+void AEON_Raster<Geometry>::clearRegion(int x, int y, int w, int h)
+{
+  if (!clipRect(x, y, w, h))
+  {
+    return;
+  }
+
+  int y1 = y + h - 1;
+  int page = y / 8;
+  int lastPage = y1 / 8;
+
+  while (page <= lastPage)
+  {
+    uint8_t mask = AEON_RasterOps::pageMask(y, y1, page);
+
+    if (mask == 0xFF && w == Geometry::WIDTH)
+    {
+      int fullPages = 1;
+      while (page + fullPages <= lastPage && AEON_RasterOps::pageMask(y, y1, page + fullPages) == 0xFF)
+      {
+        fullPages++;
+      }
+      memset(&this->buffer[page * Geometry::WIDTH], 0x00, fullPages * Geometry::WIDTH);
+      page += fullPages;
+      continue;
+    }
+
+    AEON_RasterOps::applySpan(&this->buffer[x + page * Geometry::WIDTH], w, mask, RASTER_BLACK);
+    page++;
+  }
+}
+
+#endif
@@ -4,18 +4,216 @@ AEON_Strings.cpp
 
 #include "AEON_Strings.h"
 #include "AEON_Enums.h"
-#include "AEON_ROM.h"
+#include "AEON_Global.h"
 
-extern AEON_ROM rom;
+static_assert(AEON_LANGUAGE_ENGLISH == English && AEON_LANGUAGE_GERMAN == German && AEON_LANGUAGE_FRENCH == French && AEON_LANGUAGE_SPAIN == Spain,
+              "AEON_LANGUAGE_* must match ELanguage");
+
+// Packs in the order of ELanguage, a single language build has its pack only
+static const SLANGUAGE_PACK packs[] = {
+#if AEON_LANGUAGE == AEON_LANGUAGE_ALL || AEON_LANGUAGE == AEON_LANGUAGE_ENGLISH
+  /* English */ {
+    {"Error", "OK", "Remaining Days", "Setup", "Setup Time", "Time", "Setup Date", "Date", "Setup Birthday",
+     "Birthday", "Setup Sex", "Sex", "Female", "Male", "Setup Country", "Country", "Setup Lifespan", "Lifespan", "Setup Language",
+     "Language", "English", "German", "French", "Spain", "Setup Reset", "Reset", "YES", "NO", "Back"},
+    {"Sun", "Mon", "Tue", "Wed", "Thu", "Fri", "Sat"},
+    {"Jan", "Feb", "Mar", "Apr", "May", "Jun", "Jul", "Aug", "Sep", "Oct", "Nov", "Dec"},
+    ','},
+#endif
+#if AEON_LANGUAGE == AEON_LANGUAGE_ALL || AEON_LANGUAGE == AEON_LANGUAGE_GERMAN
+  /* German */ {
+    {"Fehler", "OK", "Verbleibende Tage", "Setup", "Setup Zeit", "Zeit", "Setup Datum", "Datum", "Setup Geburtstag",
+     "Geburtstag", "Setup Geschlecht", "Geschlecht", "Frau", "Mann", "Setup Land", "Land", "Setup Lebenszeit", "Lebenszeit", "Setup Sprache",
+     "Sprache", "Englisch", "Deutsch", "Französisch", "Spanisch", "Setup Zurücksetzen", "Reset", "JA", "NEIN",
+     "Zurück"},
+    {"So", "Mo", "Di", "Mi", "Do", "Fr", "Sa"},
+    {"Jan", "Feb", "Mär", "Apr", "Mai", "Jun", "Jul", "Aug", "Sep", "Okt", "Nov", "Dez"},
+    '.'},
+#endif
+#if AEON_LANGUAGE == AEON_LANGUAGE_ALL || AEON_LANGUAGE == AEON_LANGUAGE_FRENCH
+  /* French */ {
+    {"Erreur", "OK", "Jours restants", "Config", "l'heure", "Heure", "la date", "Date", "l'anniversaire",
+     "Anniv.", "le sexe", "Sexe", "Femme", "Homme", "le pays", "Pays", "la durée de vie", "Durée.", "la langue",
+     "Langue", "Anglais", "Allemand", "Français", "Espagne", "Réinitialiser", "Réinitialiser", "OUI", "NON",
+     "Retour"},
+    {"Dim", "Lun", "Mar", "Mer", "Jeu", "Ven", "Sam"},
+    {"Jan", "Fév", "Mar", "Avr", "Mai", "Juin", "Juil", "Aoû", "Sep", "Oct", "Nov", "Déc"},
+    ' '},
+#endif
+#if AEON_LANGUAGE == AEON_LANGUAGE_ALL || AEON_LANGUAGE == AEON_LANGUAGE_SPAIN
+  /* Spain */ {
+    {"Error", "OK", "Días restantes", "Config", "la hora", "Hora", "la fecha", "Fecha", "el cumpleaños",
+     "Cumple.", "el sexo", "Sexo", "Mujer", "Hombre", "el país", "País", "la esperanza de vida", "Esperanza.", "el idioma",
+     "Idioma", "Inglés", "Alemán", "Francés", "Español", "Restablecer", "Restablecer", "SÍ", "NO",
+     "Volver"},
+    {"Dom", "Lun", "Mar", "Mié", "Jue", "Vie", "Sáb"},
+    {"Ene", "Feb", "Mar", "Abr", "May", "Jun", "Jul", "Ago", "Sep", "Oct", "Nov", "Dic"},
+    '.'},
+#endif
+};
+
+#define STRINGS_PACKS (sizeof(packs) / sizeof(packs[0]))
+
+static_assert(AEON_LANGUAGE != AEON_LANGUAGE_ALL || STRINGS_PACKS == ELanguage::Count, "A pack is needed for every ELanguage");
+
+// File system region of the arduino-pico linker script, in the XIP mapping of the flash. Missing on the host.
+extern "C" uint8_t _FS_start[] __attribute__((weak));
+extern "C" uint8_t _FS_end[] __attribute__((weak));
+
+AEON_Strings::AEON_Strings()
+{
+    this->pack = &packs[0];
+    this->loaded = NULL;
+    this->mountedCount = 0;
+}
+
+/*
+Swap the pack, called by the ROM when the language changes. A single language build keeps its built-in
+pack, a loaded language is used in every build.
+*/
+void AEON_Strings::setLanguage(ELanguage language)
+{
+    if (language >= ELanguage::Count)
+    {
+        // Language of an old or broken EEPROM or of a pack that is gone: keep the pack
+        if (language - ELanguage::Count < this->mountedCount)
+        {
+            this->loaded = this->mounted[language - ELanguage::Count];
+            AEON_Font::setPackGlyphs((const SFONT_GLYPH *)((const uint8_t *)this->loaded + this->loaded->glyphs), this->loaded->glyphCount);
+        }
+        return;
+    }
+
+    this->loaded = NULL;
+    AEON_Font::setPackGlyphs(NULL, 0);
+#if AEON_LANGUAGE == AEON_LANGUAGE_ALL
+    this->pack = &packs[language];
+#endif
+}
+
+/*
+Check the packs of the region and keep pointers to them. A pack that does not fit the firmware (version,
+strings) or the region is left out.
+*/
+uint8_t AEON_Strings::mountPacks(const uint8_t *region, size_t size)
+{
+    this->mountedCount = 0;
+#if AEON_PACKS
+    const SPACK_REGION *header = (const SPACK_REGION *)region;
+    if (region == NULL || ((uintptr_t)region & 3) || size < sizeof(SPACK_REGION) || header->magic != PACK_REGION_MAGIC ||
+        header->version != PACK_VERSION || header->count > (size - sizeof(SPACK_REGION)) / sizeof(uint32_t))
+    {
+        return 0;
+    }
+
+    const uint32_t *offsets = (const uint32_t *)(region + sizeof(SPACK_REGION));
+    for (uint16_t i = 0; i < header->count && this->mountedCount < AEON_PACKS_MAX; i++)
+    {
+        uint32_t offset = offsets[i];
+        if ((offset & 3) || offset >= size || size - offset < sizeof(SPACK_HEADER))
+        {
+            continue;
+        }
+
+        const uint8_t *base = region + offset;
+        const SPACK_HEADER *pack = (const SPACK_HEADER *)base;
+        if (pack->magic != PACK_MAGIC || pack->version != PACK_VERSION || pack->stringCount != PACK_STRINGS ||
+            pack->size > size - offset || pack->size < sizeof(SPACK_HEADER) || (pack->glyphs & 1) ||
+            pack->glyphs + (uint32_t)pack->glyphCount * sizeof(SFONT_GLYPH) > pack->size)
+        {
+            continue;
+        }
+
+        // Every string must end inside the pack
+        bool valid = memchr(pack->code, 0, sizeof(pack->code)) != NULL && memchr(pack->country, 0, sizeof(pack->country)) != NULL;
+        for (int string = -1; valid && string < PACK_STRINGS; string++)
+        {
+            uint16_t start = string < 0 ? pack->name : pack->strings[string];
+            valid = start < pack->size && memchr(base + start, 0, pack->size - start) != NULL;
+        }
+        if (valid)
+        {
+            this->mounted[this->mountedCount++] = pack;
+        }
+    }
+#else
+    (void)region;
+    (void)size;
+#endif
+    return this->mountedCount;
+}
+
+/*
+Mount the packs of the file system region of the linker script, none on the host
+*/
+uint8_t AEON_Strings::mountPacks()
+{
+    if (_FS_start == NULL || (uintptr_t)_FS_end <= (uintptr_t)_FS_start)
+    {
+        return 0;
+    }
+    return mountPacks(_FS_start, (uintptr_t)_FS_end - (uintptr_t)_FS_start);
+}
+
+/*
+Built-in and loaded languages
+*/
+uint8_t AEON_Strings::getLanguageCount()
+{
+    return ELanguage::Count + this->mountedCount;
+}
+
+/*
+A built-in language in the language in use, a loaded one in its own
+*/
+const char *AEON_Strings::getLanguageName(ELanguage language)
+{
+    if (language < ELanguage::Count)
+    {
+        return getString((EStrings)((int)EStrings::English + language));
+    }
+    if (language - ELanguage::Count < this->mountedCount)
+    {
+        const SPACK_HEADER *pack = this->mounted[language - ELanguage::Count];
+        return (const char *)pack + pack->name;
+    }
+    return "?";
+}
+
+/*
+Country of a new ROM in the language
+*/
+const char *AEON_Strings::getDefaultCountry(ELanguage language)
+{
+    if (language < ELanguage::Count)
+    {
+        return GLOBAL_DEFAULTS::defaultCountry[language];
+    }
+    if (language - ELanguage::Count < this->mountedCount)
+    {
+        return this->mounted[language - ELanguage::Count]->country;
+    }
+    return GLOBAL_DEFAULTS::defaultCountry[GLOBAL_DEFAULTS::defaultLanguage];
+}
+
+/*
+String of the loaded pack, read in place
+*/
+const char *AEON_Strings::getPackString(int index)
+{
+    return (const char *)this->loaded + this->loaded->strings[index];
+}
 
 /*
 Get Text string
 */
 const char *AEON_Strings::getString(EStrings string)
 {
-    ELanguage language = rom.getLanguage();
-
-    return AEON_Strings::text[(int)string][language];
+    if (this->loaded)
+    {
+        return getPackString((int)string);
+    }
+    return this->pack->text[(int)string];
 };
 
 /*
@@ -23,9 +221,11 @@ Get weekday string
 */
 const char *AEON_Strings::getWeekday(int weekday)
 {
-    ELanguage language = rom.getLanguage();
-
-    return AEON_Strings::dayOfWeek[(int)weekday][language];
+    if (this->loaded)
+    {
+        return getPackString((int)EStrings::Count + weekday);
+    }
+    return this->pack->weekday[weekday];
 };
 
 /*
@@ -33,65 +233,21 @@ Get month string
 */
 const char *AEON_Strings::getMonth(int month)
 {
-    ELanguage language = rom.getLanguage();
-
-    return AEON_Strings::monthOfYear[(int)month][language];
+    if (this->loaded)
+    {
+        return getPackString((int)EStrings::Count + 7 + month);
+    }
+    return this->pack->month[month];
 };
 
-// Strings of the month of year English, German, French, Spain
-const char* AEON_Strings::monthOfYear[][4] = {
-  /* Jan */ {"Jan", "Jan", "Jan", "Ene"},
-  /* Feb */ {"Feb", "Feb", "Fe`v", "Feb"},
-  /* Mar */ {"Mar", "Mär", "Mar", "Mar"},
-  /* Apr */ {"Apr", "Apr", "Avr", "Abr"},
-  /* May */ {"May", "Mai", "Mai", "May"},
-  /* Jun */ {"Jun", "Jun", "Juin", "Jun"},
-  /* Jul */ {"Jul", "Jul", "Juil", "Jul"},
-  /* Aug */ {"Aug", "Aug", "Aou^", "Ago"},
-  /* Sep */ {"Sep", "Sep", "Sep", "Sep"},
-  /* Oct */ {"Oct", "Okt", "Oct", "Oct"},
-  /* Nov */ {"Nov", "Nov", "Nov", "Nov"},
-  /* Dec */ {"Dec", "Dez", "De`c", "Dic"}
-};
-
-// Strings day of the week English, German, French, Spain
-const char* AEON_Strings::dayOfWeek[][4] = {
-  /* Sun */ {"Sun", "So", "Dim", "Dom"},
-  /* Mon */ {"Mon", "Mo", "Lun", "Lun"},
-  /* Tue */ {"Tue", "Di", "Mar", "Mar"},
-  /* Wed */ {"Wed", "Mi", "Mer", "Mie`"},
-  /* Thu */ {"Thu", "Do", "Jeu", "Jue"},
-  /* Fri */ {"Fri", "Fr", "Ven", "Vie"},
-  /* Sat */ {"Sat", "Sa", "Sam", "Sa`b"}
+/*
+Get the thousands separator of the language (12,345 / 12.345)
+*/
+char AEON_Strings::getThousandsSeparator()
+{
+    if (this->loaded)
+    {
+        return this->loaded->thousandsSeparator;
+    }
+    return this->pack->thousandsSeparator;
 };
-
-// Strings English, German, French, Spain
-const char* AEON_Strings::text[][4] = {
-  /*Error*/ {"Error", "Fehler", "Erreur", "Error"},
-  /*OK*/ {"OK", "OK", "OK", "OK"},
-  /*Remaining Days*/ {"Remaining Days", "Verbleibende Tage", "Jours restants", "Di`as restantes"},
-  /*Setup*/ {"Setup", "Setup", "Config", "Config"},
-  /*SetupTime*/ {"Setup Time", "Setup Zeit", "l'heure", "la hora"},
-  /*Time*/ {"Time", "Zeit", "Heure", "Hora"},
-  /*SetupDate*/ {"Setup Date", "Setup Datum", "la date", "la fecha"},
-  /*Date*/ {"Date", "Datum", "Date", "Fecha"},
-  /*SetupBirthday*/ {"Setup Birthday", "Setup Geburtstag", "l'anniversaire", "el cumpleanyos"},
-  /*Birthday*/ {"Birthday", "Geburtstag", "Anniv.", "Cumple."},
-  /*SetupSex*/ {"Setup Sex", "Setup Geschlecht", "le sexe", "el sexo"},
-  /*Sex*/ {"Sex", "Geschlecht", "Sexe", "Sexo"},
-  /*Female*/ {"Female", "Frau", "Femme", "Mujer"},
-  /*Male*/ {"Male", "Mann", "Homme", "Hombre"},
-  /*SetupLifespan*/ {"Setup Lifespan", "Setup Lebenszeit", "la dure`e de vie", "la esperanza de vida"},
-  /*Lifespan*/ {"Lifespan", "Lebenszeit", "Dure`e.", "Esperanza."},
-  /*SetupLanguage*/ {"Setup Language", "Setup Sprache", "a langue", "el idioma"},
-  /*Language*/ {"Language", "Sprache", "Langue", "Idioma"},
-  /*English*/ {"English", "Englisch", "Anglais", "Ingle`s"},
-  /*German*/ {"German", "Deutsch", "Allemand", "Alema`n"},
-  /*French*/ {"French", "Franz\x94sisch", "Fran\x87\x61is", "Franc\x82s"},
-  /*Spain*/ {"Spain", "Spanisch", "Espagne", "Espanya"},
-  /*SetupReset*/ {"Setup Reset", "Setup Zur\x81\x63ksetzen", "Re`initialiser", "Restablecer"},
-  /*Reset*/ {"Reset", "Reset", "Re`initialiser", "Restablecer"},
-  /*YES*/ {"YES", "JA", "OUI", "SI`"},
-  /*NO*/ {"NO", "NEIN", "NON", "NO"},
-  /*SetupBack*/ {"Back", "Zur\x81\x63\x6B", "Retour", "Volver"},
-};
\ No newline at end of file
@@ -1,5 +1,25 @@
 /*
-AEON_Strings.h
+AEON_Strings.h - Texts of the pages in every language.
+
+The strings of one language are a pack (SLANGUAGE_PACK): texts, weekdays, months and the thousands
+separator next to each other in the flash. The pack of the language in use is kept as a pointer, the
+ROM swaps it with setLanguage() when the language is loaded, reset or changed in the setup menu. A
+lookup is one index into the pack, it does not ask the ROM for the language.
+
+AEON_LANGUAGE (AEON_Config.h) builds the firmware with the pack of one language only.
+
+More languages can be loaded without a new firmware (AEON_PACKS). They are binary packs in the file
+system region of the flash, written with picotool, aeon_pack in extras/host builds them. mountPacks()
+checks the region at the start and keeps pointers to the packs, the strings are read in place through
+the XIP mapping of the flash and never copied to RAM. A loaded language follows the built-in ones
+(ELanguage::Count + n), it brings its name, the country of a new ROM and the glyphs of its characters
+that are not in the font.
+
+Region (little endian, every offset 4-byte aligned):
+  SPACK_REGION   magic "AEPR", version, count, offset of every pack from the start of the region
+  SPACK_HEADER   magic "AEPK", version, size, the offset of every string from the start of the pack,
+                 thousands separator, country and the glyph table (SFONT_GLYPH, sorted)
+  strings        UTF-8, terminated
 */
 
 #ifndef AEON_STRINGS_h
@@ -8,12 +28,24 @@ AEON_Strings.h
 #include <Arduino.h>
 #include "AEON_Global.h"
 #include "AEON_Enums.h"
+#include "AEON_Config.h"
+#include "AEON_Font.h"
+
+#define PACK_REGION_MAGIC 0x52504541UL // "AEPR"
+#define PACK_MAGIC 0x4B504541UL        // "AEPK"
+#define PACK_VERSION 2
+
+struct SLANGUAGE_PACK;
+struct SPACK_HEADER;
 
 class AEON_Strings {
 private:
-  static const char* dayOfWeek[][4];
-  static const char* monthOfYear[][4];
-  static const char* text[][4];
+  const SLANGUAGE_PACK* pack;      // Built-in language in use
+  const SPACK_HEADER* loaded;      // Loaded language in use, NULL for a built-in one
+  const SPACK_HEADER* mounted[AEON_PACKS_MAX]; // Packs of mountPacks()
+  uint8_t mountedCount;
+
+  const char* getPackString(int index);
 
 public:
   enum class EStrings {
@@ -31,6 +63,8 @@ public:
     Sex,
     Female,
     Male,
+    SetupCountry,
+    Country,
     SetupLifespan,
     Lifespan,
     SetupLanguage,
@@ -43,13 +77,54 @@ public:
     Reset,
     YES,
     NO,
-    SetupBack
+    SetupBack,
+    Count // To count all Strings
   };
 
+  AEON_Strings();
+
+  void setLanguage(ELanguage language);
+
+  uint8_t mountPacks(); // Packs in the file system region of the flash
+  uint8_t mountPacks(const uint8_t* region, size_t size);
+  uint8_t getLanguageCount();
+  const char* getLanguageName(ELanguage language);
+  const char* getDefaultCountry(ELanguage language); // AEON_Lifespan.h
+
   const char* getString(EStrings string);
   const char* getWeekday(int weekday);
   const char* getMonth(int month);  
-    
+  char getThousandsSeparator();
 };
 
+typedef struct SLANGUAGE_PACK {
+  const char* text[(int)AEON_Strings::EStrings::Count];
+  const char* weekday[7];
+  const char* month[12];
+  char thousandsSeparator;
+} SLANGUAGE_PACK;
+
+#define PACK_STRINGS ((int)AEON_Strings::EStrings::Count + 7 + 12) // Texts, weekdays, months
+
+typedef struct {
+  uint32_t magic;
+  uint16_t version;
+  uint16_t count;
+  // uint32_t offsets[count] follow
+} SPACK_REGION;
+
+typedef struct SPACK_HEADER {
+  uint32_t magic;
+  uint16_t version;
+  uint16_t size;
+  uint16_t stringCount; // PACK_STRINGS of the firmware the pack was built for
+  uint16_t name;        // Name of the language in the language itself
+  uint16_t strings[PACK_STRINGS];
+  uint16_t glyphs;      // SFONT_GLYPH[glyphCount]
+  uint8_t glyphCount;
+  char thousandsSeparator;
+  char code[4];         // "it", terminated
+  char country[3];      // "IT", terminated
+} SPACK_HEADER;
+
 #endif
\ No newline at end of file
@@ -15,9 +15,88 @@ const byte BUTTON_PIN = 7;
 #include <chrono>
 #include "AEON_Enums.h"
 #include "AEON_Time.h"
+#include "AEON_Bus.h"
+#include "AEON_Trace.h"
 #include "RTClib.h"
 
-RTC_DS3231 rtc;
+extern AEON_Bus bus;
+
+/*
+DS3231 registers, the RTC is read and written over the shared I2C bus
+*/
+#define RTC_ADDRESS 0x68
+#define RTC_REG_TIME 0x00   // Seconds, minutes, hours, weekday, day, month, year (BCD)
+#define RTC_REG_STATUS 0x0F // Bit 7 = oscillator stop flag
+#define RTC_STATUS_OSF 0x80
+
+static uint8_t bin2bcd(uint8_t value)
+{
+  return value + 6 * (value / 10);
+}
+
+static uint8_t bcd2bin(uint8_t value)
+{
+  return value - 6 * (value >> 4);
+}
+
+/*
+Read the time registers of the RTC
+*/
+DateTime AEON_Time::readRTC()
+{
+  uint8_t buffer[7] = {0, 0, 0, 0, 1, 1, 0};
+  if (!bus.readRegister(BUS_DEVICE_RTC, RTC_REG_TIME, buffer, sizeof(buffer)))
+  {
+    // Keep the last time until the RTC answers again
+    this->lastErrorState = EReturn_TIME::ERROR_TIME_NO_RTC;
+    if (this->year > 0)
+    {
+      return DateTime(this->year, this->month, this->day, this->hour, this->minute, this->second);
+    }
+  }
+
+  // Year, Month, Day, Hour, Minute, Second (month bit 7 = century, hour bit 6 = 12h mode)
+  DateTime now(bcd2bin(buffer[6]) + 2000U, bcd2bin(buffer[5] & 0x7F), bcd2bin(buffer[4]),
+               bcd2bin(buffer[2] & 0x3F), bcd2bin(buffer[1]), bcd2bin(buffer[0] & 0x7F));
+  TRACE(rtc(now.unixtime()));
+  return now;
+}
+
+/*
+Write the time registers of the RTC and clear the oscillator stop flag
+*/
+void AEON_Time::adjustRTC(const DateTime &dt)
+{
+  uint8_t buffer[7] = {bin2bcd(dt.second()), bin2bcd(dt.minute()), bin2bcd(dt.hour()),
+                       (uint8_t)(dt.dayOfTheWeek() == 0 ? 7 : dt.dayOfTheWeek()),
+                       bin2bcd(dt.day()), bin2bcd(dt.month()), bin2bcd(dt.year() - 2000U)};
+  if (!bus.writeRegister(BUS_DEVICE_RTC, RTC_REG_TIME, buffer, sizeof(buffer)))
+  {
+    this->lastErrorState = EReturn_TIME::ERROR_TIME_NO_RTC;
+    return;
+  }
+
+  uint8_t status = 0;
+  if (bus.readRegister(BUS_DEVICE_RTC, RTC_REG_STATUS, &status, 1))
+  {
+    status &= ~RTC_STATUS_OSF;
+    bus.writeRegister(BUS_DEVICE_RTC, RTC_REG_STATUS, &status, 1);
+  }
+}
+
+/*
+The oscillator stop flag is set when the RTC lost power. A status that could not be read is no RTC, not
+a running one.
+*/
+EReturn_TIME AEON_Time::readPowerRTC()
+{
+  uint8_t status = 0;
+  if (!bus.readRegister(BUS_DEVICE_RTC, RTC_REG_STATUS, &status, 1))
+  {
+    return EReturn_TIME::ERROR_TIME_NO_RTC;
+  }
+  return (status & RTC_STATUS_OSF) ? EReturn_TIME::ERROR_TIME_LOST_POWER : EReturn_TIME::TIME_RETURN_NULL;
+}
 
 /*
 Time
@@ -27,18 +106,28 @@ EReturn_TIME AEON_Time::setupTime()
   EReturn_TIME localReturn = EReturn_TIME::TIME_RETURN_NULL;
 
   Serial.println("Setup RTC");
-  if (!rtc.begin())
+  bus.attach(BUS_DEVICE_RTC, RTC_ADDRESS, BUS_PRIORITY_HIGH);
+  if (!bus.probe(BUS_DEVICE_RTC))
   {
     Serial.println("Couldn't find RTC!");
     localReturn = EReturn_TIME::ERROR_TIME_NO_RTC;
+    this->lastErrorState = localReturn;
+    return localReturn;
   }
 
-  if (rtc.lostPower())
+  localReturn = readPowerRTC();
+  if (localReturn == EReturn_TIME::ERROR_TIME_NO_RTC)
+  {
+    Serial.println("Couldn't read the RTC status!");
+    this->lastErrorState = localReturn;
+    return localReturn;
+  }
+
+  if (localReturn == EReturn_TIME::ERROR_TIME_LOST_POWER)
   {
     Serial.println("RTC lost power, lets set the time!");
-    rtc.adjust(DateTime(GLOBAL_DEFAULTS::defaultYear, GLOBAL_DEFAULTS::defaultMonth, GLOBAL_DEFAULTS::defaultDay, GLOBAL_DEFAULTS::defaultHour, GLOBAL_DEFAULTS::defaultMinute, GLOBAL_DEFAULTS::defaultSecond));
+    adjustRTC(DateTime(GLOBAL_DEFAULTS::defaultYear, GLOBAL_DEFAULTS::defaultMonth, GLOBAL_DEFAULTS::defaultDay, GLOBAL_DEFAULTS::defaultHour, GLOBAL_DEFAULTS::defaultMinute, GLOBAL_DEFAULTS::defaultSecond));
     updateTime();
-    localReturn = EReturn_TIME::ERROR_TIME_LOST_POWER; 
   }
   else
   {
@@ -52,7 +141,7 @@ Update Time
 */
 void AEON_Time::updateTime()
 {
-  DateTime now = rtc.now();
+  DateTime now = readRTC();
   
   this->year = now.year();
   this->month = now.month();
@@ -90,7 +179,7 @@ Set new Year
 */
 void AEON_Time::setYear(int value)
 {
-  DateTime now = rtc.now();
+  DateTime now = readRTC();
 
   if (value > 0)
   {
@@ -102,7 +191,7 @@ void AEON_Time::setYear(int value)
   }
 
   // Year, Month, Day, Hour, Minute, Second
-  rtc.adjust(DateTime(this->year, now.month(), now.day(), now.hour(), now.minute(), now.second()));
+  adjustRTC(DateTime(this->year, now.month(), now.day(), now.hour(), now.minute(), now.second()));
 }
 
 /*
@@ -124,7 +213,7 @@ void AEON_Time::setMonth(int value)
     return; // Do nothing if input is zero or if input is outside valid range
   }
 
-  DateTime now = rtc.now();
+  DateTime now = readRTC();
 
   int newMonth = this->month + value;
 
@@ -135,7 +224,7 @@ void AEON_Time::setMonth(int value)
   }
 
   // Create new DateTime object with adjusted month
-  rtc.adjust(DateTime(now.year(), newMonth, now.day(), now.hour(), now.minute(), now.second()));
+  adjustRTC(DateTime(now.year(), newMonth, now.day(), now.hour(), now.minute(), now.second()));
   this->month = newMonth;
 }
 
@@ -152,7 +241,7 @@ Set new Day
 */
 void AEON_Time::setDay(int value)
 {
-  DateTime now = rtc.now();
+  DateTime now = readRTC();
 
   struct tm time = {.tm_mday = 31, .tm_mon = now.month()-1, .tm_year = now.year() - 1900};
   mktime(&time);
@@ -175,7 +264,7 @@ void AEON_Time::setDay(int value)
   }
 
   // Create new DateTime object with adjusted day
-  rtc.adjust(DateTime(now.year(), now.month(), this->day, now.hour(), now.minute(), now.second()));
+  adjustRTC(DateTime(now.year(), now.month(), this->day, now.hour(), now.minute(), now.second()));
 }
 
 /*
@@ -196,7 +285,7 @@ void AEON_Time::setHour(int value)
     return; // Do nothing if input is zero or if input is outside valid range
   }
 
-  DateTime now = rtc.now();
+  DateTime now = readRTC();
   int newHour = this->hour + value;
 
   if (newHour < 0) {
@@ -206,7 +295,7 @@ void AEON_Time::setHour(int value)
   }
 
   // Create new DateTime object with adjusted hour
-  rtc.adjust(DateTime(now.year(), now.month(), now.day(), newHour, now.minute(), now.second()));
+  adjustRTC(DateTime(now.year(), now.month(), now.day(), newHour, now.minute(), now.second()));
   this->hour = newHour;
 }
 
@@ -229,7 +318,7 @@ void AEON_Time::setMinute(int value)
   }
 
 
-  DateTime now = rtc.now();
+  DateTime now = readRTC();
   int newMinute = this->minute + value;
 
   if (newMinute < 0) {
@@ -239,7 +328,7 @@ void AEON_Time::setMinute(int value)
   }
 
   // Create new DateTime object with adjusted minute
-  rtc.adjust(DateTime(now.year(), now.month(), now.day(), now.hour(), newMinute, now.second()));
+  adjustRTC(DateTime(now.year(), now.month(), now.day(), now.hour(), newMinute, now.second()));
   this->minute = newMinute;
 }
 
@@ -261,7 +350,7 @@ void AEON_Time::setSecond(int value)
     return; // Do nothing if input is zero or if input is outside valid range
   }
   
-  DateTime now = rtc.now();
+  DateTime now = readRTC();
   int newSecond = this->second + value;
 
   if (newSecond < 0) {
@@ -271,7 +360,7 @@ void AEON_Time::setSecond(int value)
   }
 
   // Create new DateTime object with adjusted second
-  rtc.adjust(DateTime(now.year(), now.month(), now.day(), now.hour(), now.minute(), newSecond));
+  adjustRTC(DateTime(now.year(), now.month(), now.day(), now.hour(), now.minute(), newSecond));
   this->second = newSecond;
 }
 
@@ -280,7 +369,7 @@ Reset the error to state return null
 */
 void AEON_Time::resetErrorStateTime()
 {
-  EReturn_TIME lastErrorState = EReturn_TIME::TIME_RETURN_NULL;
+  this->lastErrorState = EReturn_TIME::TIME_RETURN_NULL;
 }
 
 /*
@@ -332,7 +421,7 @@ EReturn_TIME AEON_Time::getErrorState()
 */
 DateTime AEON_Time::getTimeAsDateTime()
 {
-  DateTime now = rtc.now();
+  DateTime now = readRTC();
   return now;
 }
 
@@ -348,10 +437,11 @@ MMM   - the abbreviated English month name ('Jan' to 'Dec')
 DD    - the day as number with a leading zero (01 to 31)
 DDD   - the abbreviated English day name ('Mon' to 'Sun')
 */
-String AEON_Time::getTimeAsString()
+const char *AEON_Time::getTimeAsString()
 {
-  DateTime now = rtc.now();
-  
-  char buf[] = "hh:mm:ss DDD, MMM DD YYYY";
-  return now.toString(buf);
+  DateTime now = getTimeAsDateTime();
+
+  // toString() replaces the format with the time, the buffer lives in the class
+  strcpy(this->timeString, "hh:mm:ss DDD, MMM DD YYYY");
+  return now.toString(this->timeString);
 }
\ No newline at end of file
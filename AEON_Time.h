@@ -34,6 +34,12 @@ private:
 
   EReturn_TIME lastErrorState;  
 
+  char timeString[26]; // getTimeAsString()
+
+  DateTime readRTC();
+  void adjustRTC(const DateTime &dt);
+  EReturn_TIME readPowerRTC();
+
 public:
     EReturn_TIME setupTime();
     void updateTime();
@@ -59,7 +65,7 @@ public:
     EReturn_TIME getErrorState();
 
     DateTime getTimeAsDateTime();
-    String getTimeAsString();
+    const char *getTimeAsString();
 };
 
 #endif
\ No newline at end of file
@@ -0,0 +1,231 @@
+/*
+AEON_Trace.cpp
+*/
+
+#include <Arduino.h>
+#include <EEPROM.h>
+#include <pico/platform.h>
+#include <string.h>
+#include "AEON_Config.h"
+#include "AEON_Enums.h"
+#include "AEON_Time.h"
+#include "AEON_Trace.h"
+
+#define TRACE_ENCODED 16 // Longest record: type, 5 bytes time, 5 bytes value, magic and version
+
+extern AEON_Time timer;
+
+/*
+Varint, returns the bytes written
+*/
+static size_t putVarint(uint8_t *buffer, uint32_t value)
+{
+  size_t length = 0;
+  while (value >= 0x80)
+  {
+    buffer[length++] = (uint8_t)(value | 0x80);
+    value >>= 7;
+  }
+  buffer[length++] = (uint8_t)value;
+  return length;
+}
+
+static uint32_t zigzag(int32_t value)
+{
+  return ((uint32_t)value << 1) ^ (uint32_t)(value >> 31);
+}
+
+AEON_Trace::AEON_Trace()
+{
+  this->head = 0;
+  this->tail = 0;
+  this->dropped = 0;
+  this->startRequested = false;
+  this->stopRequested = false;
+  this->recording = false;
+  this->lastRtc = 0;
+  this->lastTime = 0;
+  this->lastUnix = 0;
+}
+
+/*
+Add a record to the ring (core 0), drop it if the ring is full
+*/
+void AEON_Trace::write(ETraceRecord type, uint8_t index, int32_t value)
+{
+  uint32_t head = this->head;
+  if (head - this->tail >= AEON_TRACE_RECORDS)
+  {
+    this->dropped = this->dropped + 1;
+    return;
+  }
+
+  STRACE_RECORD &record = this->records[head & (AEON_TRACE_RECORDS - 1)];
+  record.time = micros();
+  record.type = type;
+  record.index = index;
+  record.value = value;
+
+  // The record is complete before the reader sees the new head
+  __sync_synchronize();
+  this->head = head + 1;
+}
+
+/*
+Serial command, core 0 starts the recording at the next loop
+*/
+void AEON_Trace::start()
+{
+  this->startRequested = true;
+}
+
+/*
+Ask core 0 to write the end of the trace at its next service()
+*/
+void AEON_Trace::stop()
+{
+  this->stopRequested = true;
+}
+
+/*
+Start and stop on core 0, so the header and the end are in order with the other records
+*/
+void AEON_Trace::service()
+{
+#if AEON_TRACE
+  if (this->stopRequested)
+  {
+    this->stopRequested = false;
+    if (this->recording)
+    {
+      this->recording = false;
+      write(TRACE_END, 0, this->dropped);
+    }
+  }
+
+  // A new recording waits until the last one is written
+  if (this->startRequested && !isActive())
+  {
+    this->startRequested = false;
+    this->dropped = 0;
+
+    this->lastRtc = timer.getUnixTime();
+    write(TRACE_START, 0, this->lastRtc);
+    for (int offset = 0; offset < AEON_TRACE_ROM; offset += 4)
+    {
+      int32_t bytes = EEPROM.read(offset) | (EEPROM.read(offset + 1) << 8) | (EEPROM.read(offset + 2) << 16) | ((uint32_t)EEPROM.read(offset + 3) << 24);
+      write(TRACE_ROM, offset, bytes);
+    }
+    this->recording = true;
+  }
+#endif
+}
+
+/*
+Edge on a button pin, seen by loopButton()
+*/
+void AEON_Trace::button(uint8_t pin, bool level)
+{
+  if (this->recording && get_core_num() == 0)
+  {
+    write(TRACE_BUTTON, pin, level);
+  }
+}
+
+/*
+Time read from the RTC, the replay keeps it running in between
+*/
+void AEON_Trace::rtc(uint32_t unixTime)
+{
+  if (this->recording && get_core_num() == 0 && unixTime != this->lastRtc)
+  {
+    this->lastRtc = unixTime;
+    write(TRACE_RTC, 0, (int32_t)unixTime);
+  }
+}
+
+/*
+Binary form of a record, see AEON_Trace.h
+*/
+size_t AEON_Trace::encode(const STRACE_RECORD &record, uint8_t *buffer)
+{
+  size_t length = 0;
+
+  if (record.type == TRACE_START)
+  {
+    memcpy(buffer, TRACE_MAGIC, 4);
+    buffer[4] = TRACE_VERSION;
+    length = 5;
+    this->lastTime = record.time;
+    this->lastUnix = record.value;
+  }
+
+  buffer[length++] = record.type;
+  length += putVarint(buffer + length, record.time - this->lastTime);
+  this->lastTime = record.time;
+
+  switch (record.type)
+  {
+  case TRACE_START:
+  case TRACE_END:
+    length += putVarint(buffer + length, (uint32_t)record.value);
+    break;
+
+  case TRACE_ROM:
+    buffer[length++] = record.index;
+    for (int i = 0; i < 4; i++)
+    {
+      buffer[length++] = (uint8_t)((uint32_t)record.value >> (8 * i));
+    }
+    break;
+
+  case TRACE_BUTTON:
+    buffer[length++] = (uint8_t)((record.index << 1) | (record.value ? 1 : 0));
+    break;
+
+  case TRACE_RTC:
+    length += putVarint(buffer + length, zigzag(record.value - this->lastUnix));
+    this->lastUnix = record.value;
+    break;
+  }
+  return length;
+}
+
+/*
+Write a few records while a host is connected (core 1, loop1)
+*/
+void AEON_Trace::drain()
+{
+  if (!Serial)
+  {
+    return;
+  }
+
+  uint8_t buffer[TRACE_ENCODED];
+  for (int i = 0; i < AEON_LOG_DRAIN; i++)
+  {
+    uint32_t tail = this->tail;
+    if (tail == this->head || Serial.availableForWrite() < TRACE_ENCODED)
+    {
+      return;
+    }
+
+    __sync_synchronize();
+    STRACE_RECORD record = this->records[tail & (AEON_TRACE_RECORDS - 1)];
+
+    // The copy is done before the writer can reuse the slot
+    __sync_synchronize();
+    this->tail = tail + 1;
+
+    size_t length = encode(record, buffer);
+    Serial.write(buffer, length);
+  }
+}
+
+/*
+Recording, or records left to write
+*/
+bool AEON_Trace::isActive()
+{
+  return this->recording || this->tail != this->head;
+}
@@ -0,0 +1,87 @@
+/*
+AEON_Trace.h - Records the inputs of the firmware for a replay on the host (extras/host, aeon_replay).
+"trace start" on Serial starts a recording, "trace stop" ends it. Core 0 notes every edge a button pin shows
+to loopButton() and every time read from the RTC, with its micros() timestamp, in a ring. Core 1 encodes the
+records and writes them over Serial as a binary stream; the text log pauses until the trace is written.
+At the start the first AEON_TRACE_ROM bytes of the EEPROM (the settings) are recorded, so the replay starts
+with the same birthday, sex, lifespan and language. The buttons are expected to be released at the start.
+
+Stream: "AETR", a version byte, then records. Every record is a type byte and the microseconds since the
+last record (varint), followed by:
+
+  TRACE_START  unix time of the RTC (varint)
+  TRACE_ROM    offset (byte), 4 bytes of the EEPROM
+  TRACE_BUTTON pin << 1 | level (byte)
+  TRACE_RTC    seconds since the last RTC record (zigzag varint), only when the time changed
+  TRACE_END    records dropped because the ring was full (varint)
+
+Varints are little endian groups of 7 bits, bit 7 set when another byte follows. A button edge takes about
+4 bytes, an RTC reading (one per second) about 4. With AEON_TRACE 0 nothing is recorded.
+*/
+
+#ifndef AEON_TRACE_h
+#define AEON_TRACE_h
+
+#include <Arduino.h>
+#include "AEON_Config.h"
+#include "AEON_Enums.h"
+
+#define TRACE_MAGIC "AETR"
+#define TRACE_VERSION 1
+
+static_assert((AEON_TRACE_RECORDS & (AEON_TRACE_RECORDS - 1)) == 0, "AEON_TRACE_RECORDS must be a power of two");
+
+typedef struct
+{
+  uint32_t time; // micros()
+  uint8_t type;  // ETraceRecord
+  uint8_t index; // Pin or EEPROM offset
+  int32_t value;
+} STRACE_RECORD;
+
+class AEON_Trace
+{
+private:
+  STRACE_RECORD records[AEON_TRACE_RECORDS];
+  volatile uint32_t head; // Written by core 0
+  volatile uint32_t tail; // Written by drain()
+  volatile uint32_t dropped;
+
+  volatile bool startRequested;
+  volatile bool stopRequested;
+  volatile bool recording;
+  uint32_t lastRtc; // Last RTC time recorded (core 0)
+
+  // State of the encoder (core 1)
+  uint32_t lastTime;
+  int32_t lastUnix;
+
+  void write(ETraceRecord type, uint8_t index, int32_t value);
+  size_t encode(const STRACE_RECORD &record, uint8_t *buffer);
+
+public:
+  AEON_Trace();
+
+  // Core 1, serial commands
+  void start();
+  void stop();
+
+  // Core 0
+  void service();
+  void button(uint8_t pin, bool level);
+  void rtc(uint32_t unixTime);
+
+  // Core 1, loop1
+  void drain();
+  bool isActive();
+};
+
+extern AEON_Trace trace;
+
+#if AEON_TRACE
+#define TRACE(call) trace.call
+#else
+#define TRACE(call)
+#endif
+
+#endif
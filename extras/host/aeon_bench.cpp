@@ -0,0 +1,83 @@
+/*
+aeon_bench.cpp - Runs the benchmarks of AEON_Bench on the host and prints the JSON.
+
+The firmware boots on the virtual clock with the Serial output muted, then the clock is
+switched to the host clock and AEON_Bench runs all benchmarks, including the ones that
+change the settings and the state (EEPROM, state machine). The host build counts every
+allocation, so allocs_per_op is filled in.
+
+Usage: aeon_bench [output.json]
+*/
+
+#include <Arduino.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include "AEON_Host.h"
+#include "AEON_HostI2C.h"
+#include "AEON_HostDS3231.h"
+#include "AEON_HostOLED.h"
+#include "AEON_Bench.h"
+
+// AEON.ino
+void setup();
+void loop();
+void setup1();
+void loop1();
+
+extern AEON_Bench bench;
+
+class AEON_HostFilePrint : public Print
+{
+private:
+  FILE *file;
+
+public:
+  AEON_HostFilePrint(FILE *file) : file(file) {}
+
+  size_t write(uint8_t c) override { return fputc(c, file) == EOF ? 0 : 1; }
+  size_t write(const uint8_t *buffer, size_t size) override { return fwrite(buffer, 1, size, file); }
+};
+
+int main(int argc, char **argv)
+{
+  FILE *file = argc > 1 ? fopen(argv[1], "w") : stdout;
+  if (!file)
+  {
+    perror(argv[1]);
+    return 1;
+  }
+
+  setenv("TZ", "UTC", 1);
+  tzset();
+
+  AEON_HostClock::setVirtual(true);
+  AEON_HostSerial::setMuted(true);
+
+  static AEON_HostDS3231 rtc;
+  static AEON_HostOLED oled;
+  rtc.setUnixTime(1700000000UL);
+  rtc.setLostPower(false);
+  AEON_HostI2C::attach(AEON_HostDS3231::ADDRESS, &rtc);
+  AEON_HostI2C::attach(AEON_HostOLED::ADDRESS, &oled);
+
+  setup();
+  setup1();
+  for (int i = 0; i < 100; i++)
+  {
+    loop();
+    loop1();
+    AEON_HostClock::advanceMicros(1000);
+  }
+
+  AEON_HostClock::setVirtual(false);
+
+  AEON_HostFilePrint out(file);
+  bench.run(out, true);
+
+  if (file != stdout)
+  {
+    fclose(file);
+  }
+  return 0;
+}
@@ -0,0 +1,241 @@
+/*
+aeon_flash.cpp - Commit latency, wear and power-cut consistency of the settings store (AEON_ROM) on the
+NOR flash model of the host build (shim/AEON_HostFlash.h).
+
+  save    One saveToEEPROM() with changed settings: commits, sector erases, bytes programmed and the
+          time the flash is busy (both cores of the RP2040 stand still for it). The wear gives the
+          saves until the sector reaches its erase endurance and the years at --saves-per-day.
+  sweep   The same save with the power cut at every --stride'th operation byte (every byte with 1),
+          then a boot from what is left in the flash. The settings after the boot must be the old or
+          the new ones. Defaults (the signature was lost) are counted as lost settings, anything else
+          is inconsistent.
+
+The exit code is 1 when a cut leaves inconsistent settings.
+
+Usage: aeon_flash [--stride n] [--saves-per-day n]
+*/
+
+#include <Arduino.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "AEON_Host.h"
+#include "AEON_HostFlash.h"
+#include "AEON_HostEEPROM.h"
+#include "AEON_Enums.h"
+#include "AEON_ROM.h"
+#include "AEON_Lifespan.h"
+
+#define SWEEP_SAMPLES 5 // Inconsistent cuts that are printed
+
+typedef struct
+{
+  int init;
+  int year;
+  int month;
+  int day;
+  int sex;
+  int lifespan;
+  int language;
+  int country;
+} SFLASH_SETTINGS;
+
+enum EFlashOutcome
+{
+  FLASH_OLD,
+  FLASH_NEW,
+  FLASH_DEFAULTS,
+  FLASH_INCONSISTENT,
+  FLASH_OUTCOME_Count
+};
+
+static const char *const outcomeNames[FLASH_OUTCOME_Count] = {"old settings", "new settings", "defaults (settings lost)", "inconsistent"};
+
+/*
+Settings as the firmware sees them after a boot
+*/
+static SFLASH_SETTINGS readSettings(AEON_ROM &rom)
+{
+  SFLASH_SETTINGS settings;
+  settings.init = rom.getInit();
+  settings.year = rom.getBirthdayYear();
+  settings.month = rom.getBirthdayMonth();
+  settings.day = rom.getBirthdayDay();
+  settings.sex = rom.getSex();
+  settings.lifespan = (rom.getSex() == Female || rom.getSex() == Male) ? rom.getLifespan() : -1;
+  settings.language = rom.getLanguage();
+  settings.country = AEON_Lifespan::code(rom.getCountry());
+  return settings;
+}
+
+static bool equal(const SFLASH_SETTINGS &a, const SFLASH_SETTINGS &b)
+{
+  return memcmp(&a, &b, sizeof(a)) == 0;
+}
+
+static void printSettings(const SFLASH_SETTINGS &settings)
+{
+  printf("birthday %d-%02d-%02d, sex %d, lifespan %d, language %d, country %c%c", settings.year, settings.month + 1,
+         settings.day, settings.sex, settings.lifespan, settings.language, settings.country >> 8, settings.country & 0xFF);
+}
+
+/*
+setupEEPROM() on the flash as it is, like the boot does
+*/
+static SFLASH_SETTINGS boot(AEON_ROM &rom)
+{
+  rom.setupEEPROM();
+  return readSettings(rom);
+}
+
+static void usage()
+{
+  fprintf(stderr, "Usage: aeon_flash [--stride n] [--saves-per-day n]\n");
+  exit(2);
+}
+
+int main(int argc, char **argv)
+{
+  uint32_t stride = 1;
+  uint32_t savesPerDay = 10;
+
+  for (int i = 1; i < argc; i++)
+  {
+    if (strcmp(argv[i], "--stride") == 0 && i + 1 < argc)
+    {
+      stride = (uint32_t)strtoul(argv[++i], NULL, 10);
+    }
+    else if (strcmp(argv[i], "--saves-per-day") == 0 && i + 1 < argc)
+    {
+      savesPerDay = (uint32_t)strtoul(argv[++i], NULL, 10);
+    }
+    else
+    {
+      usage();
+    }
+  }
+  if (stride == 0 || savesPerDay == 0)
+  {
+    usage();
+  }
+
+  setenv("TZ", "UTC", 1);
+  tzset();
+  AEON_HostClock::setVirtual(true);
+  AEON_HostSerial::setMuted(true);
+  AEON_HostFlash::setTimed(true);
+  AEON_HostEEPROM::erase();
+
+  // First boot writes the defaults
+  AEON_ROM first{};
+  SFLASH_SETTINGS defaults = boot(first);
+
+  // Old settings, saved
+  AEON_ROM old(first);
+  for (int i = 0; i < 7; i++)
+  {
+    old.setBirthdayYear(-1);
+  }
+  for (int i = 0; i < 4; i++)
+  {
+    old.setBirthdayMonth(-1);
+  }
+  for (int i = 0; i < 9; i++)
+  {
+    old.setBirthdayDay(+1);
+  }
+  old.setLanguage(+1);
+  old.saveToEEPROM();
+  SFLASH_SETTINGS oldSettings = readSettings(old);
+
+  static uint8_t oldImage[AEON_HostFlash::SIZE];
+  memcpy(oldImage, AEON_HostFlash::getData(), sizeof(oldImage));
+
+  // New settings, the save that is measured and cut
+  AEON_ROM changed(old);
+  for (int i = 0; i < 5; i++)
+  {
+    changed.setBirthdayYear(+1);
+  }
+  changed.setBirthdayMonth(+1);
+  changed.switchSex();
+  changed.setCountry(+1);
+  for (int i = 0; i < 3; i++)
+  {
+    changed.setLifespan(+1);
+  }
+  changed.setLanguage(+1);
+  SFLASH_SETTINGS newSettings = readSettings(changed);
+
+  uint32_t sector = AEON_HostFlash::EEPROM_OFFSET / AEON_HostFlash::SECTOR_SIZE;
+  uint32_t commits = AEON_HostEEPROM::getCommitCount();
+  uint32_t erases = AEON_HostFlash::getEraseCount(sector);
+  uint64_t programmed = AEON_HostFlash::getBytesProgrammed();
+  uint64_t busy = AEON_HostFlash::getBusyMicros();
+  uint64_t operations = AEON_HostFlash::getOperationBytes();
+  unsigned long start = micros();
+
+  AEON_ROM saving(changed);
+  saving.saveToEEPROM();
+
+  unsigned long elapsed = micros() - start;
+  commits = AEON_HostEEPROM::getCommitCount() - commits;
+  erases = AEON_HostFlash::getEraseCount(sector) - erases;
+  programmed = AEON_HostFlash::getBytesProgrammed() - programmed;
+  busy = AEON_HostFlash::getBusyMicros() - busy;
+  operations = AEON_HostFlash::getOperationBytes() - operations;
+
+  printf("Save: %u commits, %u sector erases, %llu bytes programmed, flash busy %.1f ms (save %.1f ms)\n", commits, erases,
+         (unsigned long long)programmed, busy / 1000.0, elapsed / 1000.0);
+  if (erases)
+  {
+    uint32_t saves = AEON_HostFlash::ENDURANCE / erases;
+    printf("Wear: %u saves until %u erases of the sector, %.1f years at %u saves per day\n", saves,
+           AEON_HostFlash::ENDURANCE, saves / (savesPerDay * 365.0), savesPerDay);
+  }
+
+  // Power cut sweep
+  AEON_HostFlash::setTimed(false);
+  uint32_t outcomes[FLASH_OUTCOME_Count] = {};
+  uint32_t cuts = 0;
+  int samples = 0;
+
+  for (uint64_t cut = 0; cut < operations; cut += stride)
+  {
+    AEON_HostFlash::setData(oldImage);
+    AEON_HostFlash::restorePower();
+
+    AEON_ROM cutting(changed);
+    AEON_HostFlash::setPowerCut(cut);
+    cutting.saveToEEPROM();
+    AEON_HostFlash::restorePower();
+
+    AEON_ROM booted{};
+    SFLASH_SETTINGS settings = boot(booted);
+
+    EFlashOutcome outcome = equal(settings, oldSettings) ? FLASH_OLD : equal(settings, newSettings) ? FLASH_NEW
+                                                                   : equal(settings, defaults)      ? FLASH_DEFAULTS
+                                                                                                    : FLASH_INCONSISTENT;
+    outcomes[outcome]++;
+    cuts++;
+
+    if (outcome == FLASH_INCONSISTENT && samples++ < SWEEP_SAMPLES)
+    {
+      // A commit erases the sector, then programs it
+      uint64_t commit = cut / (2 * AEON_HostFlash::SECTOR_SIZE);
+      uint64_t offset = cut % (2 * AEON_HostFlash::SECTOR_SIZE);
+      printf("  cut in commit %llu, %s byte %llu: ", (unsigned long long)commit + 1, offset < AEON_HostFlash::SECTOR_SIZE ? "erase" : "program",
+             (unsigned long long)(offset % AEON_HostFlash::SECTOR_SIZE));
+      printSettings(settings);
+      printf("\n");
+    }
+  }
+
+  printf("Power cut: %u cuts over %llu operation bytes (stride %u)\n", cuts, (unsigned long long)operations, stride);
+  for (int i = 0; i < FLASH_OUTCOME_Count; i++)
+  {
+    printf("  %-26s %u\n", outcomeNames[i], outcomes[i]);
+  }
+  return outcomes[FLASH_INCONSISTENT] ? 1 : 0;
+}
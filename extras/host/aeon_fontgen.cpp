@@ -0,0 +1,163 @@
+/*
+aeon_fontgen.cpp - Generates the glyph subset of AEON_Font (AEON_FontGlyphs.h) from the string packs.
+
+All texts, weekdays and months of every built-in language pack are decoded, every character above
+ASCII needs a glyph. The glyphs come from AEON_HostGlyphs (shim/). Only the glyphs of characters the
+packs use are written, with a flat index over the range from the first to the last one.
+
+  aeon_fontgen <AEON_FontGlyphs.h>           write the subset
+  aeon_fontgen --check <AEON_FontGlyphs.h>   exit code 1 when the file is not the subset of the packs
+
+The exit code is 1 as well when a pack uses a character without a glyph here.
+*/
+
+#include <Arduino.h>
+#include <stdio.h>
+#include <string.h>
+#include <fstream>
+#include <iterator>
+#include <set>
+#include <sstream>
+#include <string>
+#include "AEON_Enums.h"
+#include "AEON_Strings.h"
+#include "AEON_Font.h"
+#include "AEON_HostGlyphs.h"
+
+extern AEON_Strings strings;
+
+static void collect(const char *text, std::set<uint32_t> &characters)
+{
+  uint32_t character;
+  while ((character = AEON_Font::next(&text)))
+  {
+    if (character >= 0x80)
+    {
+      characters.insert(character);
+    }
+  }
+}
+
+static void usage()
+{
+  fprintf(stderr, "Usage: aeon_fontgen [--check] <AEON_FontGlyphs.h>\n");
+  exit(2);
+}
+
+int main(int argc, char **argv)
+{
+  bool check = false;
+  const char *path = NULL;
+
+  for (int i = 1; i < argc; i++)
+  {
+    if (strcmp(argv[i], "--check") == 0)
+    {
+      check = true;
+    }
+    else if (path == NULL && argv[i][0] != '-')
+    {
+      path = argv[i];
+    }
+    else
+    {
+      usage();
+    }
+  }
+  if (path == NULL)
+  {
+    usage();
+  }
+
+  // Characters of all packs
+  std::set<uint32_t> characters;
+  for (int language = 0; language < ELanguage::Count; language++)
+  {
+    strings.setLanguage((ELanguage)language);
+    for (int string = 0; string < (int)AEON_Strings::EStrings::Count; string++)
+    {
+      collect(strings.getString((AEON_Strings::EStrings)string), characters);
+    }
+    for (int weekday = 0; weekday < 7; weekday++)
+    {
+      collect(strings.getWeekday(weekday), characters);
+    }
+    for (int month = 0; month < 12; month++)
+    {
+      collect(strings.getMonth(month), characters);
+    }
+  }
+
+  bool missing = false;
+  std::ostringstream glyphs;
+  for (uint32_t character : characters)
+  {
+    uint8_t columns[5];
+    if (!AEON_HostGlyphs::getColumns(character, columns))
+    {
+      fprintf(stderr, "U+%04X is used by the string packs but has no glyph\n", character);
+      missing = true;
+      continue;
+    }
+
+    char line[80];
+    snprintf(line, sizeof(line), "    {0x%02X, 0x%02X, 0x%02X, 0x%02X, 0x%02X}, // U+%04X ", columns[0], columns[1], columns[2],
+             columns[3], columns[4], character);
+    glyphs << line << AEON_HostGlyphs::toUtf8(character) << "\n";
+  }
+  if (missing)
+  {
+    return 1;
+  }
+
+  // Flat index over the range, an empty subset keeps one entry so the arrays are not empty
+  uint32_t first = characters.empty() ? 0x80 : *characters.begin();
+  uint32_t span = characters.empty() ? 1 : *characters.rbegin() - first + 1;
+
+  std::ostringstream out;
+  out << "/*\n"
+         "AEON_FontGlyphs.h - Glyphs of AEON_Font for the characters of the string packs above ASCII.\n"
+         "Generated by aeon_fontgen (extras/host) from AEON_Strings.cpp, do not edit.\n"
+         "*/\n\n"
+         "#ifndef AEON_FONT_GLYPHS_h\n"
+         "#define AEON_FONT_GLYPHS_h\n\n";
+  out << "#define FONT_FIRST 0x" << std::hex << std::uppercase << first << "\n";
+  out << "#define FONT_SPAN " << std::dec << span << "\n\n";
+
+  out << "static const uint8_t fontGlyphs[][5] = {\n";
+  out << (characters.empty() ? "    {0x00, 0x00, 0x00, 0x00, 0x00},\n" : glyphs.str());
+  out << "};\n\n";
+
+  out << "// Glyph + 1 of FONT_FIRST + i, 0 = no glyph\n";
+  out << "static const uint8_t fontIndex[FONT_SPAN] = {";
+  uint32_t glyph = 0;
+  for (uint32_t i = 0; i < span; i++)
+  {
+    out << (i % 16 == 0 ? "\n    " : " ");
+    out << (characters.count(first + i) ? ++glyph : 0) << ",";
+  }
+  out << "\n};\n\n#endif\n";
+
+  if (check)
+  {
+    std::ifstream in(path, std::ios::binary);
+    std::string current((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+    if (current != out.str())
+    {
+      fprintf(stderr, "%s is not the glyph subset of the string packs, run aeon_fontgen %s\n", path, path);
+      return 1;
+    }
+    printf("%s: %u glyphs, up to date\n", path, (unsigned)characters.size());
+    return 0;
+  }
+
+  std::ofstream file(path, std::ios::binary);
+  file << out.str();
+  if (!file)
+  {
+    fprintf(stderr, "Cannot write %s\n", path);
+    return 1;
+  }
+  printf("%s: %u glyphs\n", path, (unsigned)characters.size());
+  return 0;
+}
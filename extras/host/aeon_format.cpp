@@ -0,0 +1,170 @@
+/*
+aeon_format.cpp - Exact match check of AEON_Format against snprintf.
+
+Random values (all digit counts, the limits of long and 0) go through number() with every width from 0
+to AEON_FORMAT_WIDTHS, '0' and ' ' padding and with and without the sign, after a random prefix into
+buffers of every size from 0 to the full text. The same text is written by snprintf with "%ld",
+"%02ld", "%4ld", "%+03ld" and so on, both buffers must hold the same bytes up to the terminator.
+grouped() is compared with snprintf "%0*ld" of every width and a separator put in between the groups
+of three, the separator '\0' with the plain digits. The first difference is printed.
+
+Usage: aeon_format [--iterations N] [--seed N]
+*/
+
+#include <Arduino.h>
+#include <limits.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "AEON_Format.h"
+
+#define AEON_FORMAT_WIDTHS 24
+#define AEON_FORMAT_BUFFER 64
+
+static uint64_t randomState;
+
+/*
+xorshift64, the same seed always gives the same values
+*/
+static uint64_t nextRandom()
+{
+  randomState ^= randomState << 13;
+  randomState ^= randomState >> 7;
+  randomState ^= randomState << 17;
+  return randomState;
+}
+
+/*
+A value with a random count of digits, so the short ones are as frequent as the long ones
+*/
+static long randomValue()
+{
+  switch (nextRandom() % 16)
+  {
+  case 0:
+    return LONG_MIN;
+  case 1:
+    return LONG_MAX;
+  case 2:
+    return 0;
+  default:
+    break;
+  }
+
+  unsigned bits = 1 + (unsigned)(nextRandom() % (sizeof(long) * 8 - 1));
+  long value = (long)(nextRandom() >> (64 - bits));
+  return (nextRandom() & 1) ? -value : value;
+}
+
+static bool compare(const char *call, const char *expected, const char *actual, size_t size)
+{
+  if (size == 0 ? actual[0] == 'X' : strcmp(expected, actual) == 0)
+  {
+    return true;
+  }
+  printf("%s, buffer %u: \"%s\" instead of \"%s\"\n", call, (unsigned)size, actual, expected);
+  return false;
+}
+
+static bool checkNumber(long value, uint8_t width, char pad, bool sign, const char *prefix, size_t size)
+{
+  // "%s%+05ld" for a pad of '0', "%s%+5ld" for ' '
+  char format[16];
+  if (width == 0)
+  {
+    snprintf(format, sizeof(format), "%%s%%%sld", sign ? "+" : "");
+  }
+  else
+  {
+    snprintf(format, sizeof(format), "%%s%%%s%s%uld", sign ? "+" : "", pad == '0' ? "0" : "", (unsigned)width);
+  }
+
+  char expected[AEON_FORMAT_BUFFER];
+  char actual[AEON_FORMAT_BUFFER];
+  memset(expected, 'X', sizeof(expected));
+  memset(actual, 'X', sizeof(actual));
+  snprintf(expected, size, format, prefix, value);
+  AEON_Format(actual, size).text(prefix).number(value, width, pad, sign);
+
+  char call[96];
+  snprintf(call, sizeof(call), "text(\"%s\").number(%ld, %u, '%c', %s) / \"%s\"", prefix, value, (unsigned)width, pad,
+           sign ? "true" : "false", format);
+  return compare(call, expected, actual, size);
+}
+
+static bool checkGrouped(long value, char separator, uint8_t width, size_t size)
+{
+  char digits[AEON_FORMAT_BUFFER];
+  int length = snprintf(digits, sizeof(digits), "%0*ld", (int)width, value);
+  int first = digits[0] == '-' ? 1 : 0;
+
+  char full[AEON_FORMAT_BUFFER];
+  int position = 0;
+  for (int i = 0; i < length; i++)
+  {
+    full[position++] = digits[i];
+    int left = length - i - 1;
+    if (separator != '\0' && i >= first && left > 0 && left % 3 == 0)
+    {
+      full[position++] = separator;
+    }
+  }
+  full[position] = '\0';
+
+  char expected[AEON_FORMAT_BUFFER];
+  char actual[AEON_FORMAT_BUFFER];
+  memset(expected, 'X', sizeof(expected));
+  memset(actual, 'X', sizeof(actual));
+  snprintf(expected, size, "%s", full);
+  AEON_Format(actual, size).grouped(value, separator, width);
+
+  char call[64];
+  snprintf(call, sizeof(call), "grouped(%ld, 0x%02X, %u)", value, (unsigned)separator, (unsigned)width);
+  return compare(call, expected, actual, size);
+}
+
+int main(int argc, char **argv)
+{
+  static const char *const prefixes[] = {"", "T", "Day "};
+  static const char separators[] = {',', '.', ' ', '\0'};
+  unsigned long iterations = 50000;
+  randomState = 0xAE0AF0A7ULL;
+
+  for (int i = 1; i < argc; i++)
+  {
+    if (strcmp(argv[i], "--iterations") == 0 && i + 1 < argc)
+    {
+      iterations = strtoul(argv[++i], NULL, 0);
+    }
+    else if (strcmp(argv[i], "--seed") == 0 && i + 1 < argc)
+    {
+      randomState = strtoull(argv[++i], NULL, 0) | 1;
+    }
+    else
+    {
+      fprintf(stderr, "Usage: aeon_format [--iterations N] [--seed N]\n");
+      return 2;
+    }
+  }
+
+  for (unsigned long i = 0; i < iterations; i++)
+  {
+    long value = randomValue();
+    uint8_t width = (uint8_t)(nextRandom() % (AEON_FORMAT_WIDTHS + 1));
+    char pad = (nextRandom() & 1) ? '0' : ' ';
+    bool sign = nextRandom() & 1;
+    const char *prefix = prefixes[nextRandom() % 3];
+
+    // Every size up to the whole text, the last ones are not cut (the separators of grouped() included)
+    for (size_t size = 0; size <= strlen(prefix) + AEON_FORMAT_WIDTHS + 10 && size <= AEON_FORMAT_BUFFER; size++)
+    {
+      if (!checkNumber(value, width, pad, sign, prefix, size) || !checkGrouped(value, separators[i % 4], width, size))
+      {
+        return 1;
+      }
+    }
+  }
+
+  printf("%lu values, number() and grouped() match snprintf\n", iterations);
+  return 0;
+}
@@ -0,0 +1,398 @@
+/*
+aeon_fsm.cpp - Checks the menu graph of the firmware (the FSM built in setup()) on the host build.
+
+The firmware boots on the virtual clock, then the tool works on the real state machine:
+
+  check    Every state reachable from Base and ERROR gets every event, on the real FSM with its callbacks.
+           Reported: the table, states and transitions with an id outside of the tables of the FSM,
+           states that are not defined or not reachable, dead ends (no way back to Base), transitions
+           to undefined states, callbacks that change the state on their own and events without a
+           transition (the state stays as it is).
+  --fuzz   Random events, a loop every few events so the page of the state is drawn, now and then a jump
+           to ERROR. The state must stay a defined one. Build with -DAEON_HOST_SANITIZE=ON to run it under
+           ASan and UBSan.
+  --bench  Dispatches per second: the engine alone (same graph, no callbacks) and the firmware FSM.
+
+The exit code is 1 when the check or the fuzzer found an error, missing transitions are only listed.
+
+Usage: aeon_fsm [--fuzz events] [--seed n] [--bench]
+*/
+
+#include <Arduino.h>
+#include <chrono>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "AEON_Host.h"
+#include "AEON_HostI2C.h"
+#include "AEON_HostDS3231.h"
+#include "AEON_HostEEPROM.h"
+#include "AEON_HostOLED.h"
+#include "AEON_Enums.h"
+#include "AEON_FSM.h"
+
+#define CHECK_STATES (STATE_ERROR + 1)
+#define CHECK_EVENTS (EVENT_OK + 1)
+#define FUZZ_LOOP_EVERY 8          // Events between two loops
+#define FUZZ_ERROR_EVERY 1024      // Events between two jumps to ERROR, as the loop does on an error
+#define BENCH_SEQUENCE 4096        // Random events, repeated
+#define BENCH_TIME 500000          // Microseconds per measurement
+
+// AEON.ino
+void setup();
+void loop();
+void setup1();
+void loop1();
+
+extern FSM fsm;
+
+static uint32_t rngState;
+
+/*
+xorshift32, the same seed gives the same events
+*/
+static uint32_t rng()
+{
+  rngState ^= rngState << 13;
+  rngState ^= rngState >> 17;
+  rngState ^= rngState << 5;
+  return rngState;
+}
+
+static void runLoops(int count)
+{
+  for (int i = 0; i < count; i++)
+  {
+    loop();
+    loop1();
+    AEON_HostClock::advanceMicros(1000);
+  }
+}
+
+static void boot()
+{
+  setenv("TZ", "UTC", 1);
+  tzset();
+
+  AEON_HostClock::setVirtual(true);
+  AEON_HostSerial::setMuted(true);
+  AEON_HostSerial::setConnected(false);
+  AEON_HostEEPROM::erase();
+
+  static AEON_HostDS3231 rtc;
+  static AEON_HostOLED oled;
+  rtc.setUnixTime(1706500000); // 2024-01-29
+  rtc.setLostPower(false);
+  AEON_HostI2C::attach(AEON_HostDS3231::ADDRESS, &rtc);
+  AEON_HostI2C::attach(AEON_HostOLED::ADDRESS, &oled);
+
+  setup();
+  setup1();
+  runLoops(100);
+}
+
+/*
+Dispatch one event from a state on the real FSM, the state it ends in
+*/
+static StateId step(StateId state, EventId event)
+{
+  fsm.setCurrentStateId(state);
+  fsm.dispatch(event);
+  return fsm.getCurrentStateId();
+}
+
+/*
+Explore the graph from the entry states, print the table and the findings. Number of errors.
+*/
+static int check()
+{
+  StateId observed[CHECK_STATES][CHECK_EVENTS];
+  bool reachable[CHECK_STATES] = {};
+  StateId queue[CHECK_STATES];
+  int head = 0;
+  int tail = 0;
+  int errors = 0;
+  int missing = 0;
+
+  // Base after the boot, ERROR when the boot or the loop finds an error
+  const StateId entries[] = {STATE_Base, STATE_ERROR};
+  for (StateId entry : entries)
+  {
+    reachable[entry] = true;
+    queue[tail++] = entry;
+  }
+
+  while (head < tail)
+  {
+    StateId state = queue[head++];
+    for (EventId event = 0; event < CHECK_EVENTS; event++)
+    {
+      StateId next = step(state, event);
+      observed[state][event] = next;
+      if (next >= 0 && next < CHECK_STATES && !reachable[next])
+      {
+        reachable[next] = true;
+        queue[tail++] = next;
+      }
+    }
+  }
+  fsm.setCurrentStateId(STATE_Base);
+
+  // Table
+  printf("%-22s", "State");
+  for (EventId event = 0; event < CHECK_EVENTS; event++)
+  {
+    printf(" %-22s", fsm.getEventName(event));
+  }
+  printf("\n");
+  for (StateId state = 0; state < CHECK_STATES; state++)
+  {
+    if (!reachable[state])
+    {
+      continue;
+    }
+    printf("%-22s", fsm.getStateName(state));
+    for (EventId event = 0; event < CHECK_EVENTS; event++)
+    {
+      printf(" %-22s", fsm.hasTransition(state, event) ? fsm.getStateName(observed[state][event]) : "-");
+    }
+    printf("\n");
+  }
+  printf("\n");
+
+  if (fsm.getRejected() > 0)
+  {
+    printf("error: %d states or transitions with an id outside of AEON_FSM_STATES or AEON_FSM_EVENTS\n", fsm.getRejected());
+    errors += fsm.getRejected();
+  }
+
+  for (StateId state = 0; state < CHECK_STATES; state++)
+  {
+    if (!fsm.hasState(state))
+    {
+      printf("error: %s is not defined\n", fsm.getStateName(state));
+      errors++;
+      continue;
+    }
+    if (!reachable[state])
+    {
+      printf("error: %s is not reachable\n", fsm.getStateName(state));
+      errors++;
+      continue;
+    }
+
+    for (EventId event = 0; event < CHECK_EVENTS; event++)
+    {
+      StateId next = observed[state][event];
+      if (!fsm.hasTransition(state, event))
+      {
+        printf("missing: %s has no transition for %s\n", fsm.getStateName(state), fsm.getEventName(event));
+        missing++;
+      }
+      else if (!fsm.hasState(next))
+      {
+        printf("error: %s + %s leads to the undefined state %d\n", fsm.getStateName(state), fsm.getEventName(event), next);
+        errors++;
+      }
+      else if (!fsm.hasGuard(state, event) && next != fsm.getNextStateId(state, event))
+      {
+        printf("error: %s + %s ends in %s, the table says %s\n", fsm.getStateName(state), fsm.getEventName(event),
+               fsm.getStateName(next), fsm.getStateName(fsm.getNextStateId(state, event)));
+        errors++;
+      }
+    }
+  }
+
+  // Dead ends: Base can not be reached again, backwards from Base over the observed edges
+  bool returns[CHECK_STATES] = {};
+  returns[STATE_Base] = true;
+  for (bool changed = true; changed;)
+  {
+    changed = false;
+    for (StateId state = 0; state < CHECK_STATES; state++)
+    {
+      for (EventId event = 0; event < CHECK_EVENTS && reachable[state] && !returns[state]; event++)
+      {
+        StateId next = observed[state][event];
+        if (next >= 0 && next < CHECK_STATES && returns[next])
+        {
+          returns[state] = true;
+          changed = true;
+        }
+      }
+    }
+  }
+  for (StateId state = 0; state < CHECK_STATES; state++)
+  {
+    if (reachable[state] && !returns[state])
+    {
+      printf("error: %s is a dead end, Base can not be reached from it\n", fsm.getStateName(state));
+      errors++;
+    }
+  }
+
+  printf("%d states reachable, %d errors, %d missing transitions\n", tail, errors, missing);
+  return errors;
+}
+
+/*
+Random events on the real FSM with loops in between. Number of errors.
+*/
+static int fuzz(uint32_t events)
+{
+  uint32_t visits[CHECK_STATES] = {};
+  int resets = AEON_HostSystem::getResetCount();
+  int errors = 0;
+
+  fsm.setCurrentStateId(STATE_Base);
+  auto start = std::chrono::steady_clock::now();
+
+  for (uint32_t i = 0; i < events; i++)
+  {
+    if (i % FUZZ_ERROR_EVERY == FUZZ_ERROR_EVERY - 1)
+    {
+      fsm.setCurrentStateId(STATE_ERROR);
+    }
+
+    StateId state = fsm.getCurrentStateId();
+    EventId event = rng() % CHECK_EVENTS;
+    fsm.dispatch(event);
+
+    StateId next = fsm.getCurrentStateId();
+    if (!fsm.hasState(next))
+    {
+      printf("error: event %u, %s + %s leads to the undefined state %d\n", i, fsm.getStateName(state), fsm.getEventName(event), next);
+      fsm.setCurrentStateId(STATE_Base);
+      if (++errors >= 10)
+      {
+        break;
+      }
+      continue;
+    }
+    visits[next]++;
+
+    if (i % FUZZ_LOOP_EVERY == FUZZ_LOOP_EVERY - 1)
+    {
+      runLoops(1);
+    }
+  }
+
+  double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+  printf("Fuzz: %u events in %.2f s (%.0f events/s), %d errors, %d resets\n", events, seconds, events / seconds, errors,
+         AEON_HostSystem::getResetCount() - resets);
+  for (StateId state = 0; state < CHECK_STATES; state++)
+  {
+    if (fsm.hasState(state) && visits[state] == 0)
+    {
+      printf("  %s never visited\n", fsm.getStateName(state));
+    }
+  }
+  return errors;
+}
+
+/*
+Nanoseconds per dispatch over a repeated random sequence
+*/
+static double measureDispatch(FSM &machine)
+{
+  static EventId sequence[BENCH_SEQUENCE];
+  for (EventId &event : sequence)
+  {
+    event = rng() % CHECK_EVENTS;
+  }
+
+  machine.setCurrentStateId(STATE_Base);
+  uint64_t dispatches = 0;
+  double elapsed = 0;
+  auto start = std::chrono::steady_clock::now();
+  while (elapsed * 1e6 < BENCH_TIME)
+  {
+    for (EventId event : sequence)
+    {
+      machine.dispatch(event);
+    }
+    dispatches += BENCH_SEQUENCE;
+    elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+  }
+  machine.setCurrentStateId(STATE_Base);
+  return elapsed * 1e9 / dispatches;
+}
+
+static void bench()
+{
+  // Same graph without callbacks and guards
+  static FSM engine;
+  for (StateId state = 0; state < CHECK_STATES; state++)
+  {
+    if (!fsm.hasState(state))
+    {
+      continue;
+    }
+    State *copy = engine.addState(state, NULL, NULL, NULL);
+    for (EventId event = 0; event < CHECK_EVENTS; event++)
+    {
+      if (fsm.hasTransition(state, event))
+      {
+        copy->addTransition(event, NULL, NULL, fsm.getNextStateId(state, event));
+      }
+    }
+  }
+
+  double engineNs = measureDispatch(engine);
+  double firmwareNs = measureDispatch(fsm);
+  printf("Dispatch engine:   %8.1f ns (%.1f M/s)\n", engineNs, 1e3 / engineNs);
+  printf("Dispatch firmware: %8.1f ns (%.1f M/s)\n", firmwareNs, 1e3 / firmwareNs);
+}
+
+static void usage()
+{
+  fprintf(stderr, "Usage: aeon_fsm [--fuzz events] [--seed n] [--bench]\n");
+  exit(2);
+}
+
+int main(int argc, char **argv)
+{
+  uint32_t fuzzEvents = 0;
+  bool runBench = false;
+  rngState = 1;
+
+  for (int i = 1; i < argc; i++)
+  {
+    if (strcmp(argv[i], "--fuzz") == 0 && i + 1 < argc)
+    {
+      fuzzEvents = (uint32_t)strtoul(argv[++i], NULL, 10);
+    }
+    else if (strcmp(argv[i], "--seed") == 0 && i + 1 < argc)
+    {
+      rngState = (uint32_t)strtoul(argv[++i], NULL, 10);
+    }
+    else if (strcmp(argv[i], "--bench") == 0)
+    {
+      runBench = true;
+    }
+    else
+    {
+      usage();
+    }
+  }
+  if (rngState == 0)
+  {
+    rngState = 1; // xorshift stays at 0
+  }
+
+  boot();
+
+  int errors = check();
+  if (fuzzEvents)
+  {
+    printf("\n");
+    errors += fuzz(fuzzEvents);
+  }
+  if (runBench)
+  {
+    printf("\n");
+    bench();
+  }
+  return errors ? 1 : 0;
+}
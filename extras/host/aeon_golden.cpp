@@ -0,0 +1,389 @@
+/*
+aeon_golden.cpp - Golden frame regression of all pages and languages.
+
+Every page of AEON_Display is rendered with fixed values in every language (ELanguage)
+and compared pixel by pixel with the golden image in golden/<language>/<page>.pbm. A
+page that differs is written to the output directory as <language>_<page>.pbm together
+with <language>_<page>.ppm, a diff image: white and black where both agree, red where
+only the golden image has a pixel and green where only the new frame has one.
+
+The images show the panel as it looks: a lit pixel is white (0 in the PBM), a dark pixel
+is black. --update writes the current frames as the new golden images.
+
+Usage: aeon_golden [--update] [--golden directory] [--out directory]
+*/
+
+#include <Arduino.h>
+#include <errno.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <time.h>
+#include "AEON_Host.h"
+#include "AEON_HostI2C.h"
+#include "AEON_HostDS3231.h"
+#include "AEON_HostOLED.h"
+#include "AEON_Enums.h"
+#include "AEON_Panel.h"
+#include "AEON_ROM.h"
+#include "AEON_Display.h"
+
+#ifndef AEON_GOLDEN_DIR
+#define AEON_GOLDEN_DIR "golden"
+#endif
+
+#define GOLDEN_WIDTH AEON_PanelGeometry::WIDTH
+#define GOLDEN_HEIGHT AEON_PanelGeometry::HEIGHT
+#define GOLDEN_ROW_BYTES ((GOLDEN_WIDTH + 7) / 8)
+#define GOLDEN_PATH 512
+
+// AEON.ino
+void setup();
+void loop();
+void setup1();
+void loop1();
+
+extern AEON_ROM rom;
+extern AEON_Display aeon;
+extern AEON_PanelDisplay display;
+
+static const char *const languageNames[ELanguage::Count] = {"en", "de", "fr", "es"};
+
+/*
+Pages
+*/
+static void pageBase() { aeon.pageBase(2024, 1, 29, 4, 23, 59, 58, 12345); }
+static void pageBaseLastDays() { aeon.pageBase(2031, 11, 23, 2, 12, 0, 0, 7); }
+static void pageBaseOver() { aeon.pageBase(2031, 11, 31, 0, 0, 0, 0, -42); }
+static void pageBaseCountdown() { aeon.pageBaseCountdown(2024, 1, 29, 4, 23, 59, 58, 12345, 45296, 427); }
+static void pageBaseCountdownOver() { aeon.pageBaseCountdown(2031, 11, 31, 0, 0, 0, 1, -43, 86399, 1012); }
+static void pageTime() { aeon.pageSetupTime(); }
+static void pageTimeHour() { aeon.pageSetupTime_set_time(STATE_Setup_Time_Hour, 7, 5, 3); }
+static void pageTimeMinute() { aeon.pageSetupTime_set_time(STATE_Setup_Time_Minute, 7, 5, 3); }
+static void pageTimeSecond() { aeon.pageSetupTime_set_time(STATE_Setup_Time_Second, 7, 5, 3); }
+static void pageDate() { aeon.pageSetupDate(); }
+static void pageDateYear() { aeon.pageSetupDate_set_date(STATE_Setup_Date_Year, 2024, 1, 29); }
+static void pageDateMonth() { aeon.pageSetupDate_set_date(STATE_Setup_Date_Month, 2024, 1, 29); }
+static void pageDateDay() { aeon.pageSetupDate_set_date(STATE_Setup_Date_Day, 2024, 1, 29); }
+static void pageBirthday() { aeon.pageSetupBirthday(); }
+static void pageBirthdayYear() { aeon.pageSetupBirthday_set_date(STATE_Setup_Birthday_Year, 1990, 4, 17); }
+static void pageBirthdayMonth() { aeon.pageSetupBirthday_set_date(STATE_Setup_Birthday_Month, 1990, 4, 17); }
+static void pageBirthdayDay() { aeon.pageSetupBirthday_set_date(STATE_Setup_Birthday_Day, 1990, 4, 17); }
+static void pageSex() { aeon.pageSetupSex(); }
+static void pageSexFemale() { aeon.pageSetupSex_set(Female); }
+static void pageSexMale() { aeon.pageSetupSex_set(Male); }
+static void pageCountry() { aeon.pageSetupCountry(); }
+static void pageCountrySet() { aeon.pageSetupCountry_set("DE"); }
+static void pageLifespan() { aeon.pageSetupLifespan(); }
+static void pageLifespanSet() { aeon.pageSetupLifespan_set(83); }
+static void pageLanguage() { aeon.pageSetupLanguage(); }
+static void pageLanguageEnglish() { aeon.pageSetupLanguage_set(English); }
+static void pageLanguageGerman() { aeon.pageSetupLanguage_set(German); }
+static void pageLanguageFrench() { aeon.pageSetupLanguage_set(French); }
+static void pageLanguageSpain() { aeon.pageSetupLanguage_set(Spain); }
+static void pageReset() { aeon.pageSetupReset(); }
+static void pageResetYes() { aeon.pageSetupReset_set(STATE_Setup_Reset_Yes); }
+static void pageResetNo() { aeon.pageSetupReset_set(STATE_Setup_Reset_No); }
+static void pageResetCount() { aeon.pageSetupReset_count_final(3); }
+static void pageBack() { aeon.pageSetupBack(); }
+static void pageError() { aeon.pageERROR("ROM: 1 TIME: 11 DISPLAY: 20"); }
+
+typedef struct
+{
+  const char *name;
+  void (*render)(void);
+} SGOLDEN_PAGE;
+
+static const SGOLDEN_PAGE pages[] = {
+    {"base", pageBase},
+    {"base.last", pageBaseLastDays},
+    {"base.over", pageBaseOver},
+    {"base.countdown", pageBaseCountdown},
+    {"base.countdown.over", pageBaseCountdownOver},
+    {"time", pageTime},
+    {"time.hour", pageTimeHour},
+    {"time.minute", pageTimeMinute},
+    {"time.second", pageTimeSecond},
+    {"date", pageDate},
+    {"date.year", pageDateYear},
+    {"date.month", pageDateMonth},
+    {"date.day", pageDateDay},
+    {"birthday", pageBirthday},
+    {"birthday.year", pageBirthdayYear},
+    {"birthday.month", pageBirthdayMonth},
+    {"birthday.day", pageBirthdayDay},
+    {"sex", pageSex},
+    {"sex.female", pageSexFemale},
+    {"sex.male", pageSexMale},
+    {"country", pageCountry},
+    {"country.set", pageCountrySet},
+    {"lifespan", pageLifespan},
+    {"lifespan.set", pageLifespanSet},
+    {"language", pageLanguage},
+    {"language.english", pageLanguageEnglish},
+    {"language.german", pageLanguageGerman},
+    {"language.french", pageLanguageFrench},
+    {"language.spain", pageLanguageSpain},
+    {"reset", pageReset},
+    {"reset.yes", pageResetYes},
+    {"reset.no", pageResetNo},
+    {"reset.count", pageResetCount},
+    {"back", pageBack},
+    {"error", pageError},
+};
+
+typedef uint8_t GoldenImage[GOLDEN_HEIGHT][GOLDEN_ROW_BYTES]; // PBM rows, 1 = black
+
+/*
+Page-major frame buffer -> PBM rows
+*/
+static void frameToImage(const uint8_t *frame, GoldenImage image)
+{
+  memset(image, 0, sizeof(GoldenImage));
+  for (int y = 0; y < GOLDEN_HEIGHT; y++)
+  {
+    for (int x = 0; x < GOLDEN_WIDTH; x++)
+    {
+      bool lit = frame[x + (y / 8) * GOLDEN_WIDTH] & (1 << (y & 7));
+      if (!lit)
+      {
+        image[y][x / 8] |= 0x80 >> (x & 7);
+      }
+    }
+  }
+}
+
+static bool pixel(const GoldenImage image, int x, int y)
+{
+  return !(image[y][x / 8] & (0x80 >> (x & 7)));
+}
+
+/*
+Image as PBM
+*/
+static bool writeImage(const char *path, const GoldenImage image)
+{
+  FILE *file = fopen(path, "wb");
+  if (!file)
+  {
+    perror(path);
+    return false;
+  }
+  fprintf(file, "P4\n%d %d\n", GOLDEN_WIDTH, GOLDEN_HEIGHT);
+  bool ok = fwrite(image, sizeof(GoldenImage), 1, file) == 1;
+  return fclose(file) == 0 && ok;
+}
+
+/*
+Binary PBM of the panel size, false if the file is missing or has another format
+*/
+static bool readImage(const char *path, GoldenImage image)
+{
+  FILE *file = fopen(path, "rb");
+  if (!file)
+  {
+    return false;
+  }
+
+  int width = 0;
+  int height = 0;
+  bool ok = fscanf(file, "P4 %d %d", &width, &height) == 2 && fgetc(file) != EOF &&
+            width == GOLDEN_WIDTH && height == GOLDEN_HEIGHT &&
+            fread(image, sizeof(GoldenImage), 1, file) == 1;
+  fclose(file);
+  return ok;
+}
+
+/*
+Both images as PPM, red only in the golden image, green only in the new frame
+*/
+static bool writeDiff(const char *path, const GoldenImage golden, const GoldenImage current)
+{
+  FILE *file = fopen(path, "wb");
+  if (!file)
+  {
+    perror(path);
+    return false;
+  }
+
+  fprintf(file, "P6\n%d %d\n255\n", GOLDEN_WIDTH, GOLDEN_HEIGHT);
+  for (int y = 0; y < GOLDEN_HEIGHT; y++)
+  {
+    for (int x = 0; x < GOLDEN_WIDTH; x++)
+    {
+      bool before = pixel(golden, x, y);
+      bool after = pixel(current, x, y);
+      uint8_t rgb[3] = {0, 0, 0};
+      if (before && after)
+      {
+        rgb[0] = rgb[1] = rgb[2] = 255;
+      }
+      else if (before)
+      {
+        rgb[0] = 255;
+      }
+      else if (after)
+      {
+        rgb[1] = 255;
+      }
+      fwrite(rgb, sizeof(rgb), 1, file);
+    }
+  }
+  return fclose(file) == 0;
+}
+
+static bool makeDirectory(const char *path)
+{
+  if (mkdir(path, 0755) != 0 && errno != EEXIST)
+  {
+    perror(path);
+    return false;
+  }
+  return true;
+}
+
+/*
+Step the language setting until it is the language
+*/
+static void selectLanguage(ELanguage language)
+{
+  for (int i = 0; i < ELanguage::Count && rom.getLanguage() != language; i++)
+  {
+    rom.setLanguage(+1);
+  }
+}
+
+static void usage()
+{
+  fprintf(stderr, "Usage: aeon_golden [--update] [--golden directory] [--out directory]\n");
+  exit(2);
+}
+
+int main(int argc, char **argv)
+{
+  bool update = false;
+  const char *goldenDirectory = AEON_GOLDEN_DIR;
+  const char *outDirectory = "golden-diff";
+
+  for (int i = 1; i < argc; i++)
+  {
+    if (strcmp(argv[i], "--update") == 0)
+    {
+      update = true;
+    }
+    else if (strcmp(argv[i], "--golden") == 0 && i + 1 < argc)
+    {
+      goldenDirectory = argv[++i];
+    }
+    else if (strcmp(argv[i], "--out") == 0 && i + 1 < argc)
+    {
+      outDirectory = argv[++i];
+    }
+    else
+    {
+      usage();
+    }
+  }
+
+  setenv("TZ", "UTC", 1);
+  tzset();
+
+  AEON_HostClock::setVirtual(true);
+  AEON_HostSerial::setMuted(true);
+
+  static AEON_HostDS3231 rtc;
+  static AEON_HostOLED oled;
+  rtc.setUnixTime(1700000000UL);
+  rtc.setLostPower(false);
+  AEON_HostI2C::attach(AEON_HostDS3231::ADDRESS, &rtc);
+  AEON_HostI2C::attach(AEON_HostOLED::ADDRESS, &oled);
+
+  setup();
+  setup1();
+  for (int i = 0; i < 100; i++)
+  {
+    loop();
+    loop1();
+    AEON_HostClock::advanceMicros(1000);
+  }
+
+  if (!makeDirectory(update ? goldenDirectory : outDirectory))
+  {
+    return 1;
+  }
+
+  int checked = 0;
+  int failed = 0;
+  char path[GOLDEN_PATH];
+  static GoldenImage golden;
+  static GoldenImage current;
+
+  for (int l = 0; l < ELanguage::Count; l++)
+  {
+    selectLanguage((ELanguage)l);
+
+    if (update)
+    {
+      snprintf(path, sizeof(path), "%s/%s", goldenDirectory, languageNames[l]);
+      if (!makeDirectory(path))
+      {
+        return 1;
+      }
+    }
+
+    for (const SGOLDEN_PAGE &page : pages)
+    {
+      page.render();
+      frameToImage(display.getBuffer(), current);
+      checked++;
+
+      snprintf(path, sizeof(path), "%s/%s/%s.pbm", goldenDirectory, languageNames[l], page.name);
+      if (update)
+      {
+        if (!writeImage(path, current))
+        {
+          return 1;
+        }
+        continue;
+      }
+
+      if (!readImage(path, golden))
+      {
+        printf("%s/%s: no golden image %s, run with --update\n", languageNames[l], page.name, path);
+        failed++;
+        continue;
+      }
+
+      int differences = 0;
+      for (int y = 0; y < GOLDEN_HEIGHT; y++)
+      {
+        for (int x = 0; x < GOLDEN_WIDTH; x++)
+        {
+          differences += pixel(golden, x, y) != pixel(current, x, y);
+        }
+      }
+      if (differences == 0)
+      {
+        continue;
+      }
+
+      failed++;
+      printf("%s/%s: %d pixels differ\n", languageNames[l], page.name, differences);
+
+      snprintf(path, sizeof(path), "%s/%s_%s.pbm", outDirectory, languageNames[l], page.name);
+      writeImage(path, current);
+      snprintf(path, sizeof(path), "%s/%s_%s.ppm", outDirectory, languageNames[l], page.name);
+      writeDiff(path, golden, current);
+    }
+  }
+
+  if (update)
+  {
+    printf("%d golden images written to %s\n", checked, goldenDirectory);
+    return 0;
+  }
+
+  printf("%d pages, %d differ\n", checked, failed);
+  return failed ? 1 : 0;
+}
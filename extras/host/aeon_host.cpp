@@ -0,0 +1,83 @@
+/*
+aeon_host.cpp - Runs the AEON firmware on the host.
+
+The firmware is built unmodified against the stand-ins in shim/. A DS3231 model and a
+display controller model are attached to the host I2C bus, setup() and setup1() run
+once and loop() / loop1() run in turns on a virtual clock, one millisecond per loop.
+At the end the panel image of the controller model (what went over the bus) is printed as text,
+with the command and data bytes of the last frame.
+
+Usage: aeon_host [loops] [unix time of the RTC]
+*/
+
+#include <Arduino.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "AEON_Host.h"
+#include "AEON_HostI2C.h"
+#include "AEON_HostDS3231.h"
+#include "AEON_HostOLED.h"
+#include "AEON_Panel.h"
+
+// AEON.ino
+void setup();
+void loop();
+void setup1();
+void loop1();
+
+/*
+Print the panel of the controller model, one character per pixel
+*/
+static void printPanel(AEON_HostOLED &oled)
+{
+  for (int y = 0; y < AEON_PanelGeometry::HEIGHT; y++)
+  {
+    for (int x = 0; x < AEON_PanelGeometry::WIDTH; x++)
+    {
+      putchar(oled.getPixel(x, y) ? '#' : '.');
+    }
+    putchar('\n');
+  }
+}
+
+int main(int argc, char **argv)
+{
+  unsigned long loops = argc > 1 ? strtoul(argv[1], NULL, 10) : 2000;
+  uint32_t unixTime = argc > 2 ? (uint32_t)strtoul(argv[2], NULL, 10) : 1700000000UL;
+
+  // DateTime of RTClib works in UTC
+  setenv("TZ", "UTC", 1);
+  tzset();
+
+  AEON_HostClock::setVirtual(true);
+  AEON_HostI2C::setTimed(true);
+
+  static AEON_HostDS3231 rtc;
+  static AEON_HostOLED oled;
+  rtc.setUnixTime(unixTime);
+  rtc.setLostPower(false);
+  AEON_HostI2C::attach(AEON_HostDS3231::ADDRESS, &rtc);
+  AEON_HostI2C::attach(AEON_HostOLED::ADDRESS, &oled);
+
+  setup();
+  setup1();
+  for (unsigned long i = 0; i < loops; i++)
+  {
+    loop();
+    loop1();
+    AEON_HostClock::advanceMicros(1000);
+  }
+
+  printPanel(oled);
+
+  SHOST_I2C_STATS stats = AEON_HostI2C::getTotalStats();
+  printf("%lu ms, I2C: %u transactions, %u bytes written, %u bytes read\n",
+         millis(), stats.transactions, stats.bytesWritten, stats.bytesRead);
+
+  SHOST_OLED_STATS frame = oled.getLastFrame();
+  printf("Display: %u frames, last frame %u transactions, %u control, %u command, %u data bytes (%u unchanged)\n",
+         oled.getStats().frames, frame.transactions, frame.controlBytes, frame.commandBytes, frame.dataBytes, frame.redundantBytes);
+  return 0;
+}
@@ -0,0 +1,344 @@
+/*
+aeon_lifetable.cpp - Compiles period life tables (CSV) into the tables of AEON_LifeTable (AEON_LifeTables.h).
+
+A CSV file holds the table of one country, the name of the file is the code of the country (DE.csv).
+"age,female,male" per line with the death probability qx of both sexes for the ages 0 to 110, as the
+statistics offices publish them. Lines with # are comments, "# source: ..." is written into the header
+next to the table. The last age is closed (qx = 1), the survivors are rounded to LIFE_TABLE_RADIX and
+the deaths of every age are written. The life expectancy at birth of every table is printed. A table
+with "# source: placeholder" sets LIFE_TABLES_PLACEHOLDER in the header, the firmware does not build with
+it and AEON_LIFE_TABLES 1.
+
+  aeon_lifetable <AEON_LifeTables.h> <CC.csv>...           write the tables
+  aeon_lifetable --check <AEON_LifeTables.h> <CC.csv>...   exit code 1 when the file is not up to date
+  aeon_lifetable --placeholder <CC>                        CSV of a Gompertz-Makeham model on stdout
+
+The placeholder is no published table: a Gompertz-Makeham mortality (mu = A + B e^(c age)) with fixed A, c
+and infant mortality, B is fitted to the default lifespans of the country (AEON_Lifespan.cpp). Its shape
+is only roughly the one of a real population, it stands in until the table of the statistics office is
+there.
+*/
+
+#include <Arduino.h>
+#include <ctype.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <fstream>
+#include <iterator>
+#include <map>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "AEON_Enums.h"
+#include "AEON_Lifespan.h"
+#include "AEON_LifeTable.h"
+
+#define PLACEHOLDER_A 0.0002   // Makeham term, deaths independent of the age
+#define PLACEHOLDER_C 0.1      // Growth of the mortality per year of age
+#define PLACEHOLDER_INFANT 0.003 // qx of the first year
+
+typedef struct
+{
+  std::string code;
+  std::string source;
+  uint16_t deaths[2][LIFE_TABLE_AGES];
+} SCOMPILED_TABLE;
+
+/*
+Deaths per LIFE_TABLE_RADIX from qx, false when a year does not fit an uint16_t
+*/
+static bool toDeaths(const double *qx, uint16_t *deaths)
+{
+  double survivors = 1.0;
+  long previous = LIFE_TABLE_RADIX;
+  for (int age = 0; age < LIFE_TABLE_AGES; age++)
+  {
+    survivors *= age == LIFE_TABLE_AGES - 1 ? 0.0 : 1.0 - qx[age];
+    long next = lround(survivors * LIFE_TABLE_RADIX);
+    if (previous - next > 0xFFFF)
+    {
+      return false;
+    }
+    deaths[age] = (uint16_t)(previous - next);
+    previous = next;
+  }
+  return true;
+}
+
+static std::string baseName(const std::string &path)
+{
+  size_t slash = path.find_last_of("/\\");
+  std::string name = slash == std::string::npos ? path : path.substr(slash + 1);
+  size_t dot = name.find('.');
+  return dot == std::string::npos ? name : name.substr(0, dot);
+}
+
+/*
+One CSV file, false with a message on errors
+*/
+static bool readTable(const char *path, SCOMPILED_TABLE &table)
+{
+  std::ifstream in(path);
+  if (!in)
+  {
+    fprintf(stderr, "%s: cannot read\n", path);
+    return false;
+  }
+
+  table.code = baseName(path);
+  if (table.code.size() != 2 || !isupper((unsigned char)table.code[0]) || !isupper((unsigned char)table.code[1]))
+  {
+    fprintf(stderr, "%s: the name of the file must be the code of the country (DE.csv)\n", path);
+    return false;
+  }
+
+  double qx[2][LIFE_TABLE_AGES];
+  bool seen[LIFE_TABLE_AGES] = {};
+  std::string line;
+  int number = 0;
+  while (std::getline(in, line))
+  {
+    number++;
+    if (!line.empty() && line.back() == '\r')
+    {
+      line.pop_back();
+    }
+    if (line.compare(0, 10, "# source: ") == 0)
+    {
+      table.source = line.substr(10);
+    }
+    if (line.empty() || line[0] == '#' || line.compare(0, 3, "age") == 0)
+    {
+      continue;
+    }
+
+    int age;
+    double female;
+    double male;
+    if (sscanf(line.c_str(), "%d,%lf,%lf", &age, &female, &male) != 3)
+    {
+      fprintf(stderr, "%s:%d: \"age,female,male\" expected\n", path, number);
+      return false;
+    }
+    if (age < 0 || age >= LIFE_TABLE_AGES || female < 0 || female > 1 || male < 0 || male > 1)
+    {
+      fprintf(stderr, "%s:%d: age 0 to %d and qx 0 to 1 expected\n", path, number, LIFE_TABLE_AGES - 1);
+      return false;
+    }
+    qx[Female][age] = female;
+    qx[Male][age] = male;
+    seen[age] = true;
+  }
+
+  for (int age = 0; age < LIFE_TABLE_AGES; age++)
+  {
+    if (!seen[age])
+    {
+      fprintf(stderr, "%s: age %d is missing\n", path, age);
+      return false;
+    }
+  }
+  for (int sex = Female; sex <= Male; sex++)
+  {
+    if (!toDeaths(qx[sex], table.deaths[sex]))
+    {
+      fprintf(stderr, "%s: more than %d deaths of %lu in one year of age\n", path, 0xFFFF, LIFE_TABLE_RADIX);
+      return false;
+    }
+  }
+  return true;
+}
+
+/*
+Life expectancy at birth of the model in years
+*/
+static double placeholderExpectancy(double b, double *qx)
+{
+  double survivors = 1.0;
+  double years = 0.0;
+  for (int age = 0; age < LIFE_TABLE_AGES; age++)
+  {
+    double hazard = PLACEHOLDER_A + b / PLACEHOLDER_C * (exp(PLACEHOLDER_C * (age + 1)) - exp(PLACEHOLDER_C * age));
+    qx[age] = age == 0 ? PLACEHOLDER_INFANT : age == LIFE_TABLE_AGES - 1 ? 1.0 : fmin(1.0, 1.0 - exp(-hazard));
+    double next = survivors * (1.0 - qx[age]);
+    years += (survivors + next) / 2;
+    survivors = next;
+  }
+  return years;
+}
+
+static int placeholder(const char *country)
+{
+  int index = AEON_Lifespan::find(AEON_Lifespan::code(country));
+  if (strlen(country) != 2 || index < 0)
+  {
+    fprintf(stderr, "%s is not in the lifespan table (AEON_Lifespan.cpp)\n", country);
+    return 1;
+  }
+
+  double qx[2][LIFE_TABLE_AGES];
+  for (int sex = Female; sex <= Male; sex++)
+  {
+    // The expectancy falls with B
+    double target = AEON_Lifespan::getDefault(index, (ESex)sex);
+    double low = 1e-9;
+    double high = 1e-2;
+    for (int i = 0; i < 200; i++)
+    {
+      double middle = sqrt(low * high);
+      if (placeholderExpectancy(middle, qx[sex]) > target)
+      {
+        low = middle;
+      }
+      else
+      {
+        high = middle;
+      }
+    }
+    placeholderExpectancy(sqrt(low * high), qx[sex]);
+  }
+
+  printf("# PLACEHOLDER, not a published life table. Gompertz-Makeham model of aeon_lifetable --placeholder %s,\n", country);
+  printf("# fitted to the default lifespans %d / %d of AEON_Lifespan.cpp. Replace it with the period life table\n",
+         AEON_Lifespan::getDefault(index, Female), AEON_Lifespan::getDefault(index, Male));
+  printf("# of the statistics office (qx by single year of age).\n");
+  printf("# source: placeholder, Gompertz-Makeham fitted to %d / %d years\n", AEON_Lifespan::getDefault(index, Female),
+         AEON_Lifespan::getDefault(index, Male));
+  printf("age,female,male\n");
+  for (int age = 0; age < LIFE_TABLE_AGES; age++)
+  {
+    printf("%d,%.8f,%.8f\n", age, qx[Female][age], qx[Male][age]);
+  }
+  return 0;
+}
+
+static void usage()
+{
+  fprintf(stderr, "Usage: aeon_lifetable [--check] <AEON_LifeTables.h> <CC.csv>...\n"
+                  "       aeon_lifetable --placeholder <CC>\n");
+  exit(2);
+}
+
+int main(int argc, char **argv)
+{
+  bool check = false;
+  const char *path = NULL;
+  std::vector<const char *> inputs;
+
+  for (int i = 1; i < argc; i++)
+  {
+    if (strcmp(argv[i], "--placeholder") == 0 && i + 1 < argc)
+    {
+      return placeholder(argv[i + 1]);
+    }
+    else if (strcmp(argv[i], "--check") == 0)
+    {
+      check = true;
+    }
+    else if (argv[i][0] == '-')
+    {
+      usage();
+    }
+    else if (path == NULL)
+    {
+      path = argv[i];
+    }
+    else
+    {
+      inputs.push_back(argv[i]);
+    }
+  }
+  if (path == NULL || inputs.empty())
+  {
+    usage();
+  }
+
+  // Sorted by code, AEON_LifeTable::find() is a binary search
+  std::map<std::string, SCOMPILED_TABLE> tables;
+  for (const char *input : inputs)
+  {
+    SCOMPILED_TABLE table;
+    if (!readTable(input, table))
+    {
+      return 1;
+    }
+    if (tables.count(table.code))
+    {
+      fprintf(stderr, "%s: %s is there twice\n", input, table.code.c_str());
+      return 1;
+    }
+    if (AEON_Lifespan::find(AEON_Lifespan::code(table.code.c_str())) < 0)
+    {
+      fprintf(stderr, "%s: %s is not in the lifespan table (AEON_Lifespan.cpp), it cannot be selected\n", input, table.code.c_str());
+      return 1;
+    }
+    tables[table.code] = table;
+  }
+
+  bool placeholders = false;
+  for (const auto &entry : tables)
+  {
+    placeholders |= entry.second.source.compare(0, 11, "placeholder") == 0;
+  }
+
+  std::ostringstream out;
+  out << "/*\n"
+         "AEON_LifeTables.h - Life tables of AEON_LifeTable, deaths of every age per LIFE_TABLE_RADIX births.\n"
+         "Generated by aeon_lifetable (extras/host) from extras/lifetables, do not edit.\n"
+         "*/\n\n"
+         "#ifndef AEON_LIFE_TABLES_h\n"
+         "#define AEON_LIFE_TABLES_h\n\n"
+         "#define LIFE_TABLES_PLACEHOLDER "
+      << (placeholders ? "1 // A table is a placeholder of aeon_lifetable --placeholder, not published data" : "0")
+      << "\n\n"
+         "static const SLIFE_TABLE lifeTables[] = {\n";
+
+  for (const auto &entry : tables)
+  {
+    const SCOMPILED_TABLE &table = entry.second;
+    char line[160];
+    snprintf(line, sizeof(line), "    // %s, e0 %.2f / %.2f years", table.code.c_str(),
+             AEON_LifeTable::getExpectancy(table.deaths[Female], 0) / 365.2425,
+             AEON_LifeTable::getExpectancy(table.deaths[Male], 0) / 365.2425);
+    out << line << (table.source.empty() ? "" : ", " + table.source) << "\n";
+    out << "    {\"" << table.code << "\",\n     {";
+    for (int sex = Female; sex <= Male; sex++)
+    {
+      out << (sex == Female ? "{" : "      {");
+      for (int age = 0; age < LIFE_TABLE_AGES; age++)
+      {
+        out << (age == 0 ? "" : age % 16 == 0 ? ",\n       " : ", ") << table.deaths[sex][age];
+      }
+      out << (sex == Female ? "},\n" : "}}},\n");
+    }
+    printf("%s: life expectancy at birth %.2f (female) / %.2f (male) years\n", table.code.c_str(),
+           AEON_LifeTable::getExpectancy(table.deaths[Female], 0) / 365.2425,
+           AEON_LifeTable::getExpectancy(table.deaths[Male], 0) / 365.2425);
+  }
+  out << "};\n\n#endif\n";
+
+  if (check)
+  {
+    std::ifstream in(path, std::ios::binary);
+    std::string current((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+    if (current != out.str())
+    {
+      fprintf(stderr, "%s is not up to date, run aeon_lifetable %s <tables>\n", path, path);
+      return 1;
+    }
+    printf("%s: %u tables, up to date\n", path, (unsigned)tables.size());
+    return 0;
+  }
+
+  std::ofstream file(path, std::ios::binary);
+  file << out.str();
+  if (!file)
+  {
+    fprintf(stderr, "Cannot write %s\n", path);
+    return 1;
+  }
+  printf("%s: %u tables\n", path, (unsigned)tables.size());
+  return 0;
+}
@@ -0,0 +1,323 @@
+/*
+aeon_pack.cpp - Builds the language pack region of the flash (AEON_Strings.h) from text files.
+
+A text file holds one language, "key = value" per line (see extras/packs/it.txt): name, code,
+country (of AEON_Lifespan.h), separator, every text of AEON_Strings::EStrings, the weekdays Sun..Sat
+and the months Jan..Dec. Every key is needed. The characters above ASCII that the font of the firmware
+does not have get their glyph in the pack (AEON_HostGlyphs).
+
+The region is then mounted like the firmware does it and every string and glyph is checked, the exit
+code is 1 when a file or a pack is not valid. The region goes to the start of the file system region
+of the flash, e.g. with picotool load -o <start of the file system> packs.bin.
+
+Usage: aeon_pack -o <packs.bin> <language.txt>...
+*/
+
+#include <Arduino.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <fstream>
+#include <map>
+#include <set>
+#include <string>
+#include <vector>
+#include "AEON_Enums.h"
+#include "AEON_Strings.h"
+#include "AEON_Font.h"
+#include "AEON_Lifespan.h"
+#include "AEON_HostGlyphs.h"
+
+extern AEON_Strings strings;
+
+// Keys of the strings in the order of SPACK_HEADER::strings
+static const char *const stringKeys[] = {
+    "Error", "Ok", "RemainingDays", "Setup", "SetupTime", "Time", "SetupDate", "Date", "SetupBirthday",
+    "Birthday", "SetupSex", "Sex", "Female", "Male", "SetupCountry", "Country", "SetupLifespan", "Lifespan", "SetupLanguage",
+    "Language", "English", "German", "French", "Spain", "SetupReset", "Reset", "YES", "NO", "SetupBack",
+    "Sun", "Mon", "Tue", "Wed", "Thu", "Fri", "Sat",
+    "Jan", "Feb", "Mar", "Apr", "May", "Jun", "Jul", "Aug", "Sep", "Oct", "Nov", "Dec"};
+
+static_assert(sizeof(stringKeys) / sizeof(stringKeys[0]) == PACK_STRINGS, "stringKeys must name every string of a pack");
+
+static std::string trim(const std::string &text)
+{
+  size_t start = text.find_first_not_of(" \t");
+  size_t end = text.find_last_not_of(" \t\r");
+  return start == std::string::npos ? "" : text.substr(start, end - start + 1);
+}
+
+/*
+Keys and values of a pack file, false with a message on errors
+*/
+static bool readPack(const char *path, std::map<std::string, std::string> &values)
+{
+  std::ifstream in(path);
+  if (!in)
+  {
+    fprintf(stderr, "%s: cannot read\n", path);
+    return false;
+  }
+
+  std::string line;
+  int number = 0;
+  while (std::getline(in, line))
+  {
+    number++;
+    line = trim(line);
+    if (line.empty() || line[0] == '#')
+    {
+      continue;
+    }
+
+    size_t equal = line.find('=');
+    if (equal == std::string::npos)
+    {
+      fprintf(stderr, "%s:%d: \"key = value\" expected\n", path, number);
+      return false;
+    }
+    std::string key = trim(line.substr(0, equal));
+    std::string value = trim(line.substr(equal + 1));
+    if (value.size() >= 2 && value.front() == '"' && value.back() == '"')
+    {
+      value = value.substr(1, value.size() - 2);
+    }
+    values[key] = value;
+  }
+  return true;
+}
+
+static void append(std::vector<uint8_t> &blob, const void *data, size_t length)
+{
+  const uint8_t *bytes = (const uint8_t *)data;
+  blob.insert(blob.end(), bytes, bytes + length);
+}
+
+/*
+One pack, false with a message when a key, a value or a glyph is missing
+*/
+static bool buildPack(const char *path, std::vector<uint8_t> &blob)
+{
+  std::map<std::string, std::string> values;
+  if (!readPack(path, values))
+  {
+    return false;
+  }
+
+  const char *required[] = {"name", "code", "country", "separator"};
+  for (const char *key : required)
+  {
+    if (!values.count(key))
+    {
+      fprintf(stderr, "%s: %s is missing\n", path, key);
+      return false;
+    }
+  }
+  for (const char *key : stringKeys)
+  {
+    if (!values.count(key))
+    {
+      fprintf(stderr, "%s: %s is missing\n", path, key);
+      return false;
+    }
+  }
+  if (values["code"].size() > 3 || values["separator"].size() != 1)
+  {
+    fprintf(stderr, "%s: code has at most 3 characters, separator one\n", path);
+    return false;
+  }
+  if (values["country"].size() != 2 || AEON_Lifespan::find(AEON_Lifespan::code(values["country"].c_str())) < 0)
+  {
+    fprintf(stderr, "%s: country %s is not in the lifespan table (AEON_Lifespan.cpp)\n", path, values["country"].c_str());
+    return false;
+  }
+
+  SPACK_HEADER header;
+  memset(&header, 0, sizeof(header));
+  header.magic = PACK_MAGIC;
+  header.version = PACK_VERSION;
+  header.stringCount = PACK_STRINGS;
+  header.thousandsSeparator = values["separator"][0];
+  strncpy(header.code, values["code"].c_str(), sizeof(header.code) - 1);
+  strncpy(header.country, values["country"].c_str(), sizeof(header.country) - 1);
+
+  // Strings behind the header, the characters without a glyph in the firmware font need one in the pack
+  std::vector<uint8_t> text;
+  std::set<uint32_t> characters;
+  AEON_Font::setPackGlyphs(NULL, 0);
+
+  for (int string = -1; string < PACK_STRINGS; string++)
+  {
+    const std::string &value = values[string < 0 ? "name" : stringKeys[string]];
+    uint16_t offset = (uint16_t)(sizeof(SPACK_HEADER) + text.size());
+    if (string < 0)
+    {
+      header.name = offset;
+    }
+    else
+    {
+      header.strings[string] = offset;
+    }
+    append(text, value.c_str(), value.size() + 1);
+
+    const char *cursor = value.c_str();
+    uint32_t character;
+    while ((character = AEON_Font::next(&cursor)))
+    {
+      if (character >= 0x80 && AEON_Font::getGlyph(character) == NULL)
+      {
+        characters.insert(character);
+      }
+    }
+  }
+  if (text.size() % 2)
+  {
+    text.push_back(0);
+  }
+
+  std::vector<SFONT_GLYPH> glyphs;
+  for (uint32_t character : characters)
+  {
+    SFONT_GLYPH glyph;
+    memset(&glyph, 0, sizeof(glyph));
+    glyph.character = (uint16_t)character;
+    if (character > 0xFFFF || !AEON_HostGlyphs::getColumns(character, glyph.columns))
+    {
+      fprintf(stderr, "%s: U+%04X has no glyph\n", path, character);
+      return false;
+    }
+    glyphs.push_back(glyph);
+  }
+
+  size_t size = sizeof(SPACK_HEADER) + text.size() + glyphs.size() * sizeof(SFONT_GLYPH);
+  size = (size + 3) & ~(size_t)3;
+  if (size > 0xFFFF || glyphs.size() > 0xFF)
+  {
+    fprintf(stderr, "%s: the pack is too large\n", path);
+    return false;
+  }
+  header.glyphs = (uint16_t)(sizeof(SPACK_HEADER) + text.size());
+  header.glyphCount = (uint8_t)glyphs.size();
+  header.size = (uint16_t)size;
+
+  blob.clear();
+  append(blob, &header, sizeof(header));
+  append(blob, text.data(), text.size());
+  append(blob, glyphs.data(), glyphs.size() * sizeof(SFONT_GLYPH));
+  blob.resize(size, 0);
+  return true;
+}
+
+/*
+Every string of a mounted language has a glyph for every character
+*/
+static bool checkLanguage(ELanguage language)
+{
+  strings.setLanguage(language);
+  bool valid = true;
+  for (int string = 0; string < PACK_STRINGS; string++)
+  {
+    int texts = (int)AEON_Strings::EStrings::Count;
+    const char *text = string < texts ? strings.getString((AEON_Strings::EStrings)string)
+                       : string < texts + 7 ? strings.getWeekday(string - texts)
+                                            : strings.getMonth(string - texts - 7);
+    uint32_t character;
+    while ((character = AEON_Font::next(&text)))
+    {
+      if (character >= 0x80 && AEON_Font::getGlyph(character) == NULL)
+      {
+        fprintf(stderr, "%s: %s has no glyph for U+%04X\n", strings.getLanguageName(language), stringKeys[string], character);
+        valid = false;
+      }
+    }
+  }
+  return valid;
+}
+
+static void usage()
+{
+  fprintf(stderr, "Usage: aeon_pack -o <packs.bin> <language.txt>...\n");
+  exit(2);
+}
+
+int main(int argc, char **argv)
+{
+  const char *output = NULL;
+  std::vector<const char *> inputs;
+
+  for (int i = 1; i < argc; i++)
+  {
+    if (strcmp(argv[i], "-o") == 0 && i + 1 < argc)
+    {
+      output = argv[++i];
+    }
+    else if (argv[i][0] != '-')
+    {
+      inputs.push_back(argv[i]);
+    }
+    else
+    {
+      usage();
+    }
+  }
+  if (output == NULL || inputs.empty())
+  {
+    usage();
+  }
+  if (inputs.size() > AEON_PACKS_MAX)
+  {
+    fprintf(stderr, "The firmware mounts at most %d packs (AEON_PACKS_MAX)\n", AEON_PACKS_MAX);
+    return 1;
+  }
+
+  // Region header and the offsets, then the packs
+  std::vector<uint8_t> region;
+  SPACK_REGION header = {PACK_REGION_MAGIC, PACK_VERSION, (uint16_t)inputs.size()};
+  append(region, &header, sizeof(header));
+  region.resize(sizeof(header) + inputs.size() * sizeof(uint32_t), 0);
+
+  for (size_t i = 0; i < inputs.size(); i++)
+  {
+    std::vector<uint8_t> blob;
+    if (!buildPack(inputs[i], blob))
+    {
+      return 1;
+    }
+    uint32_t offset = (uint32_t)region.size();
+    memcpy(region.data() + sizeof(header) + i * sizeof(uint32_t), &offset, sizeof(offset));
+    append(region, blob.data(), blob.size());
+  }
+
+  // Mount it like the firmware
+  uint8_t mounted = strings.mountPacks(region.data(), region.size());
+  if (mounted != inputs.size())
+  {
+    fprintf(stderr, "Only %u of %u packs mount\n", mounted, (unsigned)inputs.size());
+    return 1;
+  }
+
+  bool valid = true;
+  for (uint8_t i = 0; i < mounted; i++)
+  {
+    ELanguage language = (ELanguage)(ELanguage::Count + i);
+    const SPACK_HEADER *pack = (const SPACK_HEADER *)(region.data() + ((const uint32_t *)(region.data() + sizeof(header)))[i]);
+    printf("%s (%s): language %d, %u bytes, %u glyphs, country %s\n", strings.getLanguageName(language), pack->code,
+           language, pack->size, pack->glyphCount, strings.getDefaultCountry(language));
+    valid = checkLanguage(language) && valid;
+  }
+  strings.setLanguage(GLOBAL_DEFAULTS::defaultLanguage);
+  if (!valid)
+  {
+    return 1;
+  }
+
+  std::ofstream file(output, std::ios::binary);
+  file.write((const char *)region.data(), region.size());
+  if (!file)
+  {
+    fprintf(stderr, "Cannot write %s\n", output);
+    return 1;
+  }
+  printf("%s: %u packs, %u bytes\n", output, mounted, (unsigned)region.size());
+  return 0;
+}
@@ -0,0 +1,316 @@
+/*
+aeon_raster.cpp - Bit exact check of AEON_Raster against Adafruit SSD1306/GFX.
+
+Random lines and rectangles, many of them partly or fully outside of the panel, are drawn with
+AEON_Raster and with drawFastHLine/drawFastVLine/fillRect of Adafruit in every color on the same random
+frame, then the buffers are compared with memcmp. invertRect() is compared with fillRect in
+SSD1306_INVERSE and clearRegion() with fillRect in SSD1306_BLACK. The frame of AEON_Raster starts at
+every byte offset of a 32-bit word, the unaligned head and tail of the word spans are covered as well.
+Every panel geometry of the controllers is checked, the first difference is printed.
+
+The Adafruit_SSD1306 of the host build (shim/) draws pixel by pixel and is no reference of its own. The
+pixels of the library are AEON_AdafruitPort: drawFastHLineInternal() and drawFastVLineInternal() of
+Adafruit_SSD1306.cpp (rotation 0, the page masks and the whole bytes of the vertical line) and the
+column loop of Adafruit_GFX::fillRect(), written down with the same clipping and int16_t arithmetic.
+AEON_Raster and the shim are both compared with it.
+
+Usage: aeon_raster [--iterations N] [--seed N]
+*/
+
+#include <Arduino.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <Adafruit_SSD1306.h>
+#include "AEON_Enums.h"
+#include "AEON_Panel.h"
+#include "AEON_Raster.h"
+
+#define RASTER_MARGIN 40 // Coordinates reach this far outside of the panel
+
+enum ERasterOperation
+{
+  OPERATION_HLINE,
+  OPERATION_VLINE,
+  OPERATION_FILL_RECT,
+  OPERATION_INVERT_RECT,
+  OPERATION_CLEAR_REGION,
+  OPERATION_COUNT
+};
+
+static const char *const operationNames[OPERATION_COUNT] = {"drawHLine", "drawVLine", "fillRect", "invertRect", "clearRegion"};
+
+static uint32_t randomState;
+
+/*
+xorshift32, the same seed always gives the same shapes
+*/
+static uint32_t nextRandom()
+{
+  randomState ^= randomState << 13;
+  randomState ^= randomState >> 17;
+  randomState ^= randomState << 5;
+  return randomState;
+}
+
+static int randomRange(int low, int high)
+{
+  return low + (int)(nextRandom() % (uint32_t)(high - low + 1));
+}
+
+/*
+The drawing of Adafruit_SSD1306 and Adafruit_GFX on a frame of the caller
+*/
+class AEON_AdafruitPort
+{
+private:
+  uint8_t *buffer;
+  int16_t WIDTH;
+  int16_t HEIGHT;
+
+  void apply(uint8_t *pBuf, uint8_t mask, uint16_t color)
+  {
+    switch (color)
+    {
+    case SSD1306_WHITE:
+      *pBuf |= mask;
+      break;
+    case SSD1306_BLACK:
+      *pBuf &= ~mask;
+      break;
+    case SSD1306_INVERSE:
+      *pBuf ^= mask;
+      break;
+    }
+  }
+
+public:
+  AEON_AdafruitPort(uint8_t *buffer, int16_t w, int16_t h) : buffer(buffer), WIDTH(w), HEIGHT(h) {}
+
+  // Adafruit_SSD1306::drawFastHLineInternal()
+  void drawFastHLine(int16_t x, int16_t y, int16_t w, uint16_t color)
+  {
+    if ((y >= 0) && (y < HEIGHT))
+    {
+      if (x < 0)
+      {
+        w += x;
+        x = 0;
+      }
+      if ((x + w) > WIDTH)
+      {
+        w = (WIDTH - x);
+      }
+      if (w > 0)
+      {
+        uint8_t *pBuf = &buffer[(y / 8) * WIDTH + x], mask = 1 << (y & 7);
+        while (w--)
+        {
+          apply(pBuf++, mask, color);
+        }
+      }
+    }
+  }
+
+  // Adafruit_SSD1306::drawFastVLineInternal()
+  void drawFastVLine(int16_t x, int16_t __y, int16_t __h, uint16_t color)
+  {
+    if ((x >= 0) && (x < WIDTH))
+    {
+      if (__y < 0)
+      {
+        __h += __y;
+        __y = 0;
+      }
+      if ((__y + __h) > HEIGHT)
+      {
+        __h = (HEIGHT - __y);
+      }
+      if (__h > 0)
+      {
+        uint8_t y = __y, h = __h;
+        uint8_t *pBuf = &buffer[(y / 8) * WIDTH + x];
+        uint8_t mod = (y & 7);
+
+        if (mod)
+        {
+          mod = 8 - mod;
+          static const uint8_t premask[8] = {0x00, 0x80, 0xC0, 0xE0, 0xF0, 0xF8, 0xFC, 0xFE};
+          uint8_t mask = premask[mod];
+          if (h < mod)
+          {
+            mask &= (0XFF >> (mod - h));
+          }
+          apply(pBuf, mask, color);
+          pBuf += WIDTH;
+        }
+
+        if (h >= mod)
+        {
+          h -= mod;
+          if (h >= 8)
+          {
+            if (color == SSD1306_INVERSE)
+            {
+              do
+              {
+                *pBuf ^= 0xFF;
+                pBuf += WIDTH;
+                h -= 8;
+              } while (h >= 8);
+            }
+            else
+            {
+              uint8_t val = (color != SSD1306_BLACK) ? 255 : 0;
+              do
+              {
+                *pBuf = val;
+                pBuf += WIDTH;
+                h -= 8;
+              } while (h >= 8);
+            }
+          }
+
+          if (h)
+          {
+            mod = h & 7;
+            static const uint8_t postmask[8] = {0x00, 0x01, 0x03, 0x07, 0x0F, 0x1F, 0x3F, 0x7F};
+            apply(pBuf, postmask[mod], color);
+          }
+        }
+      }
+    }
+  }
+
+  // Adafruit_GFX::fillRect()
+  void fillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color)
+  {
+    for (int16_t i = x; i < x + w; i++)
+    {
+      drawFastVLine(i, y, h, color);
+    }
+  }
+};
+
+/*
+Adafruit without the controller, only the buffer of begin() is needed
+*/
+class AEON_RasterReference : public Adafruit_SSD1306
+{
+public:
+  AEON_RasterReference(uint8_t w, uint8_t h) : Adafruit_SSD1306(w, h)
+  {
+    this->buffer = (uint8_t *)malloc(w * ((h + 7) / 8));
+  }
+};
+
+template <class Geometry>
+static bool check(unsigned long iterations)
+{
+  AEON_RasterReference shim(Geometry::WIDTH, Geometry::HEIGHT);
+  static uint8_t expected[Geometry::BUFFER_SIZE];
+  AEON_AdafruitPort reference(expected, Geometry::WIDTH, Geometry::HEIGHT);
+  AEON_Raster<Geometry> raster;
+  static uint32_t storage[Geometry::BUFFER_SIZE / 4 + 2];
+  uint8_t *shimFrame = shim.getBuffer();
+
+  for (unsigned long i = 0; i < iterations; i++)
+  {
+    uint8_t *frame = (uint8_t *)storage + i % 4;
+    raster.setBuffer(frame);
+    for (int b = 0; b < Geometry::BUFFER_SIZE; b++)
+    {
+      expected[b] = (uint8_t)nextRandom();
+    }
+    memcpy(frame, expected, Geometry::BUFFER_SIZE);
+    memcpy(shimFrame, expected, Geometry::BUFFER_SIZE);
+
+    ERasterOperation operation = (ERasterOperation)(nextRandom() % OPERATION_COUNT);
+    ERasterColor color = (ERasterColor)(nextRandom() % 3);
+    int x = randomRange(-RASTER_MARGIN, Geometry::WIDTH + RASTER_MARGIN);
+    int y = randomRange(-RASTER_MARGIN, Geometry::HEIGHT + RASTER_MARGIN);
+    int w = randomRange(-8, Geometry::WIDTH + 2 * RASTER_MARGIN);
+    int h = randomRange(-8, Geometry::HEIGHT + 2 * RASTER_MARGIN);
+
+    switch (operation)
+    {
+    case OPERATION_HLINE:
+      raster.drawHLine(x, y, w, color);
+      reference.drawFastHLine(x, y, w, color);
+      shim.drawFastHLine(x, y, w, color);
+      break;
+    case OPERATION_VLINE:
+      raster.drawVLine(x, y, h, color);
+      reference.drawFastVLine(x, y, h, color);
+      shim.drawFastVLine(x, y, h, color);
+      break;
+    case OPERATION_FILL_RECT:
+      raster.fillRect(x, y, w, h, color);
+      reference.fillRect(x, y, w, h, color);
+      shim.fillRect(x, y, w, h, color);
+      break;
+    case OPERATION_INVERT_RECT:
+      raster.invertRect(x, y, w, h);
+      reference.fillRect(x, y, w, h, SSD1306_INVERSE);
+      shim.fillRect(x, y, w, h, SSD1306_INVERSE);
+      break;
+    case OPERATION_CLEAR_REGION:
+      raster.clearRegion(x, y, w, h);
+      reference.fillRect(x, y, w, h, SSD1306_BLACK);
+      shim.fillRect(x, y, w, h, SSD1306_BLACK);
+      break;
+    default:
+      break;
+    }
+
+    const uint8_t *frames[] = {frame, shimFrame};
+    static const char *const frameNames[] = {"AEON_Raster", "host Adafruit_SSD1306"};
+    for (int f = 0; f < 2; f++)
+    {
+      if (memcmp(frames[f], expected, Geometry::BUFFER_SIZE) != 0)
+      {
+        int b = 0;
+        while (frames[f][b] == expected[b])
+        {
+          b++;
+        }
+        printf("%dx%d: %s(x %d, y %d, w %d, h %d, color %d) of %s differs at byte %d (column %d, page %d): 0x%02X instead of 0x%02X\n",
+               Geometry::WIDTH, Geometry::HEIGHT, operationNames[operation], x, y, w, h, color, frameNames[f], b, b % Geometry::WIDTH,
+               b / Geometry::WIDTH, frames[f][b], expected[b]);
+        return false;
+      }
+    }
+  }
+
+  printf("%dx%d: %lu shapes, bit exact\n", Geometry::WIDTH, Geometry::HEIGHT, iterations);
+  return true;
+}
+
+int main(int argc, char **argv)
+{
+  unsigned long iterations = 200000;
+  randomState = 0xAE0A5EEDUL;
+
+  for (int i = 1; i < argc; i++)
+  {
+    if (strcmp(argv[i], "--iterations") == 0 && i + 1 < argc)
+    {
+      iterations = strtoul(argv[++i], NULL, 0);
+    }
+    else if (strcmp(argv[i], "--seed") == 0 && i + 1 < argc)
+    {
+      randomState = strtoul(argv[++i], NULL, 0) | 1;
+    }
+    else
+    {
+      fprintf(stderr, "Usage: aeon_raster [--iterations N] [--seed N]\n");
+      return 2;
+    }
+  }
+
+  bool passed = true;
+  passed &= check<AEON_Geometry<128, 64>>(iterations);
+  passed &= check<AEON_Geometry<128, 32>>(iterations);
+  passed &= check<AEON_Geometry<96, 16>>(iterations);
+  return passed ? 0 : 1;
+}
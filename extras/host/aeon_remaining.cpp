@@ -0,0 +1,338 @@
+/*
+aeon_remaining.cpp - Check of AEON_LifeTable against tables with a known life expectancy.
+
+The tables of AEON_LifeTables.h are placeholders until published ones are generated, the engine is
+checked with its own tables instead:
+  DE  female: the same deaths at every age, the life expectancy at birth is close to 55.5 years
+      male:   nobody dies before 100, the life expectancy falls by one day per day until then
+  JP  the deaths of a Gompertz curve, the same for both sexes
+
+getExpectancySeconds() is compared with a double calculation of the same model (deaths spread evenly
+over a year of age) at random ages. getRemainingDays() is compared with the expectancy of the double
+model plus the lifespan setting minus the expectancy at birth, before 100 in the male table with the
+lifespan setting minus the age of the fallback (no table) as well. A country without a table must
+give the fallback. getCountdown() must take the second of the day away from the baseline with the rest
+in 0 to 86399 and getElapsed() must be the per mille of the lived seconds of the whole life.
+
+The fraction of the year of age is calculated in 1/65536, an age is up to 482 seconds off, the
+expectancy up to AEON_REMAINING_TOLERANCE seconds. The first difference is printed.
+
+Usage: aeon_remaining [--iterations N] [--seed N]
+*/
+
+#include <Arduino.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "AEON_Enums.h"
+#include "AEON_LifeTable.h"
+
+#define AEON_REMAINING_TOLERANCE 1000   // Seconds
+#define AEON_REMAINING_YEAR 31556952.0  // Seconds of a mean Gregorian year
+#define AEON_REMAINING_MAX_AGE 40600L   // Days, past the last age of the tables
+
+static uint64_t randomState;
+
+/*
+xorshift64, the same seed always gives the same ages
+*/
+static uint64_t nextRandom()
+{
+  randomState ^= randomState << 13;
+  randomState ^= randomState >> 7;
+  randomState ^= randomState << 17;
+  return randomState;
+}
+
+static long randomRange(long low, long high)
+{
+  return low + (long)(nextRandom() % (uint64_t)(high - low + 1));
+}
+
+/*
+The last age takes the survivors that are left
+*/
+static void closeTable(uint16_t *deaths)
+{
+  unsigned long survivors = LIFE_TABLE_RADIX;
+  for (int age = 0; age < LIFE_TABLE_AGES - 1; age++)
+  {
+    survivors -= deaths[age];
+  }
+  deaths[LIFE_TABLE_AGES - 1] = (uint16_t)survivors;
+}
+
+static void buildTables(SLIFE_TABLE *tables)
+{
+  memset(tables, 0, 2 * sizeof(SLIFE_TABLE));
+  memcpy(tables[0].code, "DE", 3);
+  memcpy(tables[1].code, "JP", 3);
+
+  for (int age = 0; age < LIFE_TABLE_AGES - 1; age++)
+  {
+    tables[0].deaths[Female][age] = LIFE_TABLE_RADIX / LIFE_TABLE_AGES;
+    tables[0].deaths[Male][age] = age >= 100 ? LIFE_TABLE_RADIX / (LIFE_TABLE_AGES - 100) : 0;
+  }
+
+  double survivors = LIFE_TABLE_RADIX;
+  for (int age = 0; age < LIFE_TABLE_AGES - 1; age++)
+  {
+    double qx = fmin(1.0, 0.0001 + 0.00003 * exp(0.1 * age));
+    uint16_t deaths = (uint16_t)lround(survivors * qx);
+    tables[1].deaths[Female][age] = deaths;
+    tables[1].deaths[Male][age] = deaths;
+    survivors -= deaths;
+  }
+
+  closeTable(tables[0].deaths[Female]);
+  closeTable(tables[0].deaths[Male]);
+  closeTable(tables[1].deaths[Female]);
+  closeTable(tables[1].deaths[Male]);
+}
+
+/*
+Person-years above the age / survivors at the age in seconds, deaths spread evenly over a year of age
+*/
+static double referenceExpectancy(const uint16_t *deaths, long ageDays)
+{
+  double years = ageDays * 400.0 / 146097.0;
+  int age = (int)floor(years);
+  if (age >= LIFE_TABLE_AGES)
+  {
+    return 0;
+  }
+  double fraction = years - age;
+
+  double survivors[LIFE_TABLE_AGES + 1];
+  survivors[0] = LIFE_TABLE_RADIX;
+  for (int x = 0; x < LIFE_TABLE_AGES; x++)
+  {
+    survivors[x + 1] = survivors[x] - deaths[x];
+  }
+
+  double survivorsAge = survivors[age] - fraction * deaths[age];
+  if (survivorsAge <= 0)
+  {
+    return 0;
+  }
+  double personYears = (1.0 - fraction) * (survivorsAge + survivors[age + 1]) / 2.0;
+  for (int x = age + 1; x < LIFE_TABLE_AGES; x++)
+  {
+    personYears += (survivors[x] + survivors[x + 1]) / 2.0;
+  }
+  return personYears / survivorsAge * AEON_REMAINING_YEAR;
+}
+
+static bool checkExpectancy(const SLIFE_TABLE &table, ESex sex, long ageDays)
+{
+  double expected = referenceExpectancy(table.deaths[sex], ageDays);
+  int64_t actual = AEON_LifeTable::getExpectancySeconds(table.deaths[sex], ageDays);
+  if (fabs((double)actual - expected) <= AEON_REMAINING_TOLERANCE)
+  {
+    return true;
+  }
+  printf("%s %s: getExpectancySeconds(%ld days) = %lld instead of %.0f\n", table.code, sex == Male ? "male" : "female", ageDays,
+         (long long)actual, expected);
+  return false;
+}
+
+/*
+Remaining seconds at the start of the day of the last getRemainingDays()
+*/
+static int64_t baseline(AEON_LifeTable &lifeTable)
+{
+  long days;
+  long seconds;
+  lifeTable.getCountdown(0, &days, &seconds);
+  return (int64_t)days * LIFE_TABLE_DAY + seconds;
+}
+
+/*
+Civil date of a day since 1970-01-01, month 1 to 12 (H. Hinnant, civil_from_days)
+*/
+static void fromDayNumber(long days, int *year, int *month, int *day)
+{
+  days += 719468;
+  long era = (days >= 0 ? days : days - 146096) / 146097;
+  long dayOfEra = days - era * 146097;
+  long yearOfEra = (dayOfEra - dayOfEra / 1460 + dayOfEra / 36524 - dayOfEra / 146096) / 365;
+  long dayOfYear = dayOfEra - (365 * yearOfEra + yearOfEra / 4 - yearOfEra / 100);
+  long monthIndex = (5 * dayOfYear + 2) / 153;
+  *day = (int)(dayOfYear - (153 * monthIndex + 2) / 5 + 1);
+  *month = (int)(monthIndex < 10 ? monthIndex + 3 : monthIndex - 9);
+  *year = (int)(yearOfEra + era * 400 + (*month <= 2));
+}
+
+static bool checkRemaining(AEON_LifeTable &lifeTable, AEON_LifeTable &fallback, const SLIFE_TABLE *table, const char *country,
+                           ESex sex, int lifespan)
+{
+  // The date from 1970 to 2100, the birthday up to the last age of the tables before it
+  long today = randomRange(AEON_LifeTable::getDayNumber(1970, 1, 1), AEON_LifeTable::getDayNumber(2100, 12, 31));
+  long age = randomRange(-365, AEON_REMAINING_MAX_AGE);
+  int year, month, day, birthYear, birthMonth, birthDay;
+  fromDayNumber(today, &year, &month, &day);
+  fromDayNumber(today - age, &birthYear, &birthMonth, &birthDay);
+  birthMonth--; // EMonth
+
+  long remainingDays = lifeTable.getRemainingDays(year, month, day, birthYear, birthMonth, birthDay, country, sex, lifespan);
+  fallback.getRemainingDays(year, month, day, birthYear, birthMonth, birthDay, country, sex, lifespan);
+  int64_t remaining = baseline(lifeTable);
+  double lifespanSeconds = lifespan * AEON_REMAINING_YEAR;
+
+  double expected = (double)lifespanSeconds - (double)age * LIFE_TABLE_DAY;
+  if (table != NULL && age >= 0)
+  {
+    expected = referenceExpectancy(table->deaths[sex], age) + lifespanSeconds - referenceExpectancy(table->deaths[sex], 0);
+  }
+
+  const char *failure = NULL;
+  if (fabs((double)remaining - expected) > AEON_REMAINING_TOLERANCE)
+  {
+    failure = "differs from the double model";
+  }
+  else if (remaining / LIFE_TABLE_DAY != remainingDays && remaining >= 0)
+  {
+    failure = "does not round the days down";
+  }
+  else if (table == NULL && remaining != baseline(fallback))
+  {
+    failure = "differs from the lifespan setting minus the age";
+  }
+  else if (table != NULL && table->code[0] == 'D' && sex == Male && age >= 0 && age < 99 * 365 &&
+           llabs(remaining - baseline(fallback)) > AEON_REMAINING_TOLERANCE)
+  {
+    failure = "does not fall by one day per day";
+  }
+
+  if (failure == NULL)
+  {
+    return true;
+  }
+  printf("%s %s %d: %04d-%02d-%02d born %04d-%02d-%02d, %lld seconds %s (%.0f)\n", country, sex == Male ? "male" : "female", lifespan,
+         year, month, day, birthYear, birthMonth + 1, birthDay, (long long)remaining, failure, expected);
+  return false;
+}
+
+static bool checkCountdown(AEON_LifeTable &lifeTable)
+{
+  int64_t start = baseline(lifeTable);
+  long secondOfDay = randomRange(0, LIFE_TABLE_DAY - 1);
+  long days;
+  long seconds;
+  lifeTable.getCountdown(secondOfDay, &days, &seconds);
+
+  if (seconds < 0 || seconds >= LIFE_TABLE_DAY || (int64_t)days * LIFE_TABLE_DAY + seconds != start - secondOfDay)
+  {
+    printf("getCountdown(%ld) = %ld days %ld seconds, the baseline is %lld seconds\n", secondOfDay, days, seconds, (long long)start);
+    return false;
+  }
+  return true;
+}
+
+static bool checkElapsed(AEON_LifeTable &lifeTable, long age)
+{
+  long secondOfDay = randomRange(0, LIFE_TABLE_DAY - 1);
+  int64_t livedDay = (int64_t)age * LIFE_TABLE_DAY;
+  int64_t life = livedDay + baseline(lifeTable);
+  double lived = (double)(livedDay + secondOfDay);
+  int elapsed = lifeTable.getElapsed(secondOfDay);
+
+  // Not calculated before the birthday, below one day of life and past 10 times the life
+  if (age < 0 || life < LIFE_TABLE_DAY || livedDay / 10 > life)
+  {
+    return elapsed == 0 || (printf("getElapsed(%ld) = %d outside of the life\n", secondOfDay, elapsed), false);
+  }
+
+  double expected = floor(1000.0 * lived / (double)life);
+  if (fabs(elapsed - expected) <= 1)
+  {
+    return true;
+  }
+  printf("getElapsed(%ld) at %ld days = %d instead of %.0f\n", secondOfDay, age, elapsed, expected);
+  return false;
+}
+
+int main(int argc, char **argv)
+{
+  static const char *const countries[] = {"DE", "JP", "FR"};
+  static SLIFE_TABLE tables[2];
+  unsigned long iterations = 100000;
+  randomState = 0xAE0A11FEULL;
+
+  for (int i = 1; i < argc; i++)
+  {
+    if (strcmp(argv[i], "--iterations") == 0 && i + 1 < argc)
+    {
+      iterations = strtoul(argv[++i], NULL, 0);
+    }
+    else if (strcmp(argv[i], "--seed") == 0 && i + 1 < argc)
+    {
+      randomState = strtoull(argv[++i], NULL, 0) | 1;
+    }
+    else
+    {
+      fprintf(stderr, "Usage: aeon_remaining [--iterations N] [--seed N]\n");
+      return 2;
+    }
+  }
+
+  buildTables(tables);
+  AEON_LifeTable lifeTable(tables, 2);
+  AEON_LifeTable fallback(NULL, 0);
+
+  double birth = referenceExpectancy(tables[0].deaths[Female], 0) / AEON_REMAINING_YEAR;
+  if (fabs(birth - LIFE_TABLE_AGES / 2.0) > 0.01)
+  {
+    printf("DE female: life expectancy at birth %.3f years instead of %.1f\n", birth, LIFE_TABLE_AGES / 2.0);
+    return 1;
+  }
+  if (lifeTable.find("FR") != NULL || lifeTable.find("JP") != &tables[1] || lifeTable.find("DE") != &tables[0])
+  {
+    printf("find() does not return the table of the country\n");
+    return 1;
+  }
+
+  for (unsigned long i = 0; i < iterations; i++)
+  {
+    const char *country = countries[nextRandom() % 3];
+    ESex sex = (nextRandom() & 1) ? Male : Female;
+    int lifespan = (int)randomRange(40, 120);
+    long ageDays = randomRange(0, AEON_REMAINING_MAX_AGE);
+    const SLIFE_TABLE *table = lifeTable.find(country);
+
+    if (!checkExpectancy(tables[i % 2], sex, ageDays) || !checkRemaining(lifeTable, fallback, table, country, sex, lifespan) ||
+        !checkCountdown(lifeTable))
+    {
+      return 1;
+    }
+  }
+
+  // A year of lifespan setting is a mean year more, the baseline of the same day is calculated again
+  AEON_LifeTable settings(tables, 2);
+  settings.getRemainingDays(2030, 6, 15, 1990, 2, 1, "JP", Female, 80);
+  int64_t before = baseline(settings);
+  settings.getRemainingDays(2030, 6, 15, 1990, 2, 1, "JP", Female, 81);
+  if (baseline(settings) - before != (int64_t)AEON_REMAINING_YEAR)
+  {
+    printf("One year of lifespan moves the baseline by %lld seconds\n", (long long)(baseline(settings) - before));
+    return 1;
+  }
+
+  for (unsigned long i = 0; i < iterations / 10; i++)
+  {
+    long today = AEON_LifeTable::getDayNumber(2030, 6, 15);
+    long age = randomRange(-365, AEON_REMAINING_MAX_AGE);
+    int birthYear, birthMonth, birthDay;
+    fromDayNumber(today - age, &birthYear, &birthMonth, &birthDay);
+    settings.getRemainingDays(2030, 6, 15, birthYear, birthMonth - 1, birthDay, countries[i % 3], (i & 2) ? Male : Female,
+                              (int)randomRange(1, 120));
+    if (!checkElapsed(settings, age))
+    {
+      return 1;
+    }
+  }
+
+  printf("%lu ages, getExpectancySeconds(), getRemainingDays(), getCountdown() and getElapsed() match the model\n", iterations);
+  return 0;
+}
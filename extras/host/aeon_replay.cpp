@@ -0,0 +1,377 @@
+/*
+aeon_replay.cpp - Replays an input trace of the firmware (AEON_Trace.h) on the host build.
+
+The trace is read from a capture of the serial port, the stream starts at the first "AETR".
+The EEPROM starts with the recorded settings and the DS3231 model with the recorded time, then
+the firmware boots on the virtual clock with timed I2C transfers and flash commits. Every loop
+moves the clock by one step, the button edges of the trace drive the GPIO levels and the RTC
+readings set the DS3231 model at the time they were recorded. The same trace always gives the
+same result.
+
+Reported: frames rendered and sent, I2C bytes, the command and data bytes decoded by the display
+controller model, EEPROM commits and, for every button press, the latency from the edge until the
+frame is on the display (AEON_Latency.h).
+
+Usage: aeon_replay <capture> [--step microseconds] [--quiet]
+*/
+
+#include <Arduino.h>
+#include <EEPROM.h>
+#include <algorithm>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <vector>
+#include "AEON_Host.h"
+#include "AEON_HostI2C.h"
+#include "AEON_HostDS3231.h"
+#include "AEON_HostEEPROM.h"
+#include "AEON_HostFlash.h"
+#include "AEON_HostOLED.h"
+#include "AEON_Enums.h"
+#include "AEON_Bus.h"
+#include "AEON_Latency.h"
+#include "AEON_Trace.h"
+
+#define REPLAY_TAIL 1000000UL // Run on after the last record, microseconds
+
+// AEON.ino
+void setup();
+void loop();
+void setup1();
+void loop1();
+
+extern AEON_Bus bus;
+
+typedef struct
+{
+  uint64_t time; // Microseconds since TRACE_START
+  uint8_t type;  // ETraceRecord
+  uint8_t index;
+  int32_t value;
+} SREPLAY_EVENT;
+
+typedef struct
+{
+  uint32_t unixTime;
+  uint8_t rom[AEON_TRACE_ROM];
+  uint32_t dropped;
+  bool complete;
+  std::vector<SREPLAY_EVENT> events;
+} SREPLAY_TRACE;
+
+/*
+Decoder of the stream
+*/
+class ReplayReader
+{
+private:
+  const std::vector<uint8_t> &data;
+  size_t position;
+
+public:
+  bool failed;
+
+  ReplayReader(const std::vector<uint8_t> &data, size_t position) : data(data), position(position), failed(false) {}
+
+  bool atEnd() { return position >= data.size(); }
+
+  uint8_t byte()
+  {
+    if (atEnd())
+    {
+      failed = true;
+      return 0;
+    }
+    return data[position++];
+  }
+
+  uint32_t varint()
+  {
+    uint32_t value = 0;
+    for (int shift = 0; shift < 35; shift += 7)
+    {
+      uint8_t b = byte();
+      value |= (uint32_t)(b & 0x7F) << shift;
+      if (!(b & 0x80))
+      {
+        return value;
+      }
+    }
+    failed = true;
+    return value;
+  }
+
+  int32_t zigzag()
+  {
+    uint32_t value = varint();
+    return (int32_t)(value >> 1) ^ -(int32_t)(value & 1);
+  }
+};
+
+/*
+Find the first trace in the capture and decode it
+*/
+static bool readTrace(const char *path, SREPLAY_TRACE &trace)
+{
+  FILE *file = fopen(path, "rb");
+  if (!file)
+  {
+    perror(path);
+    return false;
+  }
+  std::vector<uint8_t> data;
+  uint8_t chunk[4096];
+  size_t length;
+  while ((length = fread(chunk, 1, sizeof(chunk), file)) > 0)
+  {
+    data.insert(data.end(), chunk, chunk + length);
+  }
+  fclose(file);
+
+  const uint8_t magic[] = {'A', 'E', 'T', 'R', TRACE_VERSION};
+  auto found = std::search(data.begin(), data.end(), magic, magic + sizeof(magic));
+  if (found == data.end())
+  {
+    fprintf(stderr, "%s: no trace (version %d) found\n", path, TRACE_VERSION);
+    return false;
+  }
+
+  ReplayReader reader(data, (found - data.begin()) + sizeof(magic));
+  memset(trace.rom, 0xFF, sizeof(trace.rom));
+  trace.dropped = 0;
+  trace.complete = false;
+
+  uint64_t time = 0;
+  int32_t unixTime = 0;
+  bool started = false;
+
+  while (!reader.atEnd() && !trace.complete)
+  {
+    uint8_t type = reader.byte();
+    time += reader.varint();
+
+    SREPLAY_EVENT event = {time, type, 0, 0};
+    switch (type)
+    {
+    case TRACE_START:
+      if (started)
+      {
+        reader.failed = true;
+        break;
+      }
+      started = true;
+      unixTime = (int32_t)reader.varint();
+      trace.unixTime = (uint32_t)unixTime;
+      break;
+
+    case TRACE_ROM:
+    {
+      uint8_t offset = reader.byte();
+      for (int i = 0; i < 4; i++)
+      {
+        uint8_t b = reader.byte();
+        if (offset + i < AEON_TRACE_ROM)
+        {
+          trace.rom[offset + i] = b;
+        }
+      }
+      break;
+    }
+
+    case TRACE_BUTTON:
+    {
+      uint8_t edge = reader.byte();
+      event.index = edge >> 1;
+      event.value = edge & 1;
+      trace.events.push_back(event);
+      break;
+    }
+
+    case TRACE_RTC:
+      unixTime += reader.zigzag();
+      event.value = unixTime;
+      trace.events.push_back(event);
+      break;
+
+    case TRACE_END:
+      trace.dropped = reader.varint();
+      trace.complete = true;
+      break;
+
+    default:
+      reader.failed = true;
+      break;
+    }
+
+    // A capture cut off in a record keeps the records before it
+    if (reader.failed && reader.atEnd() && started)
+    {
+      break;
+    }
+    if (reader.failed || !started)
+    {
+      fprintf(stderr, "%s: broken trace after %zu records\n", path, trace.events.size());
+      return false;
+    }
+  }
+  return true;
+}
+
+static void usage()
+{
+  fprintf(stderr, "Usage: aeon_replay <capture> [--step microseconds] [--quiet]\n");
+  exit(2);
+}
+
+int main(int argc, char **argv)
+{
+  const char *path = NULL;
+  uint32_t step = 1000;
+  bool quiet = false;
+
+  for (int i = 1; i < argc; i++)
+  {
+    if (strcmp(argv[i], "--step") == 0 && i + 1 < argc)
+    {
+      step = (uint32_t)strtoul(argv[++i], NULL, 10);
+    }
+    else if (strcmp(argv[i], "--quiet") == 0)
+    {
+      quiet = true;
+    }
+    else if (!path && argv[i][0] != '-')
+    {
+      path = argv[i];
+    }
+    else
+    {
+      usage();
+    }
+  }
+  if (!path || step == 0)
+  {
+    usage();
+  }
+
+  static SREPLAY_TRACE trace;
+  if (!readTrace(path, trace))
+  {
+    return 1;
+  }
+
+  int buttonEdges = 0;
+  for (const SREPLAY_EVENT &event : trace.events)
+  {
+    buttonEdges += event.type == TRACE_BUTTON;
+  }
+  uint64_t duration = trace.events.empty() ? 0 : trace.events.back().time;
+
+  printf("Trace: %zu records, %d button edges, %.1f s%s", trace.events.size(), buttonEdges, duration / 1e6, trace.complete ? "" : ", cut off");
+  if (trace.dropped)
+  {
+    printf(", %u records dropped on the device", trace.dropped);
+  }
+  printf("\n");
+
+  setenv("TZ", "UTC", 1);
+  tzset();
+
+  // I2C transfers and flash commits take their time, the flush and a save are part of the latency
+  AEON_HostClock::setVirtual(true);
+  AEON_HostI2C::setTimed(true);
+  AEON_HostFlash::setTimed(true);
+  AEON_HostSerial::setMuted(true);
+
+  // Settings of the device
+  AEON_HostEEPROM::erase();
+  EEPROM.begin(AEON_HostEEPROM::SECTOR_SIZE);
+  for (int i = 0; i < AEON_TRACE_ROM; i++)
+  {
+    EEPROM.write(i, trace.rom[i]);
+  }
+  EEPROM.end();
+
+  static AEON_HostDS3231 rtc;
+  static AEON_HostOLED oled;
+  rtc.setUnixTime(trace.unixTime);
+  rtc.setLostPower(false);
+  AEON_HostI2C::attach(AEON_HostDS3231::ADDRESS, &rtc);
+  AEON_HostI2C::attach(AEON_HostOLED::ADDRESS, &oled);
+
+  setup();
+  setup1();
+  for (int i = 0; i < 100; i++)
+  {
+    loop();
+    loop1();
+    AEON_HostClock::advanceMicros(1000);
+  }
+
+  uint32_t framesSent = bus.getFramesSent();
+  uint32_t framesSkipped = bus.getFramesSkipped();
+  uint32_t commits = AEON_HostEEPROM::getCommitCount();
+  uint32_t completed = latency.getCompleted();
+  AEON_HostI2C::resetStats();
+  oled.resetStats();
+
+  std::vector<unsigned long> latencies;
+  uint64_t origin = AEON_HostClock::nowMicros();
+  size_t next = 0;
+
+  // Trace time is the virtual clock, loops with I2C transfers take longer than a step
+  for (uint64_t now = 0; now <= duration + REPLAY_TAIL; now = AEON_HostClock::nowMicros() - origin)
+  {
+    for (; next < trace.events.size() && trace.events[next].time <= now; next++)
+    {
+      const SREPLAY_EVENT &event = trace.events[next];
+      if (event.type == TRACE_BUTTON)
+      {
+        AEON_HostGPIO::setLevel(event.index, event.value);
+      }
+      else if (event.type == TRACE_RTC && rtc.getUnixTime() != (uint32_t)event.value)
+      {
+        rtc.setUnixTime((uint32_t)event.value);
+      }
+    }
+
+    loop();
+    loop1();
+
+    if (latency.getCompleted() != completed)
+    {
+      completed = latency.getCompleted();
+      unsigned long edge = latency.getStage(LATENCY_EDGE);
+      unsigned long total = latency.getStage(LATENCY_SHOWN) - edge;
+      latencies.push_back(total);
+      if (!quiet)
+      {
+        printf("%10.3f s  button %u  %7lu us  (debounce %lu, render %lu, flush %lu)\n",
+               (edge - origin) / 1e6, latency.getButton(), total,
+               latency.getStage(LATENCY_PRESS) - edge,
+               latency.getStage(LATENCY_RENDERED) - latency.getStage(LATENCY_PRESS),
+               latency.getStage(LATENCY_SHOWN) - latency.getStage(LATENCY_RENDERED));
+      }
+    }
+
+    AEON_HostClock::advanceMicros(step);
+  }
+
+  SHOST_I2C_STATS i2c = AEON_HostI2C::getTotalStats();
+  printf("Frames: %u rendered, %u sent\n", (bus.getFramesSent() - framesSent) + (bus.getFramesSkipped() - framesSkipped), bus.getFramesSent() - framesSent);
+  printf("I2C: %u transactions, %u bytes written, %u bytes read\n", i2c.transactions, i2c.bytesWritten, i2c.bytesRead);
+  SHOST_OLED_STATS display = oled.getStats();
+  printf("Display: %u command bytes, %u data bytes, %u of them unchanged\n", display.commandBytes, display.dataBytes, display.redundantBytes);
+  printf("EEPROM commits: %u\n", AEON_HostEEPROM::getCommitCount() - commits);
+
+  if (latencies.empty())
+  {
+    printf("Presses: 0\n");
+    return 0;
+  }
+  std::sort(latencies.begin(), latencies.end());
+  printf("Presses: %zu, edge to display min %lu us, p50 %lu us, max %lu us\n", latencies.size(),
+         latencies.front(), latencies[latencies.size() / 2], latencies.back());
+  return 0;
+}
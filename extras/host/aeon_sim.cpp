@@ -0,0 +1,383 @@
+/*
+aeon_sim.cpp - Time-accelerated soak run of the AEON firmware on the host.
+
+The firmware runs unmodified on the virtual clock of the host build. Every loop moves the
+clock (and the DS3231 model with it) by one step, so years of operation pass in minutes:
+with --step 60 a host runs a few million simulated seconds per second.
+The I2C bus is not timed: a frame goes out within one loop and the run does not depend
+on the speed of the host, the same arguments always give the same result.
+
+Once per simulated day (UTC midnight of the RTC) the run records the date the firmware
+shows, calcLifetime(), the frames rendered and sent, the I2C bytes and the EEPROM commits.
+A change of calcLifetime() other than 0 or -1 day (the life expectancy falls by less than a day
+per day, AEON_LifeTable.h), a countdown of the day (AEON_COUNTDOWN) that does not end one second
+before the baseline of the day, a date that differs from the RTC and any
+error state are counted as anomalies and the first ones are printed.
+
+The step that crosses midnight runs up to one second before it and then in steps of SIM_MIDNIGHT_TICK
+to one second after it, the date of AEON_Time lags behind the RTC there (loopTime() updates it once a
+second). After every one of these loops the countdown of calcCountdown() at the RTC time must match a
+baseline calculated from the date of the RTC, a run in which the date never lagged is an anomaly as well.
+
+Usage: aeon_sim [--years N] [--step seconds] [--start unix] [--birthday YYYY-MM-DD]
+                [--csv file]
+*/
+
+#include <Arduino.h>
+#include <chrono>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "AEON_Host.h"
+#include "AEON_HostI2C.h"
+#include "AEON_HostDS3231.h"
+#include "AEON_HostEEPROM.h"
+#include "AEON_HostOLED.h"
+#include "AEON_Global.h"
+#include "AEON_Bus.h"
+#include "AEON_ROM.h"
+#include "AEON_Time.h"
+#include "AEON_LifeTable.h"
+
+#define SIM_SECONDS_PER_DAY 86400UL
+#define SIM_ANOMALIES_PRINTED 20
+#define SIM_MIDNIGHT_TICK 50000ULL // Microseconds, finer than the phase of loopTime() to the seconds of the RTC
+
+// AEON.ino
+void setup();
+void loop();
+void setup1();
+void loop1();
+int calcLifetime(int year, int month, int day);
+void calcCountdown(const DateTime &now, long *days, long *seconds, int *elapsed);
+
+extern AEON_Bus bus;
+extern AEON_ROM rom;
+extern AEON_Time timer;
+extern AEON_LifeTable lifeTable;
+
+typedef struct
+{
+  double years;
+  uint32_t step;
+  uint32_t start;
+  const char *csv;
+} SSIM_OPTIONS;
+
+typedef struct
+{
+  uint32_t frames;
+  uint32_t framesSent;
+  uint32_t i2cBytes;
+  uint32_t commits;
+} SSIM_COUNTERS;
+
+// The counters of the bus and the I2C model are 32 bit, the totals of a long run are summed per day
+typedef struct
+{
+  uint64_t frames;
+  uint64_t framesSent;
+  uint64_t i2cBytes;
+  uint64_t commits;
+} SSIM_TOTALS;
+
+/*
+Print the options and exit
+*/
+static void usage()
+{
+  fprintf(stderr, "Usage: aeon_sim [--years N] [--step seconds] [--start unix] [--birthday YYYY-MM-DD] [--csv file]\n");
+  exit(2);
+}
+
+/*
+Birthday of a fresh EEPROM, setup() saves it with the other defaults
+*/
+static void setBirthday(const char *text)
+{
+  int year, month, day;
+  if (sscanf(text, "%d-%d-%d", &year, &month, &day) != 3 || month < 1 || month > 12 || day < 1 || day > 31)
+  {
+    usage();
+  }
+
+  GLOBAL_DEFAULTS::defaultBirthdayYear = year;
+  GLOBAL_DEFAULTS::defaultBirthdayMonth = month - 1; // EMonth
+  GLOBAL_DEFAULTS::defaultBirthdayDay = day;
+}
+
+/*
+Options of the command line, the usage for an unknown or invalid one
+*/
+static SSIM_OPTIONS parseOptions(int argc, char **argv)
+{
+  SSIM_OPTIONS options = {10.0, 1, 1700000000UL, NULL};
+
+  for (int i = 1; i < argc; i++)
+  {
+    if (i + 1 >= argc)
+    {
+      usage();
+    }
+
+    const char *value = argv[i + 1];
+    if (strcmp(argv[i], "--years") == 0)
+    {
+      options.years = atof(value);
+    }
+    else if (strcmp(argv[i], "--step") == 0)
+    {
+      options.step = (uint32_t)strtoul(value, NULL, 10);
+    }
+    else if (strcmp(argv[i], "--start") == 0)
+    {
+      options.start = (uint32_t)strtoul(value, NULL, 10);
+    }
+    else if (strcmp(argv[i], "--birthday") == 0)
+    {
+      setBirthday(value);
+    }
+    else if (strcmp(argv[i], "--csv") == 0)
+    {
+      options.csv = value;
+    }
+    else
+    {
+      usage();
+    }
+    i++;
+  }
+
+  if (options.years <= 0 || options.step == 0 || options.step > SIM_SECONDS_PER_DAY)
+  {
+    usage();
+  }
+  return options;
+}
+
+/*
+Counters of the bus, the I2C model and the EEPROM model since the start
+*/
+static SSIM_COUNTERS readCounters()
+{
+  SSIM_COUNTERS counters;
+  SHOST_I2C_STATS i2c = AEON_HostI2C::getTotalStats();
+
+  counters.frames = bus.getFramesSent() + bus.getFramesSkipped();
+  counters.framesSent = bus.getFramesSent();
+  counters.i2cBytes = i2c.bytesWritten + i2c.bytesRead;
+  counters.commits = AEON_HostEEPROM::getCommitCount();
+  return counters;
+}
+
+/*
+Print an anomaly, only the first ones to keep the output short
+*/
+static void anomaly(unsigned long &count, const char *date, const char *text, long value)
+{
+  if (count++ < SIM_ANOMALIES_PRINTED)
+  {
+    printf("%s: %s %ld\n", date, text, value);
+  }
+}
+
+/*
+One loop of both cores
+*/
+static void run(uint64_t micros)
+{
+  AEON_HostClock::advanceMicros(micros);
+  loop();
+  loop1();
+}
+
+/*
+Countdown of the firmware at the RTC time against a baseline of the date of the RTC, returns true
+when the date of AEON_Time lagged behind
+*/
+static bool checkMidnight(AEON_HostDS3231 &rtc, unsigned long &anomalies)
+{
+  static AEON_LifeTable reference;
+
+  uint32_t rtcTime = rtc.getUnixTime();
+  time_t rtcSeconds = (time_t)rtcTime;
+  struct tm rtcDate;
+  gmtime_r(&rtcSeconds, &rtcDate);
+
+  long days;
+  long seconds;
+  int elapsed;
+  calcCountdown(DateTime(rtcTime), &days, &seconds, &elapsed);
+
+  long referenceDays;
+  long referenceSeconds;
+  reference.getRemainingDays(rtcDate.tm_year + 1900, rtcDate.tm_mon + 1, rtcDate.tm_mday, rom.getBirthdayYear(), rom.getBirthdayMonth(),
+                             rom.getBirthdayDay(), rom.getCountry(), rom.getSex(), rom.getLifespan());
+  reference.getCountdown(rtcTime % SIM_SECONDS_PER_DAY, &referenceDays, &referenceSeconds);
+
+  if (days != referenceDays || seconds != referenceSeconds)
+  {
+    char date[16];
+    snprintf(date, sizeof(date), "%04d-%02d-%02d", rtcDate.tm_year + 1900, rtcDate.tm_mon + 1, rtcDate.tm_mday);
+    anomaly(anomalies, date, "countdown at midnight differs from the RTC date by",
+            (days - referenceDays) * (long)SIM_SECONDS_PER_DAY + seconds - referenceSeconds);
+  }
+  return rtcDate.tm_mday != timer.getDay();
+}
+
+int main(int argc, char **argv)
+{
+  SSIM_OPTIONS options = parseOptions(argc, argv);
+
+  // DateTime of RTClib and mktime() of AEON_Time work in UTC
+  setenv("TZ", "UTC", 1);
+  tzset();
+
+  AEON_HostClock::setVirtual(true);
+  AEON_HostSerial::setMuted(true);
+  AEON_HostSerial::setConnected(false);
+  AEON_HostEEPROM::erase();
+
+  static AEON_HostDS3231 rtc;
+  static AEON_HostOLED oled;
+  rtc.setUnixTime(options.start);
+  rtc.setLostPower(false);
+  AEON_HostI2C::attach(AEON_HostDS3231::ADDRESS, &rtc);
+  AEON_HostI2C::attach(AEON_HostOLED::ADDRESS, &oled);
+
+  setup();
+  setup1();
+
+  // Boot until the first page is on the display
+  for (int i = 0; i < 100; i++)
+  {
+    loop();
+    loop1();
+    AEON_HostClock::advanceMicros(1000);
+  }
+
+  FILE *csv = NULL;
+  if (options.csv)
+  {
+    csv = fopen(options.csv, "w");
+    if (!csv)
+    {
+      perror(options.csv);
+      return 1;
+    }
+    fprintf(csv, "rtc,date,lifetime,frames,frames_sent,i2c_bytes,eeprom_commits\n");
+  }
+
+  SSIM_COUNTERS day = readCounters();
+  SSIM_TOTALS totals = {0, 0, 0, 0};
+
+  unsigned long steps = (unsigned long)(options.years * 365.2425 * SIM_SECONDS_PER_DAY / options.step);
+  unsigned long days = 0;
+  unsigned long anomalies = 0;
+  unsigned long midnightLoops = 0;
+  unsigned long midnightLagging = 0;
+  uint32_t currentDay = rtc.getUnixTime() / SIM_SECONDS_PER_DAY;
+  int firstLifetime = calcLifetime(timer.getYear(), timer.getMonth(), timer.getDay());
+  int lastLifetime = firstLifetime;
+
+  auto wallStart = std::chrono::steady_clock::now();
+
+  for (unsigned long i = 0; i < steps; i++)
+  {
+    uint32_t toMidnight = SIM_SECONDS_PER_DAY - rtc.getUnixTime() % SIM_SECONDS_PER_DAY;
+    if (options.step > toMidnight + 1)
+    {
+      // One second before midnight to one second after it in ticks, then the rest of the step
+      run((uint64_t)(toMidnight - 1) * 1000000ULL);
+      for (uint64_t tick = 0; tick < 2000000ULL; tick += SIM_MIDNIGHT_TICK)
+      {
+        run(SIM_MIDNIGHT_TICK);
+        midnightLoops++;
+        midnightLagging += checkMidnight(rtc, anomalies);
+      }
+      run((uint64_t)(options.step - toMidnight - 1) * 1000000ULL);
+    }
+    else
+    {
+      run((uint64_t)options.step * 1000000ULL);
+    }
+
+    uint32_t rtcTime = rtc.getUnixTime();
+    if (rtcTime / SIM_SECONDS_PER_DAY == currentDay)
+    {
+      continue;
+    }
+    currentDay = rtcTime / SIM_SECONDS_PER_DAY;
+    days++;
+
+    char date[16];
+    snprintf(date, sizeof(date), "%04d-%02d-%02d", timer.getYear(), timer.getMonth(), timer.getDay());
+
+    time_t rtcSeconds = (time_t)rtcTime;
+    struct tm rtcDate;
+    gmtime_r(&rtcSeconds, &rtcDate);
+    if (rtcDate.tm_year + 1900 != timer.getYear() || rtcDate.tm_mon + 1 != timer.getMonth() || rtcDate.tm_mday != timer.getDay())
+    {
+      anomaly(anomalies, date, "date differs from the RTC, unix", (long)rtcTime);
+    }
+
+    int lifetime = calcLifetime(rtcDate.tm_year + 1900, rtcDate.tm_mon + 1, rtcDate.tm_mday);
+    if (lifetime - lastLifetime != -1 && lifetime - lastLifetime != 0)
+    {
+      anomaly(anomalies, date, "lifetime changed by", (long)(lifetime - lastLifetime));
+    }
+    if (timer.getErrorState() != TIME_RETURN_NULL || bus.hasFault(BUS_DEVICE_DISPLAY) || bus.hasFault(BUS_DEVICE_RTC))
+    {
+      anomaly(anomalies, date, "error state, time", (long)timer.getErrorState());
+    }
+    lastLifetime = lifetime;
+
+    // The last second of the day is the baseline minus 86399 seconds
+    long startDays;
+    long startSeconds;
+    long endDays;
+    long endSeconds;
+    lifeTable.getCountdown(0, &startDays, &startSeconds);
+    lifeTable.getCountdown(SIM_SECONDS_PER_DAY - 1, &endDays, &endSeconds);
+    long countdownChange = (startDays - endDays) * (long)SIM_SECONDS_PER_DAY + startSeconds - endSeconds;
+    if (startDays != lifetime || endSeconds < 0 || endSeconds >= (long)SIM_SECONDS_PER_DAY || countdownChange != (long)SIM_SECONDS_PER_DAY - 1)
+    {
+      anomaly(anomalies, date, "countdown of the day changed by", countdownChange);
+    }
+
+    SSIM_COUNTERS now = readCounters();
+    SSIM_COUNTERS delta = {now.frames - day.frames, now.framesSent - day.framesSent, now.i2cBytes - day.i2cBytes, now.commits - day.commits};
+    totals.frames += delta.frames;
+    totals.framesSent += delta.framesSent;
+    totals.i2cBytes += delta.i2cBytes;
+    totals.commits += delta.commits;
+    day = now;
+
+    if (csv)
+    {
+      fprintf(csv, "%u,%s,%d,%u,%u,%u,%u\n", rtcTime, date, lifetime, delta.frames, delta.framesSent, delta.i2cBytes, delta.commits);
+    }
+  }
+
+  double wall = std::chrono::duration<double>(std::chrono::steady_clock::now() - wallStart).count();
+  double simulated = (double)steps * options.step;
+  if (csv)
+  {
+    fclose(csv);
+  }
+
+  printf("Simulated %.0f s (%lu days) in %.2f s wall, %.0f simulated s per wall s\n", simulated, days, wall, wall > 0 ? simulated / wall : 0);
+  printf("Lifetime: %d -> %d days\n", firstLifetime, lastLifetime);
+  printf("Frames: %llu rendered, %llu sent\n", (unsigned long long)totals.frames, (unsigned long long)totals.framesSent);
+  printf("I2C: %llu bytes, %.1f per simulated second\n", (unsigned long long)totals.i2cBytes, totals.i2cBytes / simulated);
+  printf("EEPROM commits: %llu\n", (unsigned long long)totals.commits);
+  if (midnightLoops > 0 && midnightLagging == 0)
+  {
+    anomaly(anomalies, "midnight", "loops with the date of AEON_Time behind the RTC", 0);
+  }
+
+  printf("Midnight: %lu loops checked, %lu with the date of AEON_Time behind the RTC\n", midnightLoops, midnightLagging);
+  printf("Anomalies: %lu\n", anomalies);
+  return anomalies ? 1 : 0;
+}
@@ -0,0 +1,56 @@
+/*
+AEON_Host.h - Controls for the host stand-ins of the Arduino core.
+
+Host tools use these classes to drive the firmware: the clock can run on the
+host monotonic clock or as a virtual clock that only moves when it is advanced,
+GPIO input levels can be injected and the Serial port can be muted or fed.
+*/
+
+#ifndef AEON_HOST_h
+#define AEON_HOST_h
+
+#include <stdint.h>
+#include <stddef.h>
+
+class AEON_HostClock
+{
+private:
+  static bool virtualTime;
+  static uint64_t virtualMicros;
+
+public:
+  static void setVirtual(bool enable);
+  static bool isVirtual();
+  static void advanceMicros(uint64_t us);
+  static uint64_t nowMicros();
+};
+
+class AEON_HostGPIO
+{
+public:
+  static constexpr int PIN_COUNT = 30;
+
+  static void setLevel(int pin, int level);
+  static int getLevel(int pin);
+  static int getMode(int pin);
+  static void setMode(int pin, int mode);
+};
+
+class AEON_HostSerial
+{
+public:
+  static void setMuted(bool muted);
+  static bool isMuted();
+  static void setConnected(bool connected);
+  static bool isConnected();
+  static void feed(const char *input);
+  static size_t getBytesWritten();
+};
+
+class AEON_HostSystem
+{
+public:
+  static int getResetCount();
+};
+
+#endif
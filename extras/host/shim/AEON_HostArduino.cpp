@@ -0,0 +1,449 @@
+/*
+AEON_HostArduino.cpp - Host implementation of the Arduino core stand-ins.
+*/
+
+#include <Arduino.h>
+#include <chrono>
+#include <string>
+#include <SPI.h>
+#include "AEON_Host.h"
+
+SerialUSB Serial;
+RP2040 rp2040;
+SPIClass SPI;
+
+/*
+Clock
+*/
+bool AEON_HostClock::virtualTime = false;
+uint64_t AEON_HostClock::virtualMicros = 0;
+
+static uint64_t hostMonotonicMicros()
+{
+  static const auto start = std::chrono::steady_clock::now();
+  return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+}
+
+void AEON_HostClock::setVirtual(bool enable)
+{
+  if (enable && !virtualTime)
+  {
+    virtualMicros = hostMonotonicMicros();
+  }
+  virtualTime = enable;
+}
+
+bool AEON_HostClock::isVirtual()
+{
+  return virtualTime;
+}
+
+void AEON_HostClock::advanceMicros(uint64_t us)
+{
+  virtualMicros += us;
+}
+
+uint64_t AEON_HostClock::nowMicros()
+{
+  return virtualTime ? virtualMicros : hostMonotonicMicros();
+}
+
+unsigned long millis()
+{
+  return (unsigned long)(AEON_HostClock::nowMicros() / 1000);
+}
+
+unsigned long micros()
+{
+  return (unsigned long)AEON_HostClock::nowMicros();
+}
+
+void delay(unsigned long ms)
+{
+  delayMicroseconds(ms * 1000);
+}
+
+void delayMicroseconds(unsigned int us)
+{
+  if (AEON_HostClock::isVirtual())
+  {
+    AEON_HostClock::advanceMicros(us);
+    return;
+  }
+  uint64_t end = AEON_HostClock::nowMicros() + us;
+  while (AEON_HostClock::nowMicros() < end)
+  {
+  }
+}
+
+void yield() {}
+
+/*
+GPIO
+*/
+static int gpioLevel[AEON_HostGPIO::PIN_COUNT];
+static int gpioMode[AEON_HostGPIO::PIN_COUNT];
+
+void AEON_HostGPIO::setLevel(int pin, int level)
+{
+  if (pin >= 0 && pin < PIN_COUNT)
+  {
+    gpioLevel[pin] = level ? HIGH : LOW;
+  }
+}
+
+int AEON_HostGPIO::getLevel(int pin)
+{
+  return (pin >= 0 && pin < PIN_COUNT) ? gpioLevel[pin] : LOW;
+}
+
+int AEON_HostGPIO::getMode(int pin)
+{
+  return (pin >= 0 && pin < PIN_COUNT) ? gpioMode[pin] : INPUT;
+}
+
+void AEON_HostGPIO::setMode(int pin, int mode)
+{
+  if (pin >= 0 && pin < PIN_COUNT)
+  {
+    gpioMode[pin] = mode;
+  }
+}
+
+void pinMode(uint8_t pin, uint8_t mode)
+{
+  AEON_HostGPIO::setMode(pin, mode);
+  if (mode == INPUT_PULLUP)
+  {
+    AEON_HostGPIO::setLevel(pin, HIGH);
+  }
+}
+
+int digitalRead(uint8_t pin)
+{
+  return AEON_HostGPIO::getLevel(pin);
+}
+
+void digitalWrite(uint8_t pin, uint8_t value)
+{
+  AEON_HostGPIO::setLevel(pin, value);
+}
+
+/*
+System
+*/
+static int resetCount = 0;
+
+void NVIC_SystemReset()
+{
+  resetCount++;
+}
+
+int AEON_HostSystem::getResetCount()
+{
+  return resetCount;
+}
+
+uint32_t RP2040::getCycleCount()
+{
+  return (uint32_t)getCycleCount64();
+}
+
+uint64_t RP2040::getCycleCount64()
+{
+  return AEON_HostClock::nowMicros() * (f_cpu() / 1000000);
+}
+
+/*
+Heap
+Like arduino-pico the core wraps the allocator, here only to count the allocations for AEON_Heap. glibc
+lets the program replace malloc and keeps its own as __libc_*. The sanitizers replace malloc themselves.
+*/
+#if !defined(__SANITIZE_ADDRESS__) && !defined(__SANITIZE_THREAD__)
+extern "C"
+{
+  void *__libc_malloc(size_t size);
+  void *__libc_calloc(size_t count, size_t size);
+  void *__libc_realloc(void *pointer, size_t size);
+  void __libc_free(void *pointer);
+
+  static uint32_t allocationCount = 0;
+
+  void *malloc(size_t size)
+  {
+    __atomic_add_fetch(&allocationCount, 1, __ATOMIC_RELAXED);
+    return __libc_malloc(size);
+  }
+
+  void *calloc(size_t count, size_t size)
+  {
+    __atomic_add_fetch(&allocationCount, 1, __ATOMIC_RELAXED);
+    return __libc_calloc(count, size);
+  }
+
+  void *realloc(void *pointer, size_t size)
+  {
+    __atomic_add_fetch(&allocationCount, 1, __ATOMIC_RELAXED);
+    return __libc_realloc(pointer, size);
+  }
+
+  void free(void *pointer)
+  {
+    __libc_free(pointer);
+  }
+
+  uint32_t aeon_allocation_count(void)
+  {
+    return __atomic_load_n(&allocationCount, __ATOMIC_RELAXED);
+  }
+}
+#endif
+
+/*
+Print
+*/
+size_t Print::write(const uint8_t *buffer, size_t size)
+{
+  size_t n = 0;
+  while (size--)
+  {
+    n += write(*buffer++);
+  }
+  return n;
+}
+
+size_t Print::print(const String &s)
+{
+  return write(s.c_str());
+}
+
+size_t Print::print(long n, int base)
+{
+  if (base == 10 && n < 0)
+  {
+    return print('-') + print((unsigned long)(-n), 10);
+  }
+  return print((unsigned long)n, base);
+}
+
+size_t Print::print(unsigned long n, int base)
+{
+  return print((unsigned long long)n, base);
+}
+
+size_t Print::print(long long n, int base)
+{
+  if (base == 10 && n < 0)
+  {
+    return print('-') + print((unsigned long long)(-n), 10);
+  }
+  return print((unsigned long long)n, base);
+}
+
+size_t Print::print(unsigned long long n, int base)
+{
+  char buf[8 * sizeof(n) + 1];
+  char *str = &buf[sizeof(buf) - 1];
+  *str = '\0';
+  if (base < 2)
+  {
+    base = 10;
+  }
+  do
+  {
+    int digit = n % base;
+    n /= base;
+    *--str = digit < 10 ? '0' + digit : 'A' + digit - 10;
+  } while (n);
+  return write(str);
+}
+
+size_t Print::print(double n, int digits)
+{
+  char buf[64];
+  snprintf(buf, sizeof(buf), "%.*f", digits, n);
+  return write(buf);
+}
+
+size_t Print::printf(const char *format, ...)
+{
+  char buf[256];
+  va_list args;
+  va_start(args, format);
+  int len = vsnprintf(buf, sizeof(buf), format, args);
+  va_end(args);
+  if (len < 0)
+  {
+    return 0;
+  }
+  return write((const uint8_t *)buf, std::min((size_t)len, sizeof(buf) - 1));
+}
+
+/*
+Serial
+*/
+static bool serialMuted = false;
+static bool serialConnected = true;
+static size_t serialBytesWritten = 0;
+static std::string serialInput;
+
+void AEON_HostSerial::setMuted(bool muted)
+{
+  serialMuted = muted;
+}
+
+bool AEON_HostSerial::isMuted()
+{
+  return serialMuted;
+}
+
+void AEON_HostSerial::setConnected(bool connected)
+{
+  serialConnected = connected;
+}
+
+bool AEON_HostSerial::isConnected()
+{
+  return serialConnected;
+}
+
+void AEON_HostSerial::feed(const char *input)
+{
+  serialInput += input;
+}
+
+size_t AEON_HostSerial::getBytesWritten()
+{
+  return serialBytesWritten;
+}
+
+size_t SerialUSB::write(uint8_t c)
+{
+  return write(&c, 1);
+}
+
+size_t SerialUSB::write(const uint8_t *buffer, size_t size)
+{
+  serialBytesWritten += size;
+  if (!serialMuted)
+  {
+    fwrite(buffer, 1, size, stdout);
+  }
+  return size;
+}
+
+int SerialUSB::available()
+{
+  return (int)serialInput.size();
+}
+
+int SerialUSB::read()
+{
+  if (serialInput.empty())
+  {
+    return -1;
+  }
+  int c = (uint8_t)serialInput[0];
+  serialInput.erase(0, 1);
+  return c;
+}
+
+int SerialUSB::peek()
+{
+  return serialInput.empty() ? -1 : (uint8_t)serialInput[0];
+}
+
+SerialUSB::operator bool()
+{
+  return serialConnected;
+}
+
+/*
+String
+*/
+void String::assign(const char *s, size_t n)
+{
+  char *next = new char[n + 1];
+  memcpy(next, s, n);
+  next[n] = '\0';
+  delete[] buffer;
+  buffer = next;
+  len = n;
+}
+
+String::String(const char *s) : buffer(NULL), len(0)
+{
+  assign(s ? s : "", s ? strlen(s) : 0);
+}
+
+String::String(const String &s) : buffer(NULL), len(0)
+{
+  assign(s.buffer, s.len);
+}
+
+String::String(int value, unsigned char base) : buffer(NULL), len(0)
+{
+  char buf[34];
+  if (base == 10)
+  {
+    snprintf(buf, sizeof(buf), "%d", value);
+  }
+  else
+  {
+    snprintf(buf, sizeof(buf), base == 16 ? "%x" : "%o", value);
+  }
+  assign(buf, strlen(buf));
+}
+
+String::~String()
+{
+  delete[] buffer;
+}
+
+String &String::operator=(const String &s)
+{
+  if (this != &s)
+  {
+    assign(s.buffer, s.len);
+  }
+  return *this;
+}
+
+String &String::operator=(const char *s)
+{
+  assign(s, strlen(s));
+  return *this;
+}
+
+String &String::operator+=(const String &s)
+{
+  return *this += s.buffer;
+}
+
+String &String::operator+=(const char *s)
+{
+  size_t n = strlen(s);
+  char *next = new char[len + n + 1];
+  memcpy(next, buffer, len);
+  memcpy(next + len, s, n + 1);
+  delete[] buffer;
+  buffer = next;
+  len += n;
+  return *this;
+}
+
+void String::toCharArray(char *buf, unsigned int bufsize, unsigned int index) const
+{
+  if (!bufsize || !buf)
+  {
+    return;
+  }
+  if (index >= len)
+  {
+    buf[0] = '\0';
+    return;
+  }
+  unsigned int n = std::min((unsigned int)(len - index), bufsize - 1);
+  memcpy(buf, buffer + index, n);
+  buf[n] = '\0';
+}
@@ -0,0 +1,41 @@
+/*
+AEON_HostDS3231.h - Register model of the DS3231 real time clock for the host build.
+
+The model keeps its time as a Unix timestamp anchored to the host clock, so a
+virtual clock that runs fast also runs the RTC fast. Registers 0x00-0x06 are the
+BCD time registers, 0x0F holds the oscillator stop flag read by lostPower().
+*/
+
+#ifndef AEON_HOST_DS3231_h
+#define AEON_HOST_DS3231_h
+
+#include <stdint.h>
+#include "AEON_HostI2C.h"
+
+class AEON_HostDS3231 : public AEON_HostI2CDevice
+{
+private:
+  static constexpr uint8_t REGISTER_COUNT = 0x13;
+
+  uint8_t pointer;
+  uint8_t registers[REGISTER_COUNT];
+  uint32_t anchorUnix;
+  uint64_t anchorMicros;
+
+  void latchTime();
+  void storeTime();
+
+public:
+  static constexpr uint8_t ADDRESS = 0x68;
+
+  AEON_HostDS3231();
+
+  void setUnixTime(uint32_t unixTime);
+  uint32_t getUnixTime();
+  void setLostPower(bool lost);
+
+  void onWrite(const uint8_t *data, size_t length) override;
+  size_t onRead(uint8_t *data, size_t length) override;
+};
+
+#endif
@@ -0,0 +1,98 @@
+/*
+AEON_HostEEPROM.cpp - Host implementation of the EEPROM emulation.
+The sector lives in the NOR flash model, a commit erases it and programs the shadow like arduino-pico.
+*/
+
+#include <Arduino.h>
+#include <EEPROM.h>
+#include "AEON_HostEEPROM.h"
+#include "AEON_HostFlash.h"
+
+static_assert(AEON_HostEEPROM::SECTOR_SIZE == AEON_HostFlash::SECTOR_SIZE, "The EEPROM is one flash sector");
+
+EEPROMClass EEPROM;
+
+static uint32_t commitCount = 0;
+static bool commitFailure = false;
+
+uint32_t AEON_HostEEPROM::getCommitCount()
+{
+  return commitCount;
+}
+
+void AEON_HostEEPROM::setCommitFailure(bool fail)
+{
+  commitFailure = fail;
+}
+
+void AEON_HostEEPROM::erase()
+{
+  AEON_HostFlash::format();
+}
+
+const uint8_t *AEON_HostEEPROM::getFlash()
+{
+  return AEON_HostFlash::getData() + AEON_HostFlash::EEPROM_OFFSET;
+}
+
+void EEPROMClass::begin(size_t size)
+{
+  size = std::min(std::max(size, (size_t)256), AEON_HostEEPROM::SECTOR_SIZE);
+  delete[] data;
+  data = new uint8_t[size];
+  this->size = size;
+  memcpy(data, AEON_HostEEPROM::getFlash(), size);
+  dirty = false;
+}
+
+uint8_t EEPROMClass::read(int address)
+{
+  if (data == NULL || address < 0 || (size_t)address >= size)
+  {
+    return 0;
+  }
+  return data[address];
+}
+
+void EEPROMClass::write(int address, uint8_t value)
+{
+  if (data == NULL || address < 0 || (size_t)address >= size)
+  {
+    return;
+  }
+  if (data[address] != value)
+  {
+    data[address] = value;
+    dirty = true;
+  }
+}
+
+bool EEPROMClass::commit()
+{
+  if (data == NULL || commitFailure)
+  {
+    return false;
+  }
+  if (!dirty)
+  {
+    return true;
+  }
+  AEON_HostFlash::eraseSector(AEON_HostFlash::EEPROM_OFFSET);
+  AEON_HostFlash::program(AEON_HostFlash::EEPROM_OFFSET, data, size);
+  if (AEON_HostFlash::isPowerLost())
+  {
+    return false;
+  }
+  dirty = false;
+  commitCount++;
+  return true;
+}
+
+bool EEPROMClass::end()
+{
+  bool ok = commit();
+  delete[] data;
+  data = NULL;
+  size = 0;
+  return ok;
+}
@@ -0,0 +1,23 @@
+/*
+AEON_HostEEPROM.h - Controls for the host EEPROM emulation. erase() formats the whole flash model
+(AEON_HostFlash.h), getFlash() is the EEPROM sector in it.
+*/
+
+#ifndef AEON_HOST_EEPROM_CONTROL_h
+#define AEON_HOST_EEPROM_CONTROL_h
+
+#include <stdint.h>
+#include <stddef.h>
+
+class AEON_HostEEPROM
+{
+public:
+  static constexpr size_t SECTOR_SIZE = 4096;
+
+  static uint32_t getCommitCount();
+  static void setCommitFailure(bool fail);
+  static void erase();
+  static const uint8_t *getFlash();
+};
+
+#endif
@@ -0,0 +1,165 @@
+/*
+AEON_HostFlash.cpp
+*/
+
+#include <string.h>
+#include "AEON_Host.h"
+#include "AEON_HostFlash.h"
+
+static uint8_t flash[AEON_HostFlash::SIZE];
+static bool flashInitialised = false;
+static uint32_t eraseCounts[AEON_HostFlash::SECTOR_COUNT];
+static uint64_t busyMicros = 0;
+static uint64_t bytesProgrammed = 0;
+static uint64_t operationBytes = 0;
+static bool timedFlash = false;
+
+static bool cutArmed = false;
+static uint64_t cutRemaining = 0;
+static bool powerLost = false;
+
+static void initFlash()
+{
+  if (!flashInitialised)
+  {
+    memset(flash, 0xFF, sizeof(flash));
+    flashInitialised = true;
+  }
+}
+
+static void chargeTime(uint64_t us)
+{
+  busyMicros += us;
+  if (timedFlash && AEON_HostClock::isVirtual())
+  {
+    AEON_HostClock::advanceMicros(us);
+  }
+}
+
+/*
+Bytes of the next operation that are done before the power is gone
+*/
+static size_t bytesBeforeCut(size_t length)
+{
+  operationBytes += length;
+  if (!cutArmed)
+  {
+    return length;
+  }
+  if (cutRemaining >= length)
+  {
+    cutRemaining -= length;
+    return length;
+  }
+
+  size_t done = (size_t)cutRemaining;
+  cutArmed = false;
+  powerLost = true;
+  return done;
+}
+
+void AEON_HostFlash::eraseSector(size_t offset)
+{
+  initFlash();
+  if (powerLost || offset >= SIZE)
+  {
+    return;
+  }
+
+  offset -= offset % SECTOR_SIZE;
+  size_t done = bytesBeforeCut(SECTOR_SIZE);
+  memset(flash + offset, 0xFF, done);
+  if (done > 0)
+  {
+    eraseCounts[offset / SECTOR_SIZE]++;
+  }
+  chargeTime(ERASE_MICROS);
+}
+
+void AEON_HostFlash::program(size_t offset, const uint8_t *data, size_t length)
+{
+  initFlash();
+  if (powerLost || offset >= SIZE)
+  {
+    return;
+  }
+
+  if (length > SIZE - offset)
+  {
+    length = SIZE - offset;
+  }
+  size_t done = bytesBeforeCut(length);
+  for (size_t i = 0; i < done; i++)
+  {
+    flash[offset + i] &= data[i];
+  }
+  bytesProgrammed += done;
+
+  // Every page that is touched takes a page program
+  size_t pages = length ? (offset + length - 1) / PAGE_SIZE - offset / PAGE_SIZE + 1 : 0;
+  chargeTime((uint64_t)pages * PROGRAM_MICROS);
+}
+
+const uint8_t *AEON_HostFlash::getData()
+{
+  initFlash();
+  return flash;
+}
+
+void AEON_HostFlash::format()
+{
+  memset(flash, 0xFF, sizeof(flash));
+  flashInitialised = true;
+  memset(eraseCounts, 0, sizeof(eraseCounts));
+  busyMicros = 0;
+  bytesProgrammed = 0;
+  operationBytes = 0;
+}
+
+void AEON_HostFlash::setData(const uint8_t *image)
+{
+  memcpy(flash, image, sizeof(flash));
+  flashInitialised = true;
+}
+
+void AEON_HostFlash::setTimed(bool timed)
+{
+  timedFlash = timed;
+}
+
+uint64_t AEON_HostFlash::getBusyMicros()
+{
+  return busyMicros;
+}
+
+uint32_t AEON_HostFlash::getEraseCount(size_t sector)
+{
+  return sector < SECTOR_COUNT ? eraseCounts[sector] : 0;
+}
+
+uint64_t AEON_HostFlash::getBytesProgrammed()
+{
+  return bytesProgrammed;
+}
+
+uint64_t AEON_HostFlash::getOperationBytes()
+{
+  return operationBytes;
+}
+
+void AEON_HostFlash::setPowerCut(uint64_t operationBytes)
+{
+  cutArmed = true;
+  cutRemaining = operationBytes;
+}
+
+bool AEON_HostFlash::isPowerLost()
+{
+  return powerLost;
+}
+
+void AEON_HostFlash::restorePower()
+{
+  cutArmed = false;
+  powerLost = false;
+}
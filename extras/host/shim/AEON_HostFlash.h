@@ -0,0 +1,57 @@
+/*
+AEON_HostFlash.h - NOR flash model behind the host EEPROM emulation.
+
+The model keeps a region of SECTOR_COUNT sectors, the EEPROM emulation uses the last one, like
+arduino-pico uses the last sector of the flash. It behaves like NOR flash: an erase sets a sector to
+0xFF, a program can only clear bits (the new byte is old & data), reads are free.
+
+Timing (setTimed): erase and program take the typical times of the W25Q16JV on the Pico boards, the
+virtual clock moves by them. On the RP2040 both cores stand still meanwhile, the XIP flash is busy.
+Every sector counts its erases for the wear.
+
+Power cut: setPowerCut(n) cuts the power after n more operation bytes. An erase counts SECTOR_SIZE
+bytes and erases the sector from the start, a program counts its length. The operation in progress
+stops at the cut byte, the bytes before it are done, the others keep their old content. After the cut
+the flash ignores all operations until restorePower(), the caller boots again from what is left.
+*/
+
+#ifndef AEON_HOST_FLASH_h
+#define AEON_HOST_FLASH_h
+
+#include <stdint.h>
+#include <stddef.h>
+
+class AEON_HostFlash
+{
+public:
+  static constexpr size_t SECTOR_SIZE = 4096;
+  static constexpr size_t PAGE_SIZE = 256;
+  static constexpr size_t SECTOR_COUNT = 16;
+  static constexpr size_t SIZE = SECTOR_SIZE * SECTOR_COUNT;
+  static constexpr size_t EEPROM_OFFSET = SIZE - SECTOR_SIZE;
+
+  // W25Q16JV, typical
+  static constexpr uint32_t ERASE_MICROS = 45000;  // Sector erase
+  static constexpr uint32_t PROGRAM_MICROS = 400;  // Page program
+  static constexpr uint32_t ENDURANCE = 100000;    // Erase cycles per sector
+
+  static void eraseSector(size_t offset);
+  static void program(size_t offset, const uint8_t *data, size_t length);
+  static const uint8_t *getData(); // SIZE bytes
+
+  // All 0xFF and no wear, or a saved image (no wear, no time)
+  static void format();
+  static void setData(const uint8_t *image);
+
+  static void setTimed(bool timed);
+  static uint64_t getBusyMicros();
+  static uint32_t getEraseCount(size_t sector);
+  static uint64_t getBytesProgrammed();
+  static uint64_t getOperationBytes();
+
+  static void setPowerCut(uint64_t operationBytes);
+  static bool isPowerLost();
+  static void restorePower();
+};
+
+#endif
@@ -0,0 +1,417 @@
+/*
+AEON_HostGFX.cpp - Host implementation of the Adafruit GFX core and the classic 5x7 font.
+
+The font covers printable ASCII and a few code page 437 glyphs (0x81, 0x82, 0x84, 0x87,
+0x94). Other codes render as an empty cell. The firmware draws the characters above
+ASCII with its own glyphs (AEON_Font.h), they do not reach the font.
+*/
+
+#include <Arduino.h>
+#include <Adafruit_GFX.h>
+
+static const uint8_t font[][5] = {
+    {0x00, 0x00, 0x00, 0x00, 0x00}, // 0x20 ' '
+    {0x00, 0x00, 0x5F, 0x00, 0x00}, // 0x21 '!'
+    {0x00, 0x07, 0x00, 0x07, 0x00}, // 0x22 '"'
+    {0x14, 0x7F, 0x14, 0x7F, 0x14}, // 0x23 '#'
+    {0x24, 0x2A, 0x7F, 0x2A, 0x12}, // 0x24 '$'
+    {0x23, 0x13, 0x08, 0x64, 0x62}, // 0x25 '%'
+    {0x36, 0x49, 0x56, 0x20, 0x50}, // 0x26 '&'
+    {0x00, 0x08, 0x07, 0x03, 0x00}, // 0x27 '''
+    {0x00, 0x1C, 0x22, 0x41, 0x00}, // 0x28 '('
+    {0x00, 0x41, 0x22, 0x1C, 0x00}, // 0x29 ')'
+    {0x2A, 0x1C, 0x7F, 0x1C, 0x2A}, // 0x2A '*'
+    {0x08, 0x08, 0x3E, 0x08, 0x08}, // 0x2B '+'
+    {0x00, 0x80, 0x70, 0x30, 0x00}, // 0x2C ','
+    {0x08, 0x08, 0x08, 0x08, 0x08}, // 0x2D '-'
+    {0x00, 0x00, 0x60, 0x60, 0x00}, // 0x2E '.'
+    {0x20, 0x10, 0x08, 0x04, 0x02}, // 0x2F '/'
+    {0x3E, 0x51, 0x49, 0x45, 0x3E}, // 0x30 '0'
+    {0x00, 0x42, 0x7F, 0x40, 0x00}, // 0x31 '1'
+    {0x72, 0x49, 0x49, 0x49, 0x46}, // 0x32 '2'
+    {0x21, 0x41, 0x49, 0x4D, 0x33}, // 0x33 '3'
+    {0x18, 0x14, 0x12, 0x7F, 0x10}, // 0x34 '4'
+    {0x27, 0x45, 0x45, 0x45, 0x39}, // 0x35 '5'
+    {0x3C, 0x4A, 0x49, 0x49, 0x31}, // 0x36 '6'
+    {0x41, 0x21, 0x11, 0x09, 0x07}, // 0x37 '7'
+    {0x36, 0x49, 0x49, 0x49, 0x36}, // 0x38 '8'
+    {0x46, 0x49, 0x49, 0x29, 0x1E}, // 0x39 '9'
+    {0x00, 0x00, 0x14, 0x00, 0x00}, // 0x3A ':'
+    {0x00, 0x40, 0x34, 0x00, 0x00}, // 0x3B ';'
+    {0x00, 0x08, 0x14, 0x22, 0x41}, // 0x3C '<'
+    {0x14, 0x14, 0x14, 0x14, 0x14}, // 0x3D '='
+    {0x00, 0x41, 0x22, 0x14, 0x08}, // 0x3E '>'
+    {0x02, 0x01, 0x59, 0x09, 0x06}, // 0x3F '?'
+    {0x3E, 0x41, 0x5D, 0x59, 0x4E}, // 0x40 '@'
+    {0x7C, 0x12, 0x11, 0x12, 0x7C}, // 0x41 'A'
+    {0x7F, 0x49, 0x49, 0x49, 0x36}, // 0x42 'B'
+    {0x3E, 0x41, 0x41, 0x41, 0x22}, // 0x43 'C'
+    {0x7F, 0x41, 0x41, 0x41, 0x3E}, // 0x44 'D'
+    {0x7F, 0x49, 0x49, 0x49, 0x41}, // 0x45 'E'
+    {0x7F, 0x09, 0x09, 0x09, 0x01}, // 0x46 'F'
+    {0x3E, 0x41, 0x41, 0x51, 0x73}, // 0x47 'G'
+    {0x7F, 0x08, 0x08, 0x08, 0x7F}, // 0x48 'H'
+    {0x00, 0x41, 0x7F, 0x41, 0x00}, // 0x49 'I'
+    {0x20, 0x40, 0x41, 0x3F, 0x01}, // 0x4A 'J'
+    {0x7F, 0x08, 0x14, 0x22, 0x41}, // 0x4B 'K'
+    {0x7F, 0x40, 0x40, 0x40, 0x40}, // 0x4C 'L'
+    {0x7F, 0x02, 0x1C, 0x02, 0x7F}, // 0x4D 'M'
+    {0x7F, 0x04, 0x08, 0x10, 0x7F}, // 0x4E 'N'
+    {0x3E, 0x41, 0x41, 0x41, 0x3E}, // 0x4F 'O'
+    {0x7F, 0x09, 0x09, 0x09, 0x06}, // 0x50 'P'
+    {0x3E, 0x41, 0x51, 0x21, 0x5E}, // 0x51 'Q'
+    {0x7F, 0x09, 0x19, 0x29, 0x46}, // 0x52 'R'
+    {0x26, 0x49, 0x49, 0x49, 0x32}, // 0x53 'S'
+    {0x03, 0x01, 0x7F, 0x01, 0x03}, // 0x54 'T'
+    {0x3F, 0x40, 0x40, 0x40, 0x3F}, // 0x55 'U'
+    {0x1F, 0x20, 0x40, 0x20, 0x1F}, // 0x56 'V'
+    {0x3F, 0x40, 0x38, 0x40, 0x3F}, // 0x57 'W'
+    {0x63, 0x14, 0x08, 0x14, 0x63}, // 0x58 'X'
+    {0x03, 0x04, 0x78, 0x04, 0x03}, // 0x59 'Y'
+    {0x61, 0x59, 0x49, 0x4D, 0x43}, // 0x5A 'Z'
+    {0x00, 0x7F, 0x41, 0x41, 0x41}, // 0x5B '['
+    {0x02, 0x04, 0x08, 0x10, 0x20}, // 0x5C '\'
+    {0x00, 0x41, 0x41, 0x41, 0x7F}, // 0x5D ']'
+    {0x04, 0x02, 0x01, 0x02, 0x04}, // 0x5E '^'
+    {0x40, 0x40, 0x40, 0x40, 0x40}, // 0x5F '_'
+    {0x00, 0x03, 0x07, 0x08, 0x00}, // 0x60 '`'
+    {0x20, 0x54, 0x54, 0x78, 0x40}, // 0x61 'a'
+    {0x7F, 0x28, 0x44, 0x44, 0x38}, // 0x62 'b'
+    {0x38, 0x44, 0x44, 0x44, 0x28}, // 0x63 'c'
+    {0x38, 0x44, 0x44, 0x28, 0x7F}, // 0x64 'd'
+    {0x38, 0x54, 0x54, 0x54, 0x18}, // 0x65 'e'
+    {0x00, 0x08, 0x7E, 0x09, 0x02}, // 0x66 'f'
+    {0x18, 0xA4, 0xA4, 0x9C, 0x78}, // 0x67 'g'
+    {0x7F, 0x08, 0x04, 0x04, 0x78}, // 0x68 'h'
+    {0x00, 0x44, 0x7D, 0x40, 0x00}, // 0x69 'i'
+    {0x20, 0x40, 0x40, 0x3D, 0x00}, // 0x6A 'j'
+    {0x7F, 0x10, 0x28, 0x44, 0x00}, // 0x6B 'k'
+    {0x00, 0x41, 0x7F, 0x40, 0x00}, // 0x6C 'l'
+    {0x7C, 0x04, 0x78, 0x04, 0x78}, // 0x6D 'm'
+    {0x7C, 0x08, 0x04, 0x04, 0x78}, // 0x6E 'n'
+    {0x38, 0x44, 0x44, 0x44, 0x38}, // 0x6F 'o'
+    {0xFC, 0x18, 0x24, 0x24, 0x18}, // 0x70 'p'
+    {0x18, 0x24, 0x24, 0x18, 0xFC}, // 0x71 'q'
+    {0x7C, 0x08, 0x04, 0x04, 0x08}, // 0x72 'r'
+    {0x48, 0x54, 0x54, 0x54, 0x24}, // 0x73 's'
+    {0x04, 0x04, 0x3F, 0x44, 0x24}, // 0x74 't'
+    {0x3C, 0x40, 0x40, 0x20, 0x7C}, // 0x75 'u'
+    {0x1C, 0x20, 0x40, 0x20, 0x1C}, // 0x76 'v'
+    {0x3C, 0x40, 0x30, 0x40, 0x3C}, // 0x77 'w'
+    {0x44, 0x28, 0x10, 0x28, 0x44}, // 0x78 'x'
+    {0x4C, 0x90, 0x90, 0x90, 0x7C}, // 0x79 'y'
+    {0x44, 0x64, 0x54, 0x4C, 0x44}, // 0x7A 'z'
+    {0x00, 0x08, 0x36, 0x41, 0x00}, // 0x7B '{'
+    {0x00, 0x00, 0x77, 0x00, 0x00}, // 0x7C '|'
+    {0x00, 0x41, 0x36, 0x08, 0x00}, // 0x7D '}'
+    {0x02, 0x01, 0x02, 0x04, 0x02}, // 0x7E '~'
+};
+
+static const uint8_t *glyph(unsigned char c)
+{
+  static const uint8_t blank[5] = {0x00, 0x00, 0x00, 0x00, 0x00};
+  static const uint8_t cp437_81[5] = {0x3A, 0x40, 0x40, 0x20, 0x7A}; // u umlaut
+  static const uint8_t cp437_82[5] = {0x38, 0x54, 0x54, 0x55, 0x59}; // e acute
+  static const uint8_t cp437_84[5] = {0x21, 0x55, 0x55, 0x79, 0x41}; // a umlaut
+  static const uint8_t cp437_87[5] = {0x1C, 0xA2, 0xA2, 0xA2, 0x14}; // c cedilla
+  static const uint8_t cp437_94[5] = {0x3A, 0x44, 0x44, 0x44, 0x3A}; // o umlaut
+
+  if (c >= 0x20 && c <= 0x7E)
+  {
+    return font[c - 0x20];
+  }
+  switch (c)
+  {
+  case 0x81:
+    return cp437_81;
+  case 0x82:
+    return cp437_82;
+  case 0x84:
+    return cp437_84;
+  case 0x87:
+    return cp437_87;
+  case 0x94:
+    return cp437_94;
+  default:
+    return blank;
+  }
+}
+
+Adafruit_GFX::Adafruit_GFX(int16_t w, int16_t h)
+    : WIDTH(w), HEIGHT(h), _width(w), _height(h), cursor_x(0), cursor_y(0),
+      textcolor(0xFFFF), textbgcolor(0xFFFF), textsize_x(1), textsize_y(1),
+      rotation(0), wrap(true), _cp437(false)
+{
+}
+
+void Adafruit_GFX::setRotation(uint8_t r)
+{
+  rotation = (r & 3);
+  switch (rotation)
+  {
+  case 0:
+  case 2:
+    _width = WIDTH;
+    _height = HEIGHT;
+    break;
+  case 1:
+  case 3:
+    _width = HEIGHT;
+    _height = WIDTH;
+    break;
+  }
+}
+
+void Adafruit_GFX::setTextSize(uint8_t sx, uint8_t sy)
+{
+  textsize_x = (sx > 0) ? sx : 1;
+  textsize_y = (sy > 0) ? sy : 1;
+}
+
+void Adafruit_GFX::writeLine(int16_t x0, int16_t y0, int16_t x1, int16_t y1, uint16_t color)
+{
+  bool steep = abs(y1 - y0) > abs(x1 - x0);
+  if (steep)
+  {
+    std::swap(x0, y0);
+    std::swap(x1, y1);
+  }
+  if (x0 > x1)
+  {
+    std::swap(x0, x1);
+    std::swap(y0, y1);
+  }
+
+  int16_t dx = x1 - x0;
+  int16_t dy = abs(y1 - y0);
+  int16_t err = dx / 2;
+  int16_t ystep = (y0 < y1) ? 1 : -1;
+
+  for (; x0 <= x1; x0++)
+  {
+    if (steep)
+    {
+      writePixel(y0, x0, color);
+    }
+    else
+    {
+      writePixel(x0, y0, color);
+    }
+    err -= dy;
+    if (err < 0)
+    {
+      y0 += ystep;
+      err += dx;
+    }
+  }
+}
+
+void Adafruit_GFX::drawFastVLine(int16_t x, int16_t y, int16_t h, uint16_t color)
+{
+  startWrite();
+  writeLine(x, y, x, y + h - 1, color);
+  endWrite();
+}
+
+void Adafruit_GFX::drawFastHLine(int16_t x, int16_t y, int16_t w, uint16_t color)
+{
+  startWrite();
+  writeLine(x, y, x + w - 1, y, color);
+  endWrite();
+}
+
+void Adafruit_GFX::fillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color)
+{
+  startWrite();
+  for (int16_t i = x; i < x + w; i++)
+  {
+    writeFastVLine(i, y, h, color);
+  }
+  endWrite();
+}
+
+void Adafruit_GFX::drawLine(int16_t x0, int16_t y0, int16_t x1, int16_t y1, uint16_t color)
+{
+  if (x0 == x1)
+  {
+    if (y0 > y1)
+    {
+      std::swap(y0, y1);
+    }
+    drawFastVLine(x0, y0, y1 - y0 + 1, color);
+  }
+  else if (y0 == y1)
+  {
+    if (x0 > x1)
+    {
+      std::swap(x0, x1);
+    }
+    drawFastHLine(x0, y0, x1 - x0 + 1, color);
+  }
+  else
+  {
+    startWrite();
+    writeLine(x0, y0, x1, y1, color);
+    endWrite();
+  }
+}
+
+void Adafruit_GFX::drawRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color)
+{
+  startWrite();
+  writeFastHLine(x, y, w, color);
+  writeFastHLine(x, y + h - 1, w, color);
+  writeFastVLine(x, y, h, color);
+  writeFastVLine(x + w - 1, y, h, color);
+  endWrite();
+}
+
+void Adafruit_GFX::drawChar(int16_t x, int16_t y, unsigned char c, uint16_t color, uint16_t bg, uint8_t size_x, uint8_t size_y)
+{
+  if ((x >= _width) || (y >= _height) || ((x + 6 * size_x - 1) < 0) || ((y + 8 * size_y - 1) < 0))
+  {
+    return;
+  }
+
+  if (!_cp437 && (c >= 176))
+  {
+    c++;
+  }
+
+  const uint8_t *bitmap = glyph(c);
+
+  startWrite();
+  for (int8_t i = 0; i < 5; i++)
+  {
+    uint8_t line = bitmap[i];
+    for (int8_t j = 0; j < 8; j++, line >>= 1)
+    {
+      if (line & 1)
+      {
+        if (size_x == 1 && size_y == 1)
+        {
+          writePixel(x + i, y + j, color);
+        }
+        else
+        {
+          writeFillRect(x + i * size_x, y + j * size_y, size_x, size_y, color);
+        }
+      }
+      else if (bg != color)
+      {
+        if (size_x == 1 && size_y == 1)
+        {
+          writePixel(x + i, y + j, bg);
+        }
+        else
+        {
+          writeFillRect(x + i * size_x, y + j * size_y, size_x, size_y, bg);
+        }
+      }
+    }
+  }
+  if (bg != color)
+  {
+    if (size_x == 1 && size_y == 1)
+    {
+      writeFastVLine(x + 5, y, 8, bg);
+    }
+    else
+    {
+      writeFillRect(x + 5 * size_x, y, size_x, 8 * size_y, bg);
+    }
+  }
+  endWrite();
+}
+
+size_t Adafruit_GFX::write(uint8_t c)
+{
+  if (c == '\n')
+  {
+    cursor_x = 0;
+    cursor_y += textsize_y * 8;
+  }
+  else if (c != '\r')
+  {
+    if (wrap && ((cursor_x + textsize_x * 6) > _width))
+    {
+      cursor_x = 0;
+      cursor_y += textsize_y * 8;
+    }
+    drawChar(cursor_x, cursor_y, c, textcolor, textbgcolor, textsize_x, textsize_y);
+    cursor_x += textsize_x * 6;
+  }
+  return 1;
+}
+
+void Adafruit_GFX::charBounds(unsigned char c, int16_t *x, int16_t *y, int16_t *minx, int16_t *miny, int16_t *maxx, int16_t *maxy)
+{
+  if (c == '\n')
+  {
+    *x = 0;
+    *y += textsize_y * 8;
+  }
+  else if (c != '\r')
+  {
+    if (wrap && ((*x + textsize_x * 6) > _width))
+    {
+      *x = 0;
+      *y += textsize_y * 8;
+    }
+    int x2 = *x + textsize_x * 6 - 1;
+    int y2 = *y + textsize_y * 8 - 1;
+    if (x2 > *maxx)
+    {
+      *maxx = x2;
+    }
+    if (y2 > *maxy)
+    {
+      *maxy = y2;
+    }
+    if (*x < *minx)
+    {
+      *minx = *x;
+    }
+    if (*y < *miny)
+    {
+      *miny = *y;
+    }
+    *x += textsize_x * 6;
+  }
+}
+
+void Adafruit_GFX::getTextBounds(const char *str, int16_t x, int16_t y, int16_t *x1, int16_t *y1, uint16_t *w, uint16_t *h)
+{
+  uint8_t c;
+  int16_t minx = 0x7FFF, miny = 0x7FFF, maxx = -1, maxy = -1;
+
+  *x1 = x;
+  *y1 = y;
+  *w = *h = 0;
+
+  while ((c = *str++))
+  {
+    charBounds(c, &x, &y, &minx, &miny, &maxx, &maxy);
+  }
+
+  if (maxx >= minx)
+  {
+    *x1 = minx;
+    *w = maxx - minx + 1;
+  }
+  if (maxy >= miny)
+  {
+    *y1 = miny;
+    *h = maxy - miny + 1;
+  }
+}
+
+void Adafruit_GFX::getTextBounds(const __FlashStringHelper *s, int16_t x, int16_t y, int16_t *x1, int16_t *y1, uint16_t *w, uint16_t *h)
+{
+  getTextBounds(reinterpret_cast<const char *>(s), x, y, x1, y1, w, h);
+}
+
+void Adafruit_GFX::getTextBounds(const String &str, int16_t x, int16_t y, int16_t *x1, int16_t *y1, uint16_t *w, uint16_t *h)
+{
+  getTextBounds(str.c_str(), x, y, x1, y1, w, h);
+}
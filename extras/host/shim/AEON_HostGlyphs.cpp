@@ -0,0 +1,172 @@
+/*
+AEON_HostGlyphs.cpp
+*/
+
+#include <string.h>
+#include "AEON_HostGlyphs.h"
+
+enum EMark
+{
+  MARK_NONE,
+  MARK_ACUTE,
+  MARK_GRAVE,
+  MARK_CIRCUMFLEX,
+  MARK_DIAERESIS,
+  MARK_TILDE,
+  MARK_CEDILLA
+};
+
+// Rows 0-1
+static const char *const marks[][2] = {
+    {".....", "....."}, // none
+    {"...#.", "..#.."}, // acute
+    {".#...", "..#.."}, // grave
+    {"..#..", ".#.#."}, // circumflex
+    {".#.#.", "....."}, // diaeresis
+    {".##.#", "#..#."}, // tilde
+    {".....", "....."}, // cedilla, row 7
+};
+
+typedef struct
+{
+  char letter;
+  const char *rows[6]; // Rows 2-7
+} SFONTGEN_LETTER;
+
+// Small letters like the classic font, capitals 5 rows high
+static const SFONTGEN_LETTER letters[] = {
+    {'a', {".##..", "...#.", ".###.", "#..#.", ".####", "....."}},
+    {'c', {".###.", "#...#", "#....", "#...#", ".###.", "....."}},
+    {'e', {".###.", "#...#", "#####", "#....", ".###.", "....."}},
+    {'i', {".##..", "..#..", "..#..", "..#..", ".###.", "....."}},
+    {'n', {"#.##.", "##..#", "#...#", "#...#", "#...#", "....."}},
+    {'o', {".###.", "#...#", "#...#", "#...#", ".###.", "....."}},
+    {'u', {"#...#", "#...#", "#...#", "#..##", ".##.#", "....."}},
+    {'y', {"#...#", "#...#", ".####", "....#", "#...#", ".###."}},
+    {'A', {".###.", "#...#", "#####", "#...#", "#...#", "....."}},
+    {'C', {".####", "#....", "#....", "#....", ".####", "....."}},
+    {'E', {"#####", "#....", "####.", "#....", "#####", "....."}},
+    {'I', {".###.", "..#..", "..#..", "..#..", ".###.", "....."}},
+    {'N', {"#...#", "##..#", "#.#.#", "#..##", "#...#", "....."}},
+    {'O', {".###.", "#...#", "#...#", "#...#", ".###.", "....."}},
+    {'U', {"#...#", "#...#", "#...#", "#...#", ".###.", "....."}},
+};
+
+typedef struct
+{
+  uint32_t character;
+  char letter;
+  EMark mark;
+} SFONTGEN_COMPOSED;
+
+static const SFONTGEN_COMPOSED composed[] = {
+    {0x00C0, 'A', MARK_GRAVE}, {0x00C1, 'A', MARK_ACUTE}, {0x00C2, 'A', MARK_CIRCUMFLEX}, {0x00C4, 'A', MARK_DIAERESIS},
+    {0x00C7, 'C', MARK_CEDILLA}, {0x00C8, 'E', MARK_GRAVE}, {0x00C9, 'E', MARK_ACUTE}, {0x00CA, 'E', MARK_CIRCUMFLEX},
+    {0x00CB, 'E', MARK_DIAERESIS}, {0x00CC, 'I', MARK_GRAVE}, {0x00CD, 'I', MARK_ACUTE}, {0x00CE, 'I', MARK_CIRCUMFLEX}, {0x00CF, 'I', MARK_DIAERESIS},
+    {0x00D1, 'N', MARK_TILDE}, {0x00D2, 'O', MARK_GRAVE}, {0x00D3, 'O', MARK_ACUTE}, {0x00D4, 'O', MARK_CIRCUMFLEX}, {0x00D6, 'O', MARK_DIAERESIS},
+    {0x00D9, 'U', MARK_GRAVE}, {0x00DA, 'U', MARK_ACUTE}, {0x00DB, 'U', MARK_CIRCUMFLEX}, {0x00DC, 'U', MARK_DIAERESIS},
+    {0x00E0, 'a', MARK_GRAVE}, {0x00E1, 'a', MARK_ACUTE}, {0x00E2, 'a', MARK_CIRCUMFLEX}, {0x00E4, 'a', MARK_DIAERESIS},
+    {0x00E7, 'c', MARK_CEDILLA}, {0x00E8, 'e', MARK_GRAVE}, {0x00E9, 'e', MARK_ACUTE}, {0x00EA, 'e', MARK_CIRCUMFLEX},
+    {0x00EB, 'e', MARK_DIAERESIS}, {0x00EC, 'i', MARK_GRAVE}, {0x00ED, 'i', MARK_ACUTE}, {0x00EE, 'i', MARK_CIRCUMFLEX},
+    {0x00EF, 'i', MARK_DIAERESIS}, {0x00F1, 'n', MARK_TILDE}, {0x00F2, 'o', MARK_GRAVE}, {0x00F3, 'o', MARK_ACUTE},
+    {0x00F4, 'o', MARK_CIRCUMFLEX}, {0x00F6, 'o', MARK_DIAERESIS}, {0x00F9, 'u', MARK_GRAVE}, {0x00FA, 'u', MARK_ACUTE},
+    {0x00FB, 'u', MARK_CIRCUMFLEX}, {0x00FC, 'u', MARK_DIAERESIS}, {0x00FF, 'y', MARK_DIAERESIS},
+};
+
+typedef struct
+{
+  uint32_t character;
+  const char *rows[8];
+} SFONTGEN_WHOLE;
+
+static const SFONTGEN_WHOLE whole[] = {
+    {0x00A1, {"..#..", ".....", "..#..", "..#..", "..#..", "..#..", "..#..", "....."}}, // inverted !
+    {0x00B0, {".##..", "#..#.", "#..#.", ".##..", ".....", ".....", ".....", "....."}}, // degree
+    {0x00BF, {"..#..", ".....", "..#..", ".#...", "#....", "#...#", ".###.", "....."}}, // inverted ?
+    {0x00DF, {".##..", "#..#.", "#.#..", "#..#.", "#...#", "#...#", "#.##.", "....."}}, // sharp s
+};
+
+/*
+Glyph rows of a character, false when there is none
+*/
+static bool rowsOf(uint32_t character, const char *rows[8])
+{
+  for (const SFONTGEN_WHOLE &glyph : whole)
+  {
+    if (glyph.character == character)
+    {
+      memcpy(rows, glyph.rows, sizeof(glyph.rows));
+      return true;
+    }
+  }
+
+  for (const SFONTGEN_COMPOSED &glyph : composed)
+  {
+    if (glyph.character != character)
+    {
+      continue;
+    }
+    for (const SFONTGEN_LETTER &letter : letters)
+    {
+      if (letter.letter == glyph.letter)
+      {
+        rows[0] = marks[glyph.mark][0];
+        rows[1] = marks[glyph.mark][1];
+        for (int row = 0; row < 6; row++)
+        {
+          rows[row + 2] = letter.rows[row];
+        }
+        if (glyph.mark == MARK_CEDILLA)
+        {
+          rows[7] = "..#..";
+        }
+        return true;
+      }
+    }
+  }
+  return false;
+}
+
+/*
+Columns of the classic font: bit 0 is row 0
+*/
+bool AEON_HostGlyphs::getColumns(uint32_t character, uint8_t columns[5])
+{
+  const char *rows[8];
+  if (!rowsOf(character, rows))
+  {
+    return false;
+  }
+
+  for (int column = 0; column < 5; column++)
+  {
+    columns[column] = 0;
+    for (int row = 0; row < 8; row++)
+    {
+      if (rows[row][column] == '#')
+      {
+        columns[column] |= 1 << row;
+      }
+    }
+  }
+  return true;
+}
+
+/*
+UTF-8 of a character below U+10000
+*/
+std::string AEON_HostGlyphs::toUtf8(uint32_t character)
+{
+  std::string text;
+  if (character < 0x800)
+  {
+    text += (char)(0xC0 | (character >> 6));
+  }
+  else
+  {
+    text += (char)(0xE0 | (character >> 12));
+    text += (char)(0x80 | ((character >> 6) & 0x3F));
+  }
+  text += (char)(0x80 | (character & 0x3F));
+  return text;
+}
@@ -0,0 +1,24 @@
+/*
+AEON_HostGlyphs.h - Glyphs above ASCII for the host tools that build fonts and language packs
+(aeon_fontgen, aeon_pack).
+
+The glyphs are composed from a letter and a mark in the format of the classic 5x7 font: the marks sit
+in rows 0-1 above the x-height of the small letters, capitals are drawn 5 rows high below the mark, the
+cedilla hangs in row 7. A few characters are drawn whole. The firmware gets only the glyphs it uses,
+in AEON_FontGlyphs.h or in a language pack.
+*/
+
+#ifndef AEON_HOST_GLYPHS_h
+#define AEON_HOST_GLYPHS_h
+
+#include <stdint.h>
+#include <string>
+
+class AEON_HostGlyphs
+{
+public:
+  static bool getColumns(uint32_t character, uint8_t columns[5]); // false without a glyph
+  static std::string toUtf8(uint32_t character);
+};
+
+#endif
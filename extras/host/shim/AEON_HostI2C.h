@@ -0,0 +1,51 @@
+/*
+AEON_HostI2C.h - Device models and accounting behind the host Wire stand-in.
+
+A device model receives every write transaction addressed to it as one block and
+answers read requests. The bus keeps per-address byte and transaction counters and
+can charge the transfer time to the virtual clock, so host tools see the same bus
+occupancy the real 400 kHz bus would have.
+*/
+
+#ifndef AEON_HOST_I2C_h
+#define AEON_HOST_I2C_h
+
+#include <stdint.h>
+#include <stddef.h>
+
+class AEON_HostI2CDevice
+{
+public:
+  virtual ~AEON_HostI2CDevice() {}
+  virtual void onWrite(const uint8_t *data, size_t length) = 0;
+  virtual size_t onRead(uint8_t *data, size_t length) = 0;
+};
+
+typedef struct
+{
+  uint32_t transactions;
+  uint32_t bytesWritten;
+  uint32_t bytesRead;
+  uint32_t failures;
+} SHOST_I2C_STATS;
+
+class AEON_HostI2C
+{
+public:
+  static constexpr int ADDRESS_COUNT = 128;
+
+  static void attach(uint8_t address, AEON_HostI2CDevice *device);
+  static void detach(uint8_t address);
+  static AEON_HostI2CDevice *getDevice(uint8_t address);
+
+  static SHOST_I2C_STATS getStats(uint8_t address);
+  static SHOST_I2C_STATS getTotalStats();
+  static void resetStats();
+
+  // Charge the transfer time (9 clocks per byte plus start/stop) to the virtual clock
+  static void setTimed(bool timed);
+  static bool isTimed();
+  static void chargeTransfer(uint32_t clock, size_t bytes);
+};
+
+#endif
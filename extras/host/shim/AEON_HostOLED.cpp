@@ -0,0 +1,388 @@
+/*
+AEON_HostOLED.cpp
+*/
+
+#include <string.h>
+#include "AEON_HostOLED.h"
+
+#define OLED_CONTROL_CONTINUATION 0x80 // Co = 1: one byte, then the next control byte
+#define OLED_CONTROL_DATA 0x40         // D/C = 1: GDDRAM data
+
+#define OLED_STATUS_DISPLAY_OFF 0x40
+
+#define COUNT(field, n) \
+  do                    \
+  {                     \
+    total.field += n;   \
+    current.field += n; \
+  } while (0)
+
+AEON_HostOLED::AEON_HostOLED()
+{
+  memset(ram, 0, sizeof(ram));
+
+  // Reset values of the datasheet
+  addressing = OLED_ADDRESSING_PAGE;
+  column = 0;
+  page = 0;
+  columnStart = 0;
+  columnEnd = 127;
+  pageStart = 0;
+  pageEnd = 7;
+  pageModeColumn = 0;
+
+  displayOn = false;
+  inverse = false;
+  entireOn = false;
+  contrast = 0x7F;
+  startLine = 0;
+  displayOffset = 0;
+  multiplex = 63;
+  segmentRemap = false;
+  comScanDecrement = false;
+  comPins = 0x12;
+
+  scrollActive = false;
+  scrollCommand = 0;
+  memset(scrollArguments, 0, sizeof(scrollArguments));
+
+  command = 0;
+  argumentIndex = 0;
+  argumentsPending = 0;
+
+  resetStats();
+}
+
+/*
+Number of argument bytes that follow a command
+*/
+static uint8_t argumentCount(uint8_t command)
+{
+  switch (command)
+  {
+  case 0x26: // RIGHT_HORIZONTAL_SCROLL
+  case 0x27: // LEFT_HORIZONTAL_SCROLL
+    return 6;
+  case 0x29: // VERTICAL_AND_RIGHT_HORIZONTAL_SCROLL
+  case 0x2A: // VERTICAL_AND_LEFT_HORIZONTAL_SCROLL
+    return 5;
+  case 0x21: // COLUMNADDR
+  case 0x22: // PAGEADDR
+  case 0xA3: // SET_VERTICAL_SCROLL_AREA
+    return 2;
+  case 0x20: // MEMORYMODE
+  case 0x81: // SETCONTRAST
+  case 0x8D: // CHARGEPUMP
+  case 0xA8: // SETMULTIPLEX
+  case 0xD3: // SETDISPLAYOFFSET
+  case 0xD5: // SETDISPLAYCLOCKDIV
+  case 0xD9: // SETPRECHARGE
+  case 0xDA: // SETCOMPINS
+  case 0xDB: // SETVCOMDETECT
+    return 1;
+  default:
+    return 0;
+  }
+}
+
+/*
+Collect the arguments, then execute
+*/
+void AEON_HostOLED::runCommand(uint8_t value)
+{
+  COUNT(commandBytes, 1);
+
+  if (argumentsPending > 0)
+  {
+    arguments[argumentIndex++] = value;
+    if (--argumentsPending == 0)
+    {
+      execute(command, arguments);
+    }
+    return;
+  }
+
+  command = value;
+  argumentIndex = 0;
+  argumentsPending = argumentCount(value);
+  if (argumentsPending == 0)
+  {
+    execute(command, arguments);
+  }
+}
+
+/*
+One command with its arguments, the registers change as on the SSD1306
+*/
+void AEON_HostOLED::execute(uint8_t command, const uint8_t *arguments)
+{
+  // Page mode: lower and higher nibble of the column start, page start
+  if (command <= 0x0F)
+  {
+    pageModeColumn = (pageModeColumn & 0xF0) | command;
+    column = pageModeColumn & 0x7F;
+    return;
+  }
+  if (command <= 0x1F)
+  {
+    pageModeColumn = (pageModeColumn & 0x0F) | ((command & 0x0F) << 4);
+    column = pageModeColumn & 0x7F;
+    return;
+  }
+  if (command >= 0xB0 && command <= 0xB7)
+  {
+    page = command & 0x07;
+    return;
+  }
+  if (command >= 0x40 && command <= 0x7F)
+  {
+    startLine = command & 0x3F;
+    return;
+  }
+
+  switch (command)
+  {
+  case 0x20: // MEMORYMODE
+    addressing = (arguments[0] & 0x03) <= OLED_ADDRESSING_PAGE ? (EHostOLEDAddressing)(arguments[0] & 0x03) : addressing;
+    break;
+
+  // The windows only apply to the horizontal and vertical mode
+  case 0x21: // COLUMNADDR
+    if (addressing != OLED_ADDRESSING_PAGE)
+    {
+      columnStart = arguments[0] & 0x7F;
+      columnEnd = arguments[1] & 0x7F;
+      column = columnStart;
+    }
+    break;
+
+  case 0x22: // PAGEADDR
+    if (addressing != OLED_ADDRESSING_PAGE)
+    {
+      pageStart = arguments[0] & 0x07;
+      pageEnd = arguments[1] & 0x07;
+      page = pageStart;
+    }
+    break;
+
+  case 0x26:
+  case 0x27:
+  case 0x29:
+  case 0x2A:
+    scrollCommand = command;
+    memcpy(scrollArguments, arguments, argumentCount(command));
+    break;
+
+  case 0xA3: // SET_VERTICAL_SCROLL_AREA
+  case 0x8D: // CHARGEPUMP
+  case 0xD5: // SETDISPLAYCLOCKDIV
+  case 0xD9: // SETPRECHARGE
+  case 0xDB: // SETVCOMDETECT
+  case 0xE3: // NOP
+    break;
+
+  case 0x2E: // DEACTIVATE_SCROLL
+    scrollActive = false;
+    break;
+
+  case 0x2F: // ACTIVATE_SCROLL
+    scrollActive = (scrollCommand != 0);
+    break;
+
+  case 0x81: // SETCONTRAST
+    contrast = arguments[0];
+    break;
+
+  case 0xA0: // SEGREMAP
+  case 0xA1:
+    segmentRemap = command & 0x01;
+    break;
+
+  case 0xA4: // DISPLAYALLON_RESUME
+  case 0xA5: // DISPLAYALLON
+    entireOn = command & 0x01;
+    break;
+
+  case 0xA6: // NORMALDISPLAY
+  case 0xA7: // INVERTDISPLAY
+    inverse = command & 0x01;
+    break;
+
+  case 0xA8: // SETMULTIPLEX
+    multiplex = (arguments[0] & 0x3F) < 15 ? multiplex : (arguments[0] & 0x3F);
+    break;
+
+  case 0xAE: // DISPLAYOFF
+  case 0xAF: // DISPLAYON
+    displayOn = command & 0x01;
+    break;
+
+  case 0xC0: // COMSCANINC
+  case 0xC8: // COMSCANDEC
+    comScanDecrement = command & 0x08;
+    break;
+
+  case 0xD3: // SETDISPLAYOFFSET
+    displayOffset = arguments[0] & 0x3F;
+    break;
+
+  case 0xDA: // SETCOMPINS
+    comPins = arguments[0];
+    break;
+
+  default:
+    COUNT(unknownCommands, 1);
+    break;
+  }
+}
+
+/*
+Write one byte at the address pointer and move it like the addressing mode does
+*/
+void AEON_HostOLED::writeData(uint8_t value)
+{
+  COUNT(dataBytes, 1);
+
+  uint8_t &cell = ram[column + page * 128];
+  if (cell == value)
+  {
+    COUNT(redundantBytes, 1);
+  }
+  cell = value;
+
+  switch (addressing)
+  {
+  case OLED_ADDRESSING_HORIZONTAL:
+    if (++column > columnEnd)
+    {
+      column = columnStart;
+      if (++page > pageEnd)
+      {
+        page = pageStart;
+        endFrame();
+      }
+    }
+    break;
+
+  case OLED_ADDRESSING_VERTICAL:
+    if (++page > pageEnd)
+    {
+      page = pageStart;
+      if (++column > columnEnd)
+      {
+        column = columnStart;
+        endFrame();
+      }
+    }
+    break;
+
+  case OLED_ADDRESSING_PAGE:
+    // The page stays, the column goes back to the column start
+    if (++column > 127)
+    {
+      column = pageModeColumn & 0x7F;
+      if (page == 7)
+      {
+        endFrame();
+      }
+    }
+    break;
+  }
+}
+
+/*
+The window is full, the bytes since the last frame belong to this one
+*/
+void AEON_HostOLED::endFrame()
+{
+  COUNT(frames, 1);
+  lastFrame = current;
+  memset(&current, 0, sizeof(current));
+}
+
+/*
+Counters back to 0
+*/
+void AEON_HostOLED::resetStats()
+{
+  memset(&total, 0, sizeof(total));
+  memset(&current, 0, sizeof(current));
+  memset(&lastFrame, 0, sizeof(lastFrame));
+}
+
+/*
+Panel image at x, y
+*/
+bool AEON_HostOLED::getPixel(int x, int y)
+{
+  if (!displayOn || x < 0 || x >= WIDTH || y < 0 || y > multiplex)
+  {
+    return false;
+  }
+  if (entireOn)
+  {
+    return true;
+  }
+
+  int row = comScanDecrement ? y : multiplex - y;
+  row = (row + startLine + displayOffset) & (HEIGHT - 1);
+  int col = segmentRemap ? x : WIDTH - 1 - x;
+
+  bool lit = ram[col + (row / 8) * WIDTH] & (1 << (row & 7));
+  return lit != inverse;
+}
+
+/*
+Pixels as the panel shows them, one byte per pixel
+*/
+void AEON_HostOLED::getPanel(uint8_t *pixels)
+{
+  for (int y = 0; y < HEIGHT; y++)
+  {
+    for (int x = 0; x < WIDTH; x++)
+    {
+      pixels[x + y * WIDTH] = getPixel(x, y);
+    }
+  }
+}
+
+/*
+Control byte, then commands or data. With Co set only one byte follows before the next control byte.
+*/
+void AEON_HostOLED::onWrite(const uint8_t *data, size_t length)
+{
+  if (length == 0)
+  {
+    return;
+  }
+  COUNT(transactions, 1);
+
+  size_t i = 0;
+  while (i < length)
+  {
+    uint8_t control = data[i++];
+    COUNT(controlBytes, 1);
+
+    size_t end = (control & OLED_CONTROL_CONTINUATION) ? (i < length ? i + 1 : i) : length;
+    for (; i < end; i++)
+    {
+      if (control & OLED_CONTROL_DATA)
+      {
+        writeData(data[i]);
+      }
+      else
+      {
+        runCommand(data[i]);
+      }
+    }
+  }
+}
+
+/*
+Status byte, D6 = display off
+*/
+size_t AEON_HostOLED::onRead(uint8_t *data, size_t length)
+{
+  memset(data, displayOn ? 0 : OLED_STATUS_DISPLAY_OFF, length);
+  return length;
+}
@@ -0,0 +1,121 @@
+/*
+AEON_HostOLED.h - Register model of an SSD1306 / SSD1309 controller for the host build.
+
+The model decodes the I2C stream like the controller does. Every transaction starts with a control byte:
+Co (bit 7) set means one byte follows and then the next control byte, D/C (bit 6) selects commands or
+GDDRAM data. Commands may end in one transaction and get their arguments in the next one (the Adafruit
+init does that). Decoded are
+
+  addressing  MEMORYMODE (horizontal, vertical, page), COLUMNADDR / PAGEADDR windows, page start and
+              lower / higher column start of the page mode
+  panel       display on / off, contrast, normal / inverse, entire display on, start line, display
+              offset, multiplex, segment remap, COM scan direction, COM pins
+  scroll      horizontal and diagonal setup, vertical scroll area, activate / deactivate (kept as state,
+              the panel image does not move)
+  other       clock, precharge, VCOMH, charge pump, NOP
+
+Unknown commands are counted. GDDRAM is 128 x 64 like on both controllers, the panel image applies
+start line, offset, multiplex, remap, scan direction, inverse, entire on and display off. The panel is
+taken as mounted so the Adafruit orientation (segment remap, COM scan decrement) shows GDDRAM upright.
+
+Bus efficiency: control, command and data bytes are counted in total and per frame. A frame ends when
+the data has filled the address window (the write pointer is back at the start of the window), the
+counts of the last frame stay readable until the next one ends. Data bytes that did not change GDDRAM
+are counted as redundant.
+*/
+
+#ifndef AEON_HOST_OLED_h
+#define AEON_HOST_OLED_h
+
+#include <stdint.h>
+#include "AEON_HostI2C.h"
+
+typedef struct
+{
+  uint32_t transactions;
+  uint32_t controlBytes;
+  uint32_t commandBytes; // Commands and their arguments
+  uint32_t dataBytes;
+  uint32_t redundantBytes; // Data bytes equal to GDDRAM
+  uint32_t unknownCommands;
+  uint32_t frames;
+} SHOST_OLED_STATS;
+
+enum EHostOLEDAddressing
+{
+  OLED_ADDRESSING_HORIZONTAL,
+  OLED_ADDRESSING_VERTICAL,
+  OLED_ADDRESSING_PAGE
+};
+
+class AEON_HostOLED : public AEON_HostI2CDevice
+{
+private:
+  uint8_t ram[128 * 8];
+
+  // Address pointer and window
+  EHostOLEDAddressing addressing;
+  uint8_t column, page;
+  uint8_t columnStart, columnEnd;
+  uint8_t pageStart, pageEnd;
+  uint8_t pageModeColumn; // Column start of the page mode
+
+  // Panel
+  bool displayOn;
+  bool inverse;
+  bool entireOn;
+  uint8_t contrast;
+  uint8_t startLine;
+  uint8_t displayOffset;
+  uint8_t multiplex; // Rows - 1
+  bool segmentRemap;
+  bool comScanDecrement;
+  uint8_t comPins;
+
+  // Scroll
+  bool scrollActive;
+  uint8_t scrollCommand;
+  uint8_t scrollArguments[6];
+
+  // Command decoder
+  uint8_t command;
+  uint8_t arguments[6];
+  uint8_t argumentIndex;
+  uint8_t argumentsPending;
+
+  SHOST_OLED_STATS total;
+  SHOST_OLED_STATS current;
+  SHOST_OLED_STATS lastFrame;
+
+  void runCommand(uint8_t value);
+  void execute(uint8_t command, const uint8_t *arguments);
+  void writeData(uint8_t value);
+  void endFrame();
+
+public:
+  static constexpr uint8_t ADDRESS = 0x3C;
+  static constexpr size_t RAM_SIZE = 128 * 8;
+  static constexpr int WIDTH = 128;
+  static constexpr int HEIGHT = 64;
+
+  AEON_HostOLED();
+
+  const uint8_t *getRAM() { return ram; }
+  bool getPixel(int x, int y); // Panel image, true = lit
+  void getPanel(uint8_t *pixels); // WIDTH * HEIGHT bytes, 1 = lit
+
+  bool isDisplayOn() { return displayOn; }
+  bool isInverse() { return inverse; }
+  bool isScrollActive() { return scrollActive; }
+  uint8_t getContrast() { return contrast; }
+  EHostOLEDAddressing getAddressing() { return addressing; }
+
+  SHOST_OLED_STATS getStats() { return total; }
+  SHOST_OLED_STATS getLastFrame() { return lastFrame; }
+  void resetStats();
+
+  void onWrite(const uint8_t *data, size_t length) override;
+  size_t onRead(uint8_t *data, size_t length) override;
+};
+
+#endif
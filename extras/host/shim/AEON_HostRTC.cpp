@@ -0,0 +1,328 @@
+/*
+AEON_HostRTC.cpp - Host implementation of RTClib and the DS3231 register model.
+*/
+
+#include <Arduino.h>
+#include <RTClib.h>
+#include "AEON_Host.h"
+#include "AEON_HostDS3231.h"
+
+static uint8_t bin2bcd(uint8_t value)
+{
+  return value + 6 * (value / 10);
+}
+
+static uint8_t bcd2bin(uint8_t value)
+{
+  return value - 6 * (value >> 4);
+}
+
+/*
+Days since 1970-01-01 for a civil date (proleptic Gregorian)
+*/
+static int32_t daysFromCivil(int32_t y, uint32_t m, uint32_t d)
+{
+  y -= m <= 2;
+  const int32_t era = (y >= 0 ? y : y - 399) / 400;
+  const uint32_t yoe = (uint32_t)(y - era * 400);
+  const uint32_t doy = (153 * (m + (m > 2 ? -3 : 9)) + 2) / 5 + d - 1;
+  const uint32_t doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+  return era * 146097 + (int32_t)doe - 719468;
+}
+
+static void civilFromDays(int32_t z, int32_t &y, uint32_t &m, uint32_t &d)
+{
+  z += 719468;
+  const int32_t era = (z >= 0 ? z : z - 146096) / 146097;
+  const uint32_t doe = (uint32_t)(z - era * 146097);
+  const uint32_t yoe = (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365;
+  y = (int32_t)yoe + era * 400;
+  const uint32_t doy = doe - (365 * yoe + yoe / 4 - yoe / 100);
+  const uint32_t mp = (5 * doy + 2) / 153;
+  d = doy - (153 * mp + 2) / 5 + 1;
+  m = mp < 10 ? mp + 3 : mp - 9;
+  y += m <= 2;
+}
+
+/*
+DateTime
+*/
+DateTime::DateTime(uint32_t t)
+{
+  int32_t days = (int32_t)(t / 86400UL);
+  uint32_t rest = t % 86400UL;
+  int32_t y;
+  uint32_t month;
+  uint32_t day;
+  civilFromDays(days, y, month, day);
+  yOff = (uint8_t)(y - 2000);
+  m = month;
+  d = day;
+  hh = rest / 3600;
+  mm = (rest / 60) % 60;
+  ss = rest % 60;
+}
+
+DateTime::DateTime(uint16_t year, uint8_t month, uint8_t day, uint8_t hour, uint8_t min, uint8_t sec)
+{
+  if (year >= 2000U)
+  {
+    year -= 2000U;
+  }
+  yOff = year;
+  m = month;
+  d = day;
+  hh = hour;
+  mm = min;
+  ss = sec;
+}
+
+bool DateTime::isValid() const
+{
+  if (yOff >= 100)
+  {
+    return false;
+  }
+  DateTime other(unixtime());
+  return yOff == other.yOff && m == other.m && d == other.d && hh == other.hh && mm == other.mm && ss == other.ss;
+}
+
+uint32_t DateTime::unixtime() const
+{
+  return (uint32_t)daysFromCivil(2000 + yOff, m, d) * 86400UL + hh * 3600UL + mm * 60UL + ss;
+}
+
+uint8_t DateTime::dayOfTheWeek() const
+{
+  // 1970-01-01 was a Thursday
+  return (uint8_t)((daysFromCivil(2000 + yOff, m, d) + 4) % 7);
+}
+
+DateTime DateTime::operator+(const TimeSpan &span) const
+{
+  return DateTime(unixtime() + span.totalseconds());
+}
+
+char *DateTime::toString(char *buffer) const
+{
+  static const char *const months[] = {"Jan", "Feb", "Mar", "Apr", "May", "Jun", "Jul", "Aug", "Sep", "Oct", "Nov", "Dec"};
+  static const char *const days[] = {"Sun", "Mon", "Tue", "Wed", "Thu", "Fri", "Sat"};
+
+  for (size_t i = 0; i < strlen(buffer) - 1; i++)
+  {
+    if (buffer[i] == 'h' && buffer[i + 1] == 'h')
+    {
+      buffer[i] = '0' + hh / 10;
+      buffer[i + 1] = '0' + hh % 10;
+    }
+    if (buffer[i] == 'm' && buffer[i + 1] == 'm')
+    {
+      buffer[i] = '0' + mm / 10;
+      buffer[i + 1] = '0' + mm % 10;
+    }
+    if (buffer[i] == 's' && buffer[i + 1] == 's')
+    {
+      buffer[i] = '0' + ss / 10;
+      buffer[i + 1] = '0' + ss % 10;
+    }
+    if (buffer[i] == 'D' && buffer[i + 1] == 'D' && buffer[i + 2] == 'D')
+    {
+      memcpy(buffer + i, days[dayOfTheWeek()], 3);
+    }
+    else if (buffer[i] == 'D' && buffer[i + 1] == 'D')
+    {
+      buffer[i] = '0' + d / 10;
+      buffer[i + 1] = '0' + d % 10;
+    }
+    if (buffer[i] == 'M' && buffer[i + 1] == 'M' && buffer[i + 2] == 'M')
+    {
+      memcpy(buffer + i, months[m - 1], 3);
+    }
+    else if (buffer[i] == 'M' && buffer[i + 1] == 'M')
+    {
+      buffer[i] = '0' + m / 10;
+      buffer[i + 1] = '0' + m % 10;
+    }
+    if (buffer[i] == 'Y' && buffer[i + 1] == 'Y' && buffer[i + 2] == 'Y' && buffer[i + 3] == 'Y')
+    {
+      buffer[i] = '2';
+      buffer[i + 1] = '0';
+      buffer[i + 2] = '0' + (yOff / 10) % 10;
+      buffer[i + 3] = '0' + yOff % 10;
+    }
+    else if (buffer[i] == 'Y' && buffer[i + 1] == 'Y')
+    {
+      buffer[i] = '0' + (yOff / 10) % 10;
+      buffer[i + 1] = '0' + yOff % 10;
+    }
+  }
+  return buffer;
+}
+
+/*
+RTC_DS3231
+*/
+bool RTC_DS3231::read(uint8_t reg, uint8_t *data, size_t length)
+{
+  wire->beginTransmission(AEON_HostDS3231::ADDRESS);
+  wire->write(reg);
+  if (wire->endTransmission() != 0)
+  {
+    return false;
+  }
+  if (wire->requestFrom(AEON_HostDS3231::ADDRESS, length) != length)
+  {
+    return false;
+  }
+  for (size_t i = 0; i < length; i++)
+  {
+    data[i] = wire->read();
+  }
+  return true;
+}
+
+bool RTC_DS3231::write(uint8_t reg, const uint8_t *data, size_t length)
+{
+  wire->beginTransmission(AEON_HostDS3231::ADDRESS);
+  wire->write(reg);
+  wire->write(data, length);
+  return wire->endTransmission() == 0;
+}
+
+bool RTC_DS3231::begin(TwoWire *wireInstance)
+{
+  wire = wireInstance;
+  wire->begin();
+  wire->beginTransmission(AEON_HostDS3231::ADDRESS);
+  return wire->endTransmission() == 0;
+}
+
+void RTC_DS3231::adjust(const DateTime &dt)
+{
+  uint8_t buffer[7] = {bin2bcd(dt.second()), bin2bcd(dt.minute()), bin2bcd(dt.hour()),
+                       (uint8_t)(dt.dayOfTheWeek() == 0 ? 7 : dt.dayOfTheWeek()),
+                       bin2bcd(dt.day()), bin2bcd(dt.month()), bin2bcd(dt.year() - 2000U)};
+  write(0x00, buffer, sizeof(buffer));
+
+  uint8_t status = 0;
+  if (read(0x0F, &status, 1))
+  {
+    status &= ~0x80;
+    write(0x0F, &status, 1);
+  }
+}
+
+bool RTC_DS3231::lostPower(void)
+{
+  uint8_t status = 0;
+  read(0x0F, &status, 1);
+  return status >> 7;
+}
+
+DateTime RTC_DS3231::now()
+{
+  uint8_t buffer[7] = {0, 0, 0, 0, 1, 1, 0};
+  read(0x00, buffer, sizeof(buffer));
+  return DateTime(bcd2bin(buffer[6]) + 2000U, bcd2bin(buffer[5] & 0x7F), bcd2bin(buffer[4]),
+                  bcd2bin(buffer[2]), bcd2bin(buffer[1]), bcd2bin(buffer[0] & 0x7F));
+}
+
+float RTC_DS3231::getTemperature()
+{
+  uint8_t buffer[2] = {0, 0};
+  read(0x11, buffer, sizeof(buffer));
+  return (float)(int8_t)buffer[0] + (buffer[1] >> 6) * 0.25f;
+}
+
+/*
+DS3231 model
+*/
+AEON_HostDS3231::AEON_HostDS3231() : pointer(0), anchorUnix(SECONDS_FROM_1970_TO_2000), anchorMicros(0)
+{
+  memset(registers, 0, sizeof(registers));
+  registers[0x0F] = 0x80; // oscillator stopped until the time is set
+  registers[0x11] = 24;   // 24 degC
+  anchorMicros = AEON_HostClock::nowMicros();
+}
+
+void AEON_HostDS3231::setUnixTime(uint32_t unixTime)
+{
+  anchorUnix = unixTime;
+  anchorMicros = AEON_HostClock::nowMicros();
+}
+
+uint32_t AEON_HostDS3231::getUnixTime()
+{
+  return anchorUnix + (uint32_t)((AEON_HostClock::nowMicros() - anchorMicros) / 1000000ULL);
+}
+
+void AEON_HostDS3231::setLostPower(bool lost)
+{
+  if (lost)
+  {
+    registers[0x0F] |= 0x80;
+  }
+  else
+  {
+    registers[0x0F] &= ~0x80;
+  }
+}
+
+void AEON_HostDS3231::latchTime()
+{
+  DateTime now(getUnixTime());
+  registers[0x00] = bin2bcd(now.second());
+  registers[0x01] = bin2bcd(now.minute());
+  registers[0x02] = bin2bcd(now.hour());
+  registers[0x03] = now.dayOfTheWeek() == 0 ? 7 : now.dayOfTheWeek();
+  registers[0x04] = bin2bcd(now.day());
+  registers[0x05] = bin2bcd(now.month());
+  registers[0x06] = bin2bcd(now.year() - 2000U);
+}
+
+void AEON_HostDS3231::storeTime()
+{
+  DateTime dt(bcd2bin(registers[0x06]) + 2000U, bcd2bin(registers[0x05] & 0x7F), bcd2bin(registers[0x04]),
+              bcd2bin(registers[0x02] & 0x3F), bcd2bin(registers[0x01]), bcd2bin(registers[0x00] & 0x7F));
+  setUnixTime(dt.unixtime());
+}
+
+void AEON_HostDS3231::onWrite(const uint8_t *data, size_t length)
+{
+  if (length == 0)
+  {
+    return;
+  }
+  pointer = data[0] % REGISTER_COUNT;
+  if (length == 1)
+  {
+    return;
+  }
+
+  bool timeWritten = false;
+  latchTime();
+  for (size_t i = 1; i < length; i++)
+  {
+    if (pointer <= 0x06)
+    {
+      timeWritten = true;
+    }
+    registers[pointer] = data[i];
+    pointer = (pointer + 1) % REGISTER_COUNT;
+  }
+  if (timeWritten)
+  {
+    storeTime();
+  }
+}
+
+size_t AEON_HostDS3231::onRead(uint8_t *data, size_t length)
+{
+  latchTime();
+  for (size_t i = 0; i < length; i++)
+  {
+    data[i] = registers[pointer];
+    pointer = (pointer + 1) % REGISTER_COUNT;
+  }
+  return length;
+}
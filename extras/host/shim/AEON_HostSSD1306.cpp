@@ -0,0 +1,287 @@
+/*
+AEON_HostSSD1306.cpp - Host implementation of the Adafruit SSD1306 driver.
+
+Command lists, the begin() init sequence and the display() transfer follow the
+Adafruit implementation byte for byte, including the WIRE_MAX chunking and the
+clock switch around every transaction.
+*/
+
+#include <Arduino.h>
+#include <Wire.h>
+#include <Adafruit_SSD1306.h>
+
+#define TRANSACTION_START wire->setClock(wireClk)
+#define TRANSACTION_END wire->setClock(restoreClk)
+
+Adafruit_SSD1306::Adafruit_SSD1306(uint8_t w, uint8_t h, TwoWire *twi, int8_t rst_pin, uint32_t clkDuring, uint32_t clkAfter)
+    : Adafruit_GFX(w, h), wire(twi ? twi : &Wire), buffer(NULL), i2caddr(0), vccstate(0), page_end(0),
+      rstPin(rst_pin), wireClk(clkDuring), restoreClk(clkAfter), contrast(0x8F)
+{
+}
+
+Adafruit_SSD1306::~Adafruit_SSD1306(void)
+{
+  if (buffer)
+  {
+    free(buffer);
+    buffer = NULL;
+  }
+}
+
+void Adafruit_SSD1306::ssd1306_command1(uint8_t c)
+{
+  wire->beginTransmission(i2caddr);
+  wire->write((uint8_t)0x00); // Co = 0, D/C = 0
+  wire->write(c);
+  wire->endTransmission();
+}
+
+void Adafruit_SSD1306::ssd1306_commandList(const uint8_t *c, uint8_t n)
+{
+  wire->beginTransmission(i2caddr);
+  wire->write((uint8_t)0x00); // Co = 0, D/C = 0
+  uint16_t bytesOut = 1;
+  while (n--)
+  {
+    if (bytesOut >= WIRE_MAX)
+    {
+      wire->endTransmission();
+      wire->beginTransmission(i2caddr);
+      wire->write((uint8_t)0x00);
+      bytesOut = 1;
+    }
+    wire->write(pgm_read_byte(c++));
+    bytesOut++;
+  }
+  wire->endTransmission();
+}
+
+void Adafruit_SSD1306::ssd1306_command(uint8_t c)
+{
+  TRANSACTION_START;
+  ssd1306_command1(c);
+  TRANSACTION_END;
+}
+
+bool Adafruit_SSD1306::begin(uint8_t vcs, uint8_t addr, bool reset, bool periphBegin)
+{
+  if ((!buffer) && !(buffer = (uint8_t *)malloc(WIDTH * ((HEIGHT + 7) / 8))))
+  {
+    return false;
+  }
+
+  clearDisplay();
+
+  vccstate = vcs;
+  i2caddr = addr ? addr : ((HEIGHT == 32) ? 0x3C : 0x3D);
+  if (periphBegin)
+  {
+    wire->begin();
+  }
+
+  if (reset && (rstPin >= 0))
+  {
+    pinMode(rstPin, OUTPUT);
+    digitalWrite(rstPin, HIGH);
+    delay(1);
+    digitalWrite(rstPin, LOW);
+    delay(10);
+    digitalWrite(rstPin, HIGH);
+  }
+
+  TRANSACTION_START;
+
+  static const uint8_t init1[] = {SSD1306_DISPLAYOFF, SSD1306_SETDISPLAYCLOCKDIV, 0x80, SSD1306_SETMULTIPLEX};
+  ssd1306_commandList(init1, sizeof(init1));
+  ssd1306_command1(HEIGHT - 1);
+
+  static const uint8_t init2[] = {SSD1306_SETDISPLAYOFFSET, 0x0, SSD1306_SETSTARTLINE | 0x0, SSD1306_CHARGEPUMP};
+  ssd1306_commandList(init2, sizeof(init2));
+  ssd1306_command1((vccstate == SSD1306_EXTERNALVCC) ? 0x10 : 0x14);
+
+  static const uint8_t init3[] = {SSD1306_MEMORYMODE, 0x00, SSD1306_SEGREMAP | 0x1, SSD1306_COMSCANDEC};
+  ssd1306_commandList(init3, sizeof(init3));
+
+  uint8_t comPins = 0x02;
+  contrast = 0x8F;
+  if ((WIDTH == 128) && (HEIGHT == 32))
+  {
+    comPins = 0x02;
+    contrast = 0x8F;
+  }
+  else if ((WIDTH == 128) && (HEIGHT == 64))
+  {
+    comPins = 0x12;
+    contrast = (vccstate == SSD1306_EXTERNALVCC) ? 0x9F : 0xCF;
+  }
+  else if ((WIDTH == 96) && (HEIGHT == 16))
+  {
+    comPins = 0x2;
+    contrast = (vccstate == SSD1306_EXTERNALVCC) ? 0x10 : 0xAF;
+  }
+
+  ssd1306_command1(SSD1306_SETCOMPINS);
+  ssd1306_command1(comPins);
+  ssd1306_command1(SSD1306_SETCONTRAST);
+  ssd1306_command1(contrast);
+
+  ssd1306_command1(SSD1306_SETPRECHARGE);
+  ssd1306_command1((vccstate == SSD1306_EXTERNALVCC) ? 0x22 : 0xF1);
+  static const uint8_t init5[] = {SSD1306_SETVCOMDETECT, 0x40, SSD1306_DISPLAYALLON_RESUME,
+                                  SSD1306_NORMALDISPLAY, SSD1306_DEACTIVATE_SCROLL, SSD1306_DISPLAYON};
+  ssd1306_commandList(init5, sizeof(init5));
+
+  TRANSACTION_END;
+
+  return true;
+}
+
+void Adafruit_SSD1306::drawPixel(int16_t x, int16_t y, uint16_t color)
+{
+  if ((x >= 0) && (x < width()) && (y >= 0) && (y < height()))
+  {
+    switch (getRotation())
+    {
+    case 1:
+      std::swap(x, y);
+      x = WIDTH - x - 1;
+      break;
+    case 2:
+      x = WIDTH - x - 1;
+      y = HEIGHT - y - 1;
+      break;
+    case 3:
+      std::swap(x, y);
+      y = HEIGHT - y - 1;
+      break;
+    }
+    switch (color)
+    {
+    case SSD1306_WHITE:
+      buffer[x + (y / 8) * WIDTH] |= (1 << (y & 7));
+      break;
+    case SSD1306_BLACK:
+      buffer[x + (y / 8) * WIDTH] &= ~(1 << (y & 7));
+      break;
+    case SSD1306_INVERSE:
+      buffer[x + (y / 8) * WIDTH] ^= (1 << (y & 7));
+      break;
+    }
+  }
+}
+
+void Adafruit_SSD1306::clearDisplay(void)
+{
+  memset(buffer, 0, WIDTH * ((HEIGHT + 7) / 8));
+}
+
+void Adafruit_SSD1306::drawFastHLine(int16_t x, int16_t y, int16_t w, uint16_t color)
+{
+  for (int16_t i = 0; i < w; i++)
+  {
+    drawPixel(x + i, y, color);
+  }
+}
+
+void Adafruit_SSD1306::drawFastVLine(int16_t x, int16_t y, int16_t h, uint16_t color)
+{
+  for (int16_t i = 0; i < h; i++)
+  {
+    drawPixel(x, y + i, color);
+  }
+}
+
+void Adafruit_SSD1306::drawFastHLineInternal(int16_t x, int16_t y, int16_t w, uint16_t color)
+{
+  drawFastHLine(x, y, w, color);
+}
+
+void Adafruit_SSD1306::drawFastVLineInternal(int16_t x, int16_t y, int16_t h, uint16_t color)
+{
+  drawFastVLine(x, y, h, color);
+}
+
+bool Adafruit_SSD1306::getPixel(int16_t x, int16_t y)
+{
+  if ((x >= 0) && (x < width()) && (y >= 0) && (y < height()))
+  {
+    return (buffer[x + (y / 8) * WIDTH] & (1 << (y & 7)));
+  }
+  return false;
+}
+
+void Adafruit_SSD1306::display(void)
+{
+  TRANSACTION_START;
+  static const uint8_t dlist1[] = {SSD1306_PAGEADDR, 0, 0xFF, SSD1306_COLUMNADDR, 0};
+  ssd1306_commandList(dlist1, sizeof(dlist1));
+  ssd1306_command1(WIDTH - 1);
+
+  uint16_t count = WIDTH * ((HEIGHT + 7) / 8);
+  uint8_t *ptr = buffer;
+  wire->beginTransmission(i2caddr);
+  wire->write((uint8_t)0x40);
+  uint16_t bytesOut = 1;
+  while (count--)
+  {
+    if (bytesOut >= WIRE_MAX)
+    {
+      wire->endTransmission();
+      wire->beginTransmission(i2caddr);
+      wire->write((uint8_t)0x40);
+      bytesOut = 1;
+    }
+    wire->write(*ptr++);
+    bytesOut++;
+  }
+  wire->endTransmission();
+  TRANSACTION_END;
+}
+
+void Adafruit_SSD1306::invertDisplay(bool i)
+{
+  TRANSACTION_START;
+  ssd1306_command1(i ? SSD1306_INVERTDISPLAY : SSD1306_NORMALDISPLAY);
+  TRANSACTION_END;
+}
+
+void Adafruit_SSD1306::dim(bool dim)
+{
+  TRANSACTION_START;
+  ssd1306_command1(SSD1306_SETCONTRAST);
+  ssd1306_command1(dim ? 0 : contrast);
+  TRANSACTION_END;
+}
+
+void Adafruit_SSD1306::startscrollright(uint8_t start, uint8_t stop)
+{
+  TRANSACTION_START;
+  static const uint8_t scrollList1a[] = {SSD1306_RIGHT_HORIZONTAL_SCROLL, 0X00};
+  ssd1306_commandList(scrollList1a, sizeof(scrollList1a));
+  ssd1306_command1(start);
+  ssd1306_command1(0X00);
+  ssd1306_command1(stop);
+  static const uint8_t scrollList1b[] = {0X00, 0XFF, SSD1306_ACTIVATE_SCROLL};
+  ssd1306_commandList(scrollList1b, sizeof(scrollList1b));
+  TRANSACTION_END;
+}
+
+void Adafruit_SSD1306::startscrollleft(uint8_t start, uint8_t stop)
+{
+  TRANSACTION_START;
+  static const uint8_t scrollList2a[] = {SSD1306_LEFT_HORIZONTAL_SCROLL, 0X00};
+  ssd1306_commandList(scrollList2a, sizeof(scrollList2a));
+  ssd1306_command1(start);
+  ssd1306_command1(0X00);
+  ssd1306_command1(stop);
+  static const uint8_t scrollList2b[] = {0X00, 0XFF, SSD1306_ACTIVATE_SCROLL};
+  ssd1306_commandList(scrollList2b, sizeof(scrollList2b));
+  TRANSACTION_END;
+}
+
+void Adafruit_SSD1306::stopscroll(void)
+{
+  TRANSACTION_START;
+  ssd1306_command1(SSD1306_DEACTIVATE_SCROLL);
+  TRANSACTION_END;
+}
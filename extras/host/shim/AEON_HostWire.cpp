@@ -0,0 +1,195 @@
+/*
+AEON_HostWire.cpp - Host implementation of TwoWire and the I2C device registry.
+*/
+
+#include <Arduino.h>
+#include <Wire.h>
+#include "AEON_Host.h"
+#include "AEON_HostI2C.h"
+
+TwoWire Wire;
+
+static AEON_HostI2CDevice *devices[AEON_HostI2C::ADDRESS_COUNT];
+static SHOST_I2C_STATS stats[AEON_HostI2C::ADDRESS_COUNT];
+static bool timedBus = false;
+
+/*
+Device registry
+*/
+void AEON_HostI2C::attach(uint8_t address, AEON_HostI2CDevice *device)
+{
+  devices[address & 0x7F] = device;
+}
+
+void AEON_HostI2C::detach(uint8_t address)
+{
+  devices[address & 0x7F] = NULL;
+}
+
+AEON_HostI2CDevice *AEON_HostI2C::getDevice(uint8_t address)
+{
+  return devices[address & 0x7F];
+}
+
+SHOST_I2C_STATS AEON_HostI2C::getStats(uint8_t address)
+{
+  return stats[address & 0x7F];
+}
+
+SHOST_I2C_STATS AEON_HostI2C::getTotalStats()
+{
+  SHOST_I2C_STATS total = {0, 0, 0, 0};
+  for (int i = 0; i < ADDRESS_COUNT; i++)
+  {
+    total.transactions += stats[i].transactions;
+    total.bytesWritten += stats[i].bytesWritten;
+    total.bytesRead += stats[i].bytesRead;
+    total.failures += stats[i].failures;
+  }
+  return total;
+}
+
+void AEON_HostI2C::resetStats()
+{
+  memset(stats, 0, sizeof(stats));
+}
+
+void AEON_HostI2C::setTimed(bool timed)
+{
+  timedBus = timed;
+}
+
+bool AEON_HostI2C::isTimed()
+{
+  return timedBus;
+}
+
+void AEON_HostI2C::chargeTransfer(uint32_t clock, size_t bytes)
+{
+  if (!timedBus || !AEON_HostClock::isVirtual() || clock == 0)
+  {
+    return;
+  }
+  // address byte + payload, 9 clocks each, plus start and stop
+  uint64_t clocks = (uint64_t)(bytes + 1) * 9 + 2;
+  AEON_HostClock::advanceMicros((clocks * 1000000ULL) / clock);
+}
+
+/*
+TwoWire
+*/
+TwoWire::TwoWire()
+    : txAddress(0), txLength(0), txBegun(false), rxLength(0), rxIndex(0),
+      clock(100000), timeout(25), running(false)
+{
+}
+
+void TwoWire::setTimeout(uint32_t timeoutMs, bool resetWithTimeout)
+{
+  (void)resetWithTimeout;
+  timeout = timeoutMs;
+}
+
+void TwoWire::begin()
+{
+  running = true;
+}
+
+void TwoWire::end()
+{
+  running = false;
+}
+
+void TwoWire::beginTransmission(uint8_t address)
+{
+  txAddress = address;
+  txLength = 0;
+  txBegun = true;
+}
+
+uint8_t TwoWire::endTransmission(bool stopBit)
+{
+  (void)stopBit;
+  if (!txBegun)
+  {
+    return 4;
+  }
+  txBegun = false;
+
+  SHOST_I2C_STATS &s = stats[txAddress & 0x7F];
+  AEON_HostI2CDevice *device = devices[txAddress & 0x7F];
+  AEON_HostI2C::chargeTransfer(clock, txLength);
+  s.transactions++;
+
+  if (!running || device == NULL)
+  {
+    s.failures++;
+    return 2; // address NACK
+  }
+
+  s.bytesWritten += txLength;
+  device->onWrite(txBuffer, txLength);
+  return 0;
+}
+
+size_t TwoWire::requestFrom(uint8_t address, size_t quantity, bool stopBit)
+{
+  (void)stopBit;
+  rxLength = 0;
+  rxIndex = 0;
+  quantity = std::min(quantity, (size_t)WIRE_BUFFER_SIZE);
+
+  SHOST_I2C_STATS &s = stats[address & 0x7F];
+  AEON_HostI2CDevice *device = devices[address & 0x7F];
+  AEON_HostI2C::chargeTransfer(clock, quantity);
+  s.transactions++;
+
+  if (!running || device == NULL)
+  {
+    s.failures++;
+    return 0;
+  }
+
+  rxLength = device->onRead(rxBuffer, quantity);
+  s.bytesRead += rxLength;
+  return rxLength;
+}
+
+size_t TwoWire::write(uint8_t data)
+{
+  if (!txBegun || txLength >= WIRE_BUFFER_SIZE)
+  {
+    return 0;
+  }
+  txBuffer[txLength++] = data;
+  return 1;
+}
+
+size_t TwoWire::write(const uint8_t *data, size_t quantity)
+{
+  size_t n = 0;
+  while (quantity--)
+  {
+    if (!write(*data++))
+    {
+      break;
+    }
+    n++;
+  }
+  return n;
+}
+
+int TwoWire::available()
+{
+  return (int)(rxLength - rxIndex);
+}
+
+int TwoWire::read()
+{
+  return rxIndex < rxLength ? rxBuffer[rxIndex++] : -1;
+}
+
+int TwoWire::peek()
+{
+  return rxIndex < rxLength ? rxBuffer[rxIndex] : -1;
+}
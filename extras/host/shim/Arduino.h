@@ -0,0 +1,169 @@
+/*
+Arduino.h - Host stand-in for the Arduino core used by the AEON firmware.
+
+Only the parts of the arduino-pico core that the AEON sources use are provided.
+Time is taken from the host clock (see AEON_Host.h), GPIO levels are kept in
+a table that host tools can drive, and Serial writes to stdout.
+*/
+
+#ifndef AEON_HOST_ARDUINO_h
+#define AEON_HOST_ARDUINO_h
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdarg.h>
+#include <math.h>
+#include <time.h>
+#include <algorithm>
+
+typedef bool boolean;
+typedef uint8_t byte;
+
+#define HIGH 0x1
+#define LOW 0x0
+
+#define INPUT 0x0
+#define OUTPUT 0x1
+#define INPUT_PULLUP 0x2
+#define INPUT_PULLDOWN 0x3
+
+#define PROGMEM
+#define PSTR(s) (s)
+#define pgm_read_byte(addr) (*(const uint8_t *)(addr))
+#define pgm_read_word(addr) (*(const uint16_t *)(addr))
+#define pgm_read_dword(addr) (*(const uint32_t *)(addr))
+#define pgm_read_ptr(addr) (*(void *const *)(addr))
+
+class __FlashStringHelper;
+#define F(string_literal) (reinterpret_cast<const __FlashStringHelper *>(PSTR(string_literal)))
+
+/*
+Time
+*/
+unsigned long millis();
+unsigned long micros();
+void delay(unsigned long ms);
+void delayMicroseconds(unsigned int us);
+void yield();
+
+/*
+GPIO
+*/
+void pinMode(uint8_t pin, uint8_t mode);
+int digitalRead(uint8_t pin);
+void digitalWrite(uint8_t pin, uint8_t value);
+
+/*
+System
+*/
+void NVIC_SystemReset();
+
+// Cycle counter and clock of the RP2040 class of arduino-pico, the host counts 133 cycles per microsecond
+class RP2040
+{
+public:
+  uint32_t getCycleCount();
+  uint64_t getCycleCount64();
+  uint32_t f_cpu() { return 133000000; }
+};
+extern RP2040 rp2040;
+
+class String;
+
+/*
+Print
+*/
+class Print
+{
+public:
+  virtual ~Print() {}
+  virtual size_t write(uint8_t c) = 0;
+  virtual size_t write(const uint8_t *buffer, size_t size);
+  size_t write(const char *str) { return str == NULL ? 0 : write((const uint8_t *)str, strlen(str)); }
+  size_t write(const char *buffer, size_t size) { return write((const uint8_t *)buffer, size); }
+
+  size_t print(const __FlashStringHelper *s) { return write(reinterpret_cast<const char *>(s)); }
+  size_t print(const String &s);
+  size_t print(const char s[]) { return write(s); }
+  size_t print(char c) { return write((uint8_t)c); }
+  size_t print(unsigned char b, int base = 10) { return print((unsigned long)b, base); }
+  size_t print(int n, int base = 10) { return print((long)n, base); }
+  size_t print(unsigned int n, int base = 10) { return print((unsigned long)n, base); }
+  size_t print(long n, int base = 10);
+  size_t print(unsigned long n, int base = 10);
+  size_t print(long long n, int base = 10);
+  size_t print(unsigned long long n, int base = 10);
+  size_t print(double n, int digits = 2);
+
+  size_t println(void) { return write("\r\n"); }
+  template <typename T>
+  size_t println(T value) { size_t n = print(value); return n + println(); }
+  template <typename T>
+  size_t println(T value, int format) { size_t n = print(value, format); return n + println(); }
+
+  size_t printf(const char *format, ...) __attribute__((format(printf, 2, 3)));
+};
+
+/*
+Stream
+*/
+class Stream : public Print
+{
+public:
+  virtual int available() = 0;
+  virtual int read() = 0;
+  virtual int peek() = 0;
+  virtual void flush() {}
+};
+
+/*
+USB CDC serial port. Output goes to stdout, input can be fed by host tools.
+*/
+class SerialUSB : public Stream
+{
+public:
+  void begin(unsigned long baud = 115200) { (void)baud; }
+  void end() {}
+  size_t write(uint8_t c) override;
+  size_t write(const uint8_t *buffer, size_t size) override;
+  using Print::write;
+  int available() override;
+  int read() override;
+  int peek() override;
+  int availableForWrite() { return 256; }
+  operator bool();
+};
+
+extern SerialUSB Serial;
+
+/*
+Minimal Arduino String
+*/
+class String
+{
+private:
+  char *buffer;
+  size_t len;
+
+  void assign(const char *s, size_t n);
+
+public:
+  String(const char *s = "");
+  String(const String &s);
+  String(int value, unsigned char base = 10);
+  ~String();
+
+  String &operator=(const String &s);
+  String &operator=(const char *s);
+  String &operator+=(const String &s);
+  String &operator+=(const char *s);
+
+  const char *c_str() const { return buffer; }
+  unsigned int length() const { return len; }
+  void toCharArray(char *buf, unsigned int bufsize, unsigned int index = 0) const;
+};
+
+#endif
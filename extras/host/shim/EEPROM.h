@@ -0,0 +1,57 @@
+/*
+EEPROM.h - Host stand-in for the arduino-pico EEPROM emulation.
+
+As on the RP2040, begin() copies the backing flash sector into a RAM shadow,
+write() only changes the shadow and commit() erases the sector and programs the shadow back
+(NOR flash model, AEON_HostFlash.h).
+*/
+
+#ifndef AEON_HOST_EEPROM_h
+#define AEON_HOST_EEPROM_h
+
+#include <Arduino.h>
+
+class EEPROMClass
+{
+private:
+  uint8_t *data;
+  size_t size;
+  bool dirty;
+
+public:
+  EEPROMClass() : data(NULL), size(0), dirty(false) {}
+
+  void begin(size_t size);
+  uint8_t read(int address);
+  void write(int address, uint8_t value);
+  bool commit();
+  bool end();
+
+  uint8_t *getDataPtr() { dirty = true; return data; }
+  uint16_t length() const { return (uint16_t)size; }
+
+  template <typename T>
+  T &get(int address, T &t)
+  {
+    if (address >= 0 && address + sizeof(T) <= size)
+    {
+      memcpy((uint8_t *)&t, data + address, sizeof(T));
+    }
+    return t;
+  }
+
+  template <typename T>
+  const T &put(int address, const T &t)
+  {
+    if (address >= 0 && address + sizeof(T) <= size)
+    {
+      memcpy(data + address, (const uint8_t *)&t, sizeof(T));
+      dirty = true;
+    }
+    return t;
+  }
+};
+
+extern EEPROMClass EEPROM;
+
+#endif
@@ -0,0 +1,79 @@
+/*
+RTClib.h - Host stand-in for Adafruit RTClib (DateTime, TimeSpan, RTC_DS3231).
+
+RTC_DS3231 talks to the DS3231 model (AEON_HostDS3231) over the host Wire bus with
+the same register transactions as the real library.
+*/
+
+#ifndef AEON_HOST_RTCLIB_h
+#define AEON_HOST_RTCLIB_h
+
+#include <Arduino.h>
+#include <Wire.h>
+
+#define SECONDS_FROM_1970_TO_2000 946684800
+
+class TimeSpan;
+
+class DateTime
+{
+protected:
+  uint8_t yOff;
+  uint8_t m;
+  uint8_t d;
+  uint8_t hh;
+  uint8_t mm;
+  uint8_t ss;
+
+public:
+  DateTime(uint32_t t = SECONDS_FROM_1970_TO_2000);
+  DateTime(uint16_t year, uint8_t month, uint8_t day, uint8_t hour = 0, uint8_t min = 0, uint8_t sec = 0);
+
+  bool isValid() const;
+  char *toString(char *buffer) const;
+
+  uint16_t year() const { return 2000U + yOff; }
+  uint8_t month() const { return m; }
+  uint8_t day() const { return d; }
+  uint8_t hour() const { return hh; }
+  uint8_t minute() const { return mm; }
+  uint8_t second() const { return ss; }
+  uint8_t dayOfTheWeek() const;
+
+  uint32_t secondstime() const { return unixtime() - SECONDS_FROM_1970_TO_2000; }
+  uint32_t unixtime() const;
+
+  DateTime operator+(const TimeSpan &span) const;
+  bool operator==(const DateTime &right) const { return unixtime() == right.unixtime(); }
+  bool operator!=(const DateTime &right) const { return !(*this == right); }
+};
+
+class TimeSpan
+{
+protected:
+  int32_t _seconds;
+
+public:
+  TimeSpan(int32_t seconds = 0) : _seconds(seconds) {}
+  TimeSpan(int16_t days, int8_t hours, int8_t minutes, int8_t seconds)
+      : _seconds((int32_t)days * 86400L + (int32_t)hours * 3600 + (int32_t)minutes * 60 + seconds) {}
+  int32_t totalseconds() const { return _seconds; }
+};
+
+class RTC_DS3231
+{
+private:
+  TwoWire *wire;
+  bool read(uint8_t reg, uint8_t *data, size_t length);
+  bool write(uint8_t reg, const uint8_t *data, size_t length);
+
+public:
+  RTC_DS3231() : wire(NULL) {}
+  bool begin(TwoWire *wireInstance = &Wire);
+  void adjust(const DateTime &dt);
+  bool lostPower(void);
+  DateTime now();
+  float getTemperature();
+};
+
+#endif
@@ -0,0 +1,19 @@
+/*
+SPI.h - Host stand-in for the SPI class. The AEON firmware includes SPI.h but does not use it.
+*/
+
+#ifndef AEON_HOST_SPI_h
+#define AEON_HOST_SPI_h
+
+#include <Arduino.h>
+
+class SPIClass
+{
+public:
+  void begin() {}
+  void end() {}
+};
+
+extern SPIClass SPI;
+
+#endif
@@ -0,0 +1,60 @@
+/*
+Wire.h - Host stand-in for the arduino-pico TwoWire class.
+
+Transactions are routed to the device models attached with AEON_HostI2C::attach().
+Addresses without a device NACK like an empty bus.
+*/
+
+#ifndef AEON_HOST_WIRE_h
+#define AEON_HOST_WIRE_h
+
+#include <Arduino.h>
+
+#define WIRE_BUFFER_SIZE 256
+
+class TwoWire : public Stream
+{
+private:
+  uint8_t txAddress;
+  uint8_t txBuffer[WIRE_BUFFER_SIZE];
+  size_t txLength;
+  bool txBegun;
+
+  uint8_t rxBuffer[WIRE_BUFFER_SIZE];
+  size_t rxLength;
+  size_t rxIndex;
+
+  uint32_t clock;
+  uint32_t timeout;
+  bool running;
+
+public:
+  TwoWire();
+
+  bool setSDA(int pin) { (void)pin; return true; }
+  bool setSCL(int pin) { (void)pin; return true; }
+  void setClock(uint32_t freqHz) { clock = freqHz; }
+  uint32_t getClock() { return clock; }
+  void setTimeout(uint32_t timeoutMs = 25, bool resetWithTimeout = false);
+  uint32_t getTimeout() { return timeout; }
+
+  void begin();
+  void end();
+
+  void beginTransmission(uint8_t address);
+  uint8_t endTransmission(bool stopBit = true);
+
+  size_t requestFrom(uint8_t address, size_t quantity, bool stopBit = true);
+
+  size_t write(uint8_t data) override;
+  size_t write(const uint8_t *data, size_t quantity) override;
+  using Print::write;
+
+  int available() override;
+  int read() override;
+  int peek() override;
+};
+
+extern TwoWire Wire;
+
+#endif
@@ -0,0 +1,46 @@
+/*
+pico/mutex.h - Host stand-in for the Pico SDK mutex, backed by std::timed_mutex.
+*/
+
+#ifndef AEON_HOST_PICO_MUTEX_h
+#define AEON_HOST_PICO_MUTEX_h
+
+#include <stdint.h>
+#include <chrono>
+#include <mutex>
+
+typedef struct
+{
+  std::timed_mutex *lock;
+} mutex_t;
+
+inline void mutex_init(mutex_t *mtx)
+{
+  if (!mtx->lock)
+  {
+    mtx->lock = new std::timed_mutex();
+  }
+}
+
+inline void mutex_enter_blocking(mutex_t *mtx)
+{
+  mtx->lock->lock();
+}
+
+inline bool mutex_try_enter(mutex_t *mtx, uint32_t *owner_out)
+{
+  (void)owner_out;
+  return mtx->lock->try_lock();
+}
+
+inline bool mutex_enter_timeout_ms(mutex_t *mtx, uint32_t timeout_ms)
+{
+  return mtx->lock->try_lock_for(std::chrono::milliseconds(timeout_ms));
+}
+
+inline void mutex_exit(mutex_t *mtx)
+{
+  mtx->lock->unlock();
+}
+
+#endif
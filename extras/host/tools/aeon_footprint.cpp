@@ -0,0 +1,267 @@
+/*
+aeon_footprint.cpp - Flash and RAM of every module from a GNU ld map file.
+
+The map of the RP2040 build is written by arduino-pico next to the .elf (AEON.ino.map in the build path,
+arduino-cli compile --build-path <dir>). The host build writes aeon_host.map, "cmake --build <dir>
+--target footprint" prints it.
+
+Every input section of the map is counted for its object: AEON_*.cpp and the sketch by module, the
+other objects by library (archive). The output section gives the kind:
+  text    code (.text, .boot2, .init, .fini)
+  rodata  constants (.rodata, .ARM.exidx, .ARM.extab, .eh_frame, .binary_info)
+  data    initialised variables (.data, .scratch_x, .scratch_y, .ram_vector_table, .init_array), in flash
+          and in RAM
+  bss     zeroed variables (.bss, .noinit, .uninitialized_data), only in RAM
+flash = text + rodata + data, RAM = data + bss. The stacks and the heap are not in the map, "memory" on
+Serial prints them at runtime (AEON_Memory.h).
+
+Usage: aeon_footprint <file.map>
+*/
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <string>
+#include <vector>
+
+enum EKind
+{
+  KIND_TEXT,
+  KIND_RODATA,
+  KIND_DATA,
+  KIND_BSS,
+  KIND_NONE
+};
+
+struct SFootprint
+{
+  uint64_t size[KIND_NONE] = {};
+
+  uint64_t flash() const { return size[KIND_TEXT] + size[KIND_RODATA] + size[KIND_DATA]; }
+  uint64_t ram() const { return size[KIND_DATA] + size[KIND_BSS]; }
+};
+
+static bool startsWith(const std::string &text, const std::string &prefix)
+{
+  return text.compare(0, prefix.size(), prefix) == 0;
+}
+
+static bool endsWith(const std::string &text, const std::string &suffix)
+{
+  return text.size() >= suffix.size() && text.compare(text.size() - suffix.size(), suffix.size(), suffix) == 0;
+}
+
+/*
+Kind of an output section, KIND_NONE for debug information and the like
+*/
+static EKind kindOf(const std::string &section)
+{
+  static const char *const bss[] = {".bss", ".tbss", ".noinit", ".uninitialized_data", ".heap", nullptr};
+  static const char *const data[] = {".data", ".tdata", ".scratch_x", ".scratch_y", ".ram_vector_table", ".got",
+                                     ".init_array", ".fini_array", ".preinit_array", nullptr};
+  static const char *const rodata[] = {".rodata", ".eh_frame", ".gcc_except_table", ".ARM.extab", ".ARM.exidx",
+                                       ".binary_info", nullptr};
+  static const char *const text[] = {".text", ".init", ".fini", ".plt", ".boot2", ".flash_begin", ".flash_end", nullptr};
+
+  const char *const *lists[] = {text, rodata, data, bss};
+  for (int kind = KIND_TEXT; kind < KIND_NONE; kind++)
+  {
+    for (const char *const *name = lists[kind]; *name; name++)
+    {
+      if (section == *name)
+      {
+        return (EKind)kind;
+      }
+    }
+  }
+  return KIND_NONE;
+}
+
+static std::string baseName(const std::string &path)
+{
+  size_t slash = path.find_last_of("/\\");
+  return slash == std::string::npos ? path : path.substr(slash + 1);
+}
+
+/*
+Module of an input file: "lib.a(member.o)" or "dir/member.o"
+*/
+static std::string moduleOf(const std::string &file)
+{
+  std::string archive;
+  std::string object = file;
+  size_t open = file.find('(');
+  if (open != std::string::npos && endsWith(file, ")"))
+  {
+    archive = baseName(file.substr(0, open));
+    object = file.substr(open + 1, file.size() - open - 2);
+  }
+  object = baseName(object);
+
+  if (object == "AEON.ino.cpp.o" || object == "AEON_ino.cpp.o" || object == "AEON.ino.o")
+  {
+    return "AEON.ino";
+  }
+  if (startsWith(object, "AEON_"))
+  {
+    for (const char *suffix : {".cpp.o", ".o"})
+    {
+      if (endsWith(object, suffix))
+      {
+        return object.substr(0, object.size() - std::string(suffix).size());
+      }
+    }
+    return object;
+  }
+  return archive.empty() ? object : archive;
+}
+
+static bool isHex(const std::string &token)
+{
+  return startsWith(token, "0x") && token.size() > 2;
+}
+
+int main(int argc, char **argv)
+{
+  if (argc != 2)
+  {
+    std::cerr << "Usage: aeon_footprint <file.map>" << std::endl;
+    return 2;
+  }
+
+  std::ifstream in(argv[1]);
+  if (!in)
+  {
+    std::cerr << "Cannot read " << argv[1] << std::endl;
+    return 1;
+  }
+
+  std::map<std::string, SFootprint> modules;
+  std::string line;
+  bool memoryMap = false;
+  EKind kind = KIND_NONE;
+  std::string pending; // Input section whose address and size follow on the next line
+  uint64_t sections = 0;
+
+  while (std::getline(in, line))
+  {
+    if (!line.empty() && line.back() == '\r')
+    {
+      line.pop_back();
+    }
+    if (!memoryMap)
+    {
+      memoryMap = startsWith(line, "Linker script and memory map");
+      continue;
+    }
+    if (line.empty())
+    {
+      continue;
+    }
+
+    std::istringstream tokens(line);
+    std::vector<std::string> words;
+    for (std::string word; tokens >> word;)
+    {
+      words.push_back(word);
+    }
+
+    // Output section at column 0
+    if (line[0] != ' ')
+    {
+      kind = line[0] == '.' ? kindOf(words[0]) : KIND_NONE;
+      pending.clear();
+      continue;
+    }
+
+    // Input section: " .name addr size file", a long name wraps and the rest follows on the next line
+    size_t first = 0;
+    if (line.size() > 1 && line[1] != ' ' && line[1] != '*')
+    {
+      if (words.size() == 1)
+      {
+        pending = words[0];
+        continue;
+      }
+      first = 1;
+    }
+    else if (!pending.empty())
+    {
+      first = 0;
+    }
+    else
+    {
+      continue; // Symbol, *fill*, script line
+    }
+    pending.clear();
+
+    if (words.size() < first + 3 || !isHex(words[first]) || !isHex(words[first + 1]))
+    {
+      continue;
+    }
+    uint64_t size = std::stoull(words[first + 1], nullptr, 16);
+    if (kind == KIND_NONE || size == 0)
+    {
+      continue;
+    }
+
+    std::string file = words[first + 2];
+    for (size_t i = first + 3; i < words.size(); i++)
+    {
+      file += " " + words[i];
+    }
+    modules[moduleOf(file)].size[kind] += size;
+    sections++;
+  }
+
+  if (!memoryMap || sections == 0)
+  {
+    std::cerr << argv[1] << " is not a GNU ld map file" << std::endl;
+    return 1;
+  }
+
+  // AEON modules first, then the libraries, each by RAM
+  std::vector<std::pair<std::string, SFootprint>> rows(modules.begin(), modules.end());
+  std::stable_sort(rows.begin(), rows.end(), [](const auto &a, const auto &b)
+                   {
+                     bool aeonA = startsWith(a.first, "AEON");
+                     bool aeonB = startsWith(b.first, "AEON");
+                     if (aeonA != aeonB)
+                     {
+                       return aeonA;
+                     }
+                     return a.second.ram() > b.second.ram();
+                   });
+
+  SFootprint aeon;
+  SFootprint total;
+  printf("%-28s %8s %8s %8s %8s %8s %8s\n", "module", "text", "rodata", "data", "bss", "flash", "RAM");
+  for (const auto &row : rows)
+  {
+    const SFootprint &f = row.second;
+    printf("%-28.28s %8llu %8llu %8llu %8llu %8llu %8llu\n", row.first.c_str(), (unsigned long long)f.size[KIND_TEXT],
+           (unsigned long long)f.size[KIND_RODATA], (unsigned long long)f.size[KIND_DATA], (unsigned long long)f.size[KIND_BSS],
+           (unsigned long long)f.flash(), (unsigned long long)f.ram());
+    for (int kind = KIND_TEXT; kind < KIND_NONE; kind++)
+    {
+      total.size[kind] += f.size[kind];
+      if (startsWith(row.first, "AEON"))
+      {
+        aeon.size[kind] += f.size[kind];
+      }
+    }
+  }
+
+  for (const auto &sum : {std::make_pair("AEON", aeon), std::make_pair("total", total)})
+  {
+    const SFootprint &f = sum.second;
+    printf("%-28s %8llu %8llu %8llu %8llu %8llu %8llu\n", sum.first, (unsigned long long)f.size[KIND_TEXT],
+           (unsigned long long)f.size[KIND_RODATA], (unsigned long long)f.size[KIND_DATA], (unsigned long long)f.size[KIND_BSS],
+           (unsigned long long)f.flash(), (unsigned long long)f.ram());
+  }
+  return 0;
+}
@@ -0,0 +1,160 @@
+/*
+aeon_ino_prototypes.cpp - Turns AEON.ino into a C++ translation unit for the host build.
+
+The Arduino builder declares every top level function of a sketch before its first
+function definition, so the sketch may call functions that are defined further
+down. This tool does the same: it copies the sketch, inserts the prototypes in
+front of the first function definition and keeps #line markers pointing at the
+original file so compiler messages refer to AEON.ino.
+
+Usage: aeon_ino_prototypes <AEON.ino> <output.cpp>
+*/
+
+#include <fstream>
+#include <iostream>
+#include <regex>
+#include <sstream>
+#include <string>
+#include <vector>
+
+/*
+Remove comments, string and character literals so braces inside them are not counted
+*/
+static std::string stripLine(const std::string &line, bool &inBlockComment)
+{
+  std::string out;
+  for (size_t i = 0; i < line.size(); i++)
+  {
+    char c = line[i];
+    char next = i + 1 < line.size() ? line[i + 1] : '\0';
+
+    if (inBlockComment)
+    {
+      if (c == '*' && next == '/')
+      {
+        inBlockComment = false;
+        i++;
+      }
+      continue;
+    }
+    if (c == '/' && next == '*')
+    {
+      inBlockComment = true;
+      i++;
+      continue;
+    }
+    if (c == '/' && next == '/')
+    {
+      break;
+    }
+    if (c == '"' || c == '\'')
+    {
+      char quote = c;
+      for (i++; i < line.size() && line[i] != quote; i++)
+      {
+        if (line[i] == '\\')
+        {
+          i++;
+        }
+      }
+      out += ' ';
+      continue;
+    }
+    out += c;
+  }
+  return out;
+}
+
+int main(int argc, char **argv)
+{
+  if (argc != 3)
+  {
+    std::cerr << "usage: " << argv[0] << " <AEON.ino> <output.cpp>" << std::endl;
+    return 2;
+  }
+
+  std::ifstream input(argv[1]);
+  if (!input)
+  {
+    std::cerr << "cannot read " << argv[1] << std::endl;
+    return 1;
+  }
+
+  std::vector<std::string> lines;
+  for (std::string line; std::getline(input, line);)
+  {
+    if (!line.empty() && line.back() == '\r')
+    {
+      line.pop_back();
+    }
+    lines.push_back(line);
+  }
+
+  static const std::regex definition(
+      R"(^([A-Za-z_][A-Za-z0-9_:<>\*&\s]*?[\s\*&])([A-Za-z_][A-Za-z0-9_]*)\s*\(([^;{}]*)\)\s*(\{.*)?$)");
+  static const std::regex keyword(R"(^(if|else|for|while|switch|return|case|do|typedef|struct|class|enum)\b)");
+
+  std::vector<std::string> prototypes;
+  size_t firstDefinition = lines.size();
+  int depth = 0;
+  bool inBlockComment = false;
+
+  for (size_t i = 0; i < lines.size(); i++)
+  {
+    bool commentAtStart = inBlockComment;
+    std::string code = stripLine(lines[i], inBlockComment);
+    std::smatch match;
+
+    if (depth == 0 && !commentAtStart && std::regex_match(code, match, definition) && !std::regex_search(code, keyword))
+    {
+      // A definition has its body on this line or on the next non-empty line
+      bool hasBody = match[4].matched;
+      for (size_t j = i + 1; !hasBody && j < lines.size(); j++)
+      {
+        std::string peek = lines[j];
+        peek.erase(0, peek.find_first_not_of(" \t"));
+        if (peek.empty())
+        {
+          continue;
+        }
+        hasBody = peek[0] == '{';
+        break;
+      }
+      if (hasBody)
+      {
+        std::string prototype = match[1].str() + match[2].str() + "(" + match[3].str() + ");";
+        prototypes.push_back(prototype);
+        if (firstDefinition == lines.size())
+        {
+          firstDefinition = i;
+        }
+      }
+    }
+
+    for (char c : code)
+    {
+      depth += (c == '{') - (c == '}');
+    }
+  }
+
+  std::ostringstream out;
+  out << "#include <Arduino.h>\n";
+  out << "#line 1 \"" << argv[1] << "\"\n";
+  for (size_t i = 0; i < firstDefinition; i++)
+  {
+    out << lines[i] << "\n";
+  }
+  for (const std::string &prototype : prototypes)
+  {
+    out << prototype << "\n";
+  }
+  out << "#line " << firstDefinition + 1 << " \"" << argv[1] << "\"\n";
+  for (size_t i = firstDefinition; i < lines.size(); i++)
+  {
+    out << lines[i] << "\n";
+  }
+
+  std::ofstream output(argv[2]);
+  output << out.str();
+  return output ? 0 : 1;
+}